@@ -3,6 +3,8 @@
 #include "../util/vector2.hpp"
 #include "../util/timer.hpp"
 #include "../manager/resource_manager.hpp"
+#include "../manager/particle_manager.hpp"
+#include "../render/render_list.hpp"
 #include "tile.hpp"
 
 #include <SDL.h>
@@ -33,13 +35,30 @@ public:
         timer_disappear.setWaitTime(interval_disappear);
         timer_disappear.setOnTimeOut([&]() { is_valid = false; });
 
+        reset();
+    }
+
+    ~CoinProp() = default;
+
+    /**
+     * @brief 重置金币状态
+     * @details 对象池复用金币时调用，重新开始跳跃并随机水平方向
+     */
+    void reset()
+    {
+        timer_jump.restart();
+        timer_disappear.restart();
+
+        is_valid = true;
+        is_jumping = true;
+        pass_time = 0;
+        carry_sparkle = 0;
+
         // 设置初始速度：水平随机方向，垂直向上
         velocity.x = (rand() % 2 ? 1 : -1) * 2 * TILE_SIZE;
         velocity.y = -3 * TILE_SIZE;
     }
 
-    ~CoinProp() = default;
-
     /**
      * @brief 设置金币位置
      * @param position 新的位置坐标
@@ -47,6 +66,7 @@ public:
     void setPosition(const Vector2& position)
     {
         this->position = position;
+        this->position_last = position;
     }
 
     /**
@@ -93,18 +113,23 @@ public:
      */
     void onUpdate(double delta_time)
     {
+        position_last = position;
+
         // 更新计时器
         timer_jump.onUpdate(delta_time);
         timer_disappear.onUpdate(delta_time);
+        pass_time += delta_time;
 
         if (is_jumping) {
             // 跳跃阶段：应用重力
             velocity.y += gravity * delta_time;
         }
         else {
-            // 漂浮阶段：执行正弦运动
+            // 漂浮阶段：执行正弦运动，相位取自金币自身的存在时间，使运动只由帧间隔决定
             velocity.x = 0;
-            velocity.y = sin(SDL_GetTicks64() / 1000.0 * 4) * 30;
+            velocity.y = sin(pass_time * 4) * 30;
+
+            ParticleManager::instance()->emitOverTime(EmitterType::CoinSparkle, position, delta_time, carry_sparkle);
         }
 
         // 更新位置
@@ -113,22 +138,26 @@ public:
 
     /**
      * @brief 渲染金币
-     * @param renderer SDL渲染器指针
+     * @param render_list 渲染命令列表
+     * @param alpha 插值系数，在上次与本次更新的位置之间插值
      */
-    void onRender(SDL_Renderer* renderer) const
+    void onRender(RenderList& render_list, double alpha) const
     {
-        static SDL_Rect rect = { 0, 0, (int)size.x, (int)size.y };
-        static auto* tex_coin = ResourceManager::instance()->getTexturePool().find(ResID::Tex_Coin)->second;
+        SDL_Rect rect = { 0, 0, (int)size.x, (int)size.y };
+        static const TextureHandle tex_coin = ResourceManager::instance()->acquireTexture(ResID::Tex_Coin);
 
         // 计算渲染位置（居中显示）
-        rect.x = (int)(position.x - size.x / 2);
-        rect.y = (int)(position.y - size.y / 2);
+        const Vector2 position_render = Vector2::lerp(position_last, position, alpha);
+        rect.x = (int)(position_render.x - size.x / 2);
+        rect.y = (int)(position_render.y - size.y / 2);
 
-        SDL_RenderCopy(renderer, tex_coin, nullptr, &rect);
+        render_list.setLayer(RenderLayer::Actor, rect.y + rect.h);
+        render_list.drawTexture(tex_coin, nullptr, rect);
     }
 
 private:
     Vector2 position;                 // 金币位置
+    Vector2 position_last;            // 本次更新前的金币位置
     Vector2 velocity;                 // 金币速度
     Vector2 size = { 16, 16 };        // 金币大小
 
@@ -137,6 +166,8 @@ private:
 
     bool is_valid = true;             // 金币是否有效
     bool is_jumping = true;           // 是否处于跳跃状态
+    double pass_time = 0;             // 金币已存在的时间
+    double carry_sparkle = 0;         // 闪光粒子不足一个的累计量
 
     double gravity = 490;             // 重力加速度
     double interval_jump = 0.75;      // 跳跃持续时间
@@ -2,8 +2,10 @@
 
 #include "tile.hpp"
 #include "route.hpp"
+#include "../manager/resource_manager.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -27,17 +29,19 @@ public:
 	~Map() = default;
 
 	/**
-	 * @brief 从文件加载地图数据
+	 * @brief 从文件加载地图数据，资源包中有该文件时从资源包读取
 	 * @param file_path 地图文件路径
 	 * @return 加载是否成功
 	 * @throw std::runtime_error 当文件打开失败或地图数据无效时抛出异常
 	 */
 	bool loadMap(const std::string &file_path)
 	{
-		std::ifstream file(file_path);
-		if (!file.is_open())
+		std::string content;
+		if (!ResourceManager::instance()->readFile(file_path, content))
 			throw std::runtime_error("Failed to open map file: " + file_path);
 
+		std::istringstream file(content);
+
 		TileMap tile_map_temp;
 
 		int index_x = -1, index_y = -1;
@@ -56,8 +60,6 @@ public:
 			parseLine(str_line, index_x, index_y, tile_map_temp);
 		}
 
-		file.close();
-
 		if (tile_map_temp.empty() || tile_map_temp[0].empty())
 			throw std::runtime_error("Invalid map data in file: " + file_path);
 
@@ -77,6 +79,72 @@ public:
 		m_tile_map[tile_index.y][tile_index.x].has_tower = true;
 	}
 
+	/**
+	 * @brief 修改瓦片的地形、装饰与方向
+	 * @param tile_index 瓦片坐标
+	 * @param terrian 地形类型ID
+	 * @param decoration 装饰物ID(-1表示无装饰)
+	 * @param direction 瓦片朝向
+	 * @return 重新计算的路径数
+	 *
+	 * 特殊标记与防御塔保持不变，因此家园与生成点不会增减，路径池中的路径对象地址保持有效；
+	 * 路径只读取其经过的瓦片的方向，因此只有方向改变且经过该瓦片的路径需要重新计算；
+	 * 路径点列表改变后，沿该路径移动的敌人需由调用者重新对应目标点
+	 */
+	size_t setTile(const SDL_Point &tile_index, int terrian, int decoration, Tile::Direction direction)
+	{
+		Tile &tile = m_tile_map[tile_index.y][tile_index.x];
+		const bool is_direction_changed = (tile.direction != direction);
+
+		tile.terrian = terrian;
+		tile.decoration = decoration;
+		tile.direction = direction;
+
+		if (!is_direction_changed)
+			return 0;
+
+		size_t num_route = 0;
+		for (auto &[special_flag, route] : m_spawner_route_pool)
+		{
+			const auto &index_list = route.getIndexList();
+			auto itor = std::find_if(index_list.begin(), index_list.end(), [&](const SDL_Point &index)
+									 { return index.x == tile_index.x && index.y == tile_index.y; });
+			if (itor == index_list.end())
+				continue;
+
+			route = Route(m_tile_map, index_list.front());
+			num_route++;
+		}
+
+		return num_route;
+	}
+
+	/**
+	 * @brief 将地图数据保存为与loadMap()相同的CSV格式
+	 * @param file_path 地图文件路径
+	 * @return 保存是否成功
+	 */
+	bool saveMap(const std::string &file_path) const
+	{
+		std::ofstream file(file_path);
+		if (!file.is_open())
+			return false;
+
+		for (const auto &tile_line : m_tile_map)
+		{
+			for (size_t x = 0; x < tile_line.size(); x++)
+			{
+				const Tile &tile = tile_line[x];
+				if (x > 0)
+					file << ',';
+				file << tile.terrian << '\\' << tile.decoration << '\\' << (int)tile.direction << '\\' << tile.special_flag;
+			}
+			file << '\n';
+		}
+
+		return file.good();
+	}
+
 	// 获取地图尺寸
 	size_t getWidth() const
 	{
@@ -4,6 +4,13 @@
 #include "../util/animation.hpp"
 #include "../enemy/enemy.hpp"
 #include "../manager/config_manager.hpp"
+#include "../manager/resource_manager.hpp"
+#include "bullet_type.hpp"
+#include "bullet_traits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 /**
  * @class Bullet
@@ -14,6 +21,15 @@
  * - 伤害值设定
  * - 碰撞检测
  * - 动画渲染
+ *
+ * 各类型子弹的差异由BulletTraits在编译期描述，更新、渲染与碰撞处理均为
+ * 以子弹类型为模板参数的非虚函数。子弹管理器按类型分别存放子弹，
+ * 同一类型的子弹在紧密循环中处理，不涉及虚函数分派。
+ * 子弹不持有指向自身的回调，可以按值存放并随容器移动
+ *
+ * 子弹做匀速直线运动，只保存发射时刻、发射位置和速度，
+ * 任意时刻的位置按解析式计算，与帧间隔无关；
+ * 飞出地图的时刻在发射时一次算出，到期后子弹失效
  */
 class Bullet
 {
@@ -22,37 +38,43 @@ public:
 	~Bullet() = default;
 
 	/**
-	 * @brief 设置子弹速度并计算旋转角度
-	 * @param velocity 速度向量
+	 * @brief 按子弹类型初始化子弹
+	 * @tparam TYPE 子弹类型
+	 * @param time 发射时刻(模拟时间，秒)
+	 * @param position 初始位置
+	 * @param velocity 速度向量，可旋转的子弹据此计算旋转角度
+	 * @param damage 伤害值
 	 */
-	void setVelocity(const Vector2& velocity)
+	template <BulletType TYPE>
+	void init(double time, const Vector2& position, const Vector2& velocity, double damage)
 	{
+		using Traits = BulletTraits<TYPE>;
+
+		animation.setLoop(true);
+		animation.setInterval(0.1);
+		animation.setClip(Traits::getClip());
+
+		if constexpr (Traits::can_explode) {
+			anim_explode.setLoop(false);
+			anim_explode.setInterval(0.1);
+			anim_explode.setClip(Traits::getExplodeClip());
+		}
+
+		size.x = Traits::size, size.y = Traits::size;
+		damage_range = Traits::damage_range;
+
+		this->time_launch = time;
+		this->position_launch = position;
 		this->velocity = velocity;
+		this->damage = damage;
+		this->time_expire = time + computeExitTime(position, velocity, size);
 
-		if (can_rotate) {
+		if constexpr (Traits::can_rotate) {
 			double randian = std::atan2(velocity.y, velocity.x);
 			angle_anim_rotate = randian * 180 / 3.14159265358979323846;
 		}
 	}
 
-	/**
-	 * @brief 设置子弹位置
-	 * @param position 位置向量
-	 */
-	void setPosition(const Vector2& position)
-	{
-		this->position = position;
-	}
-	
-	/**
-	 * @brief 设置子弹伤害值
-	 * @param damage 伤害值
-	 */
-	void setDamage(double damage)
-	{
-		this->damage = damage;
-	}
-
 	/**
 	 * @brief 获取子弹大小
 	 * @return 子弹大小向量
@@ -63,12 +85,22 @@ public:
 	}
 
 	/**
-	 * @brief 获取子弹位置
+	 * @brief 获取子弹在指定时刻的位置
+	 * @param time 模拟时间(秒)
 	 * @return 子弹位置向量
 	 */
-	const Vector2& getPosition() const
+	Vector2 getPosition(double time) const
 	{
-		return position;
+		return position_launch + velocity * (time - time_launch);
+	}
+
+	/**
+	 * @brief 获取子弹发射时刻
+	 * @return 模拟时间(秒)，爆炸的子弹为开始爆炸的时刻
+	 */
+	double getLaunchTime() const
+	{
+		return time_launch;
 	}
 
 	/**
@@ -126,62 +158,140 @@ public:
 
 	/**
 	 * @brief 更新子弹状态
+	 * @tparam TYPE 子弹类型
+	 * @param time 更新后的模拟时间(秒)
 	 * @param delta_time 时间增量
 	 *
-	 * 更新子弹动画和位置，检查地图边界碰撞
+	 * 更新子弹动画，到达飞出地图的时刻后失效；
+	 * 可爆炸的子弹命中后只播放爆炸动画，播放完成后失效
 	 */
-	virtual void onUpdate(double delta_time)
+	template <BulletType TYPE>
+	void onUpdate(double time, double delta_time)
 	{
-		animation.onUpdate(delta_time);
-		position += velocity * delta_time;
+		if constexpr (BulletTraits<TYPE>::can_explode) {
+			if (!is_collisional) {
+				anim_explode.onUpdate(delta_time);
+				if (anim_explode.isFinished())
+					makeInvalid();
+				return;
+			}
+		}
 
-		static const SDL_Rect& rect_map = ConfigManager::instance()->rect_tile_map;
+		animation.onUpdate(delta_time);
 
-		if (position.x - size.x / 2 <= rect_map.x
-			|| position.x + size.x / 2 >= rect_map.x + rect_map.w
-			|| position.y - size.y / 2 <= rect_map.y
-			|| position.y + size.y / 2 >= rect_map.y + rect_map.h) {
+		if (time >= time_expire)
 			is_valid = false;
-		}
 	}
 
 	/**
 	 * @brief 渲染子弹
-	 * @param renderer SDL渲染器指针
+	 * @tparam TYPE 子弹类型
+	 * @param render_list 渲染命令列表
+	 * @param time 当前模拟时间(秒)
 	 */
-	virtual void onRender(SDL_Renderer* renderer)
+	template <BulletType TYPE>
+	void onRender(RenderList& render_list, double time) const
 	{
-		static SDL_Point point;
+		SDL_Point point;
+
+		const Vector2 position = getPosition(time);
+		render_list.setLayer(RenderLayer::Air, (int)position.y);
+
+		if constexpr (BulletTraits<TYPE>::can_explode) {
+			if (!is_collisional) {
+				point.x = (int)position.x - (int)BulletTraits<TYPE>::size_explode / 2;
+				point.y = (int)position.y - (int)BulletTraits<TYPE>::size_explode / 2;
+
+				anim_explode.onRender(render_list, point);
+				return;
+			}
+		}
 
 		point.x = (int)(position.x - size.x / 2);
 		point.y = (int)(position.y - size.y / 2);
 
-		animation.onRender(renderer, point, angle_anim_rotate);
+		animation.onRender(render_list, point, angle_anim_rotate);
 	}
 
 	/**
 	 * @brief 处理与敌人的碰撞
+	 * @tparam TYPE 子弹类型
 	 * @param enemy 敌人指针
+	 * @param time 碰撞时刻(模拟时间，秒)
+	 *
+	 * 播放命中音效，按类型施加减速；
+	 * 可爆炸的子弹停在碰撞位置并开始爆炸，其余子弹立即失效
 	 */
-	virtual void onCollide(Enemy* enemy)
+	template <BulletType TYPE>
+	void onCollide(Enemy* enemy, double time)
 	{
-		is_valid = false;
-		is_collisional = false;
+		using Traits = BulletTraits<TYPE>;
+		static const auto sound_hit_list = ResourceManager::instance()->acquireSound(Traits::sound_hit_list);
+
+		if constexpr (Traits::sound_hit_list.size() == 1)
+			Mix_PlayChannel(-1, sound_hit_list[0], 0);
+		else
+			Mix_PlayChannel(-1, sound_hit_list[rand() % sound_hit_list.size()], 0);
+
+		if constexpr (Traits::can_slow_down)
+			enemy->slowDown();
+
+		if constexpr (Traits::can_explode) {
+			position_launch = getPosition(time);
+			velocity = Vector2();
+			time_launch = time;
+			time_expire = std::numeric_limits<double>::infinity();
+			disableCollide();
+		}
+		else {
+			is_valid = false;
+			is_collisional = false;
+		}
 	}
 
-protected:
+private:
+	/**
+	 * @brief 计算子弹从发射到碰到地图边界所需的时间
+	 * @param position 发射位置
+	 * @param velocity 速度向量
+	 * @param size 子弹大小
+	 * @return 所需时间(秒)，发射时已碰到边界返回0，永不离开返回无穷大
+	 *
+	 * 子弹包围盒任一边到达地图边界即视为飞出，对x、y两轴分别求解后取较早者
+	 */
+	static double computeExitTime(const Vector2& position, const Vector2& velocity, const Vector2& size)
+	{
+		static const SDL_Rect& rect_map = ConfigManager::instance()->rect_tile_map;
+
+		auto solve_axis = [](double pos, double vel, double min, double max) {
+			if (pos <= min || pos >= max)
+				return 0.0;
+			if (vel > 0)
+				return (max - pos) / vel;
+			if (vel < 0)
+				return (min - pos) / vel;
+			return std::numeric_limits<double>::infinity();
+		};
+
+		double time_x = solve_axis(position.x, velocity.x, rect_map.x + size.x / 2, rect_map.x + rect_map.w - size.x / 2);
+		double time_y = solve_axis(position.y, velocity.y, rect_map.y + size.y / 2, rect_map.y + rect_map.h - size.y / 2);
+
+		return std::min(time_x, time_y);
+	}
+
+private:
 	Vector2 size;					 // 子弹大小
-	Vector2 position;				 // 子弹位置
+	Vector2 position_launch;		 // 发射位置
 	Vector2 velocity;				 // 子弹速度
+	double time_launch = 0.0;		 // 发射时刻
+	double time_expire = 0.0;		 // 飞出地图的时刻
 
-	Animation animation;			 // 子弹动画
-
-	bool can_rotate = false;		 // 是否可旋转
+	Animation animation;			 // 子弹飞行动画
+	Animation anim_explode;			 // 爆炸动画，仅可爆炸的子弹使用
 
 	double damage = 0.0;			 // 伤害值
 	double damage_range = -1;		 // 伤害范围
 
-private:
 	bool is_valid = true;			 // 子弹是否有效
 	bool is_collisional = true;		 // 是否可碰撞
 	double angle_anim_rotate = 0.0;  // 动画旋转角度
@@ -0,0 +1,89 @@
+﻿#pragma once
+
+#include "bullet_type.hpp"
+#include "../util/animation.hpp"
+#include "../manager/resource_manager.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 子弹类型特性表，在编译期描述各类型子弹的外观与行为差异
+ * @tparam type 子弹类型
+ *
+ * 每个特化提供：
+ * - can_rotate：是否随飞行方向旋转
+ * - can_explode：命中后是否播放爆炸动画再失效(同时表示命中后不立即失效)
+ * - can_slow_down：命中时是否使敌人减速
+ * - damage_range：范围伤害半径，小于0表示单体伤害
+ * - size：子弹尺寸
+ * - sound_hit_list：命中音效，多于一个时随机选取
+ * - getClip()：飞行动画帧数据，首次使用时创建并在所有同类子弹间共享
+ */
+template <BulletType type>
+struct BulletTraits;
+
+template <>
+struct BulletTraits<BulletType::Arrow>
+{
+    static constexpr bool can_rotate = true;
+    static constexpr bool can_explode = false;
+    static constexpr bool can_slow_down = false;
+    static constexpr double damage_range = -1;
+    static constexpr double size = 48;
+    static constexpr std::array<ResID, 3> sound_hit_list = {
+        ResID::Sound_ArrowHit_1, ResID::Sound_ArrowHit_2, ResID::Sound_ArrowHit_3 };
+
+    static const std::shared_ptr<const AnimationClip>& getClip()
+    {
+        static const TextureHandle texture = ResourceManager::instance()->acquireTexture(ResID::Tex_BulletArrow);
+        static const auto clip = AnimationClip::create(texture, 2, 1, { 0, 1 });
+        return clip;
+    }
+};
+
+template <>
+struct BulletTraits<BulletType::Axe>
+{
+    static constexpr bool can_rotate = false;
+    static constexpr bool can_explode = false;
+    static constexpr bool can_slow_down = true;
+    static constexpr double damage_range = -1;
+    static constexpr double size = 48;
+    static constexpr std::array<ResID, 3> sound_hit_list = {
+        ResID::Sound_AxeHit_1, ResID::Sound_AxeHit_2, ResID::Sound_AxeHit_3 };
+
+    static const std::shared_ptr<const AnimationClip>& getClip()
+    {
+        static const TextureHandle texture = ResourceManager::instance()->acquireTexture(ResID::Tex_BulletAxe);
+        static const auto clip = AnimationClip::create(texture, 4, 2, { 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+        return clip;
+    }
+};
+
+template <>
+struct BulletTraits<BulletType::Shell>
+{
+    static constexpr bool can_rotate = false;
+    static constexpr bool can_explode = true;
+    static constexpr bool can_slow_down = false;
+    static constexpr double damage_range = 96;
+    static constexpr double size = 48;
+    static constexpr double size_explode = 96;     // 爆炸动画尺寸
+    static constexpr std::array<ResID, 1> sound_hit_list = { ResID::Sound_ShellHit };
+
+    static const std::shared_ptr<const AnimationClip>& getClip()
+    {
+        static const TextureHandle texture = ResourceManager::instance()->acquireTexture(ResID::Tex_BulletShell);
+        static const auto clip = AnimationClip::create(texture, 2, 1, { 0, 1 });
+        return clip;
+    }
+
+    static const std::shared_ptr<const AnimationClip>& getExplodeClip()
+    {
+        static const TextureHandle texture = ResourceManager::instance()->acquireTexture(ResID::Tex_EffectExplode);
+        static const auto clip = AnimationClip::create(texture, 5, 1, { 0, 1, 2, 3, 4 });
+        return clip;
+    }
+};
\ No newline at end of file
@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include <cstddef>
+
 /**
  * @brief 子弹类型枚举
  */
@@ -9,3 +11,8 @@ enum class BulletType
     Axe,    // 斧头类型
     Shell   // 炮弹类型
 };
+
+/**
+ * @brief 子弹类型数量，用于按类型建立的查找表
+ */
+constexpr size_t BULLET_TYPE_COUNT = 3;
\ No newline at end of file
@@ -5,8 +5,11 @@
 #include "../util/animation.hpp"
 #include "../basic/route.hpp"
 #include "../manager/config_manager.hpp"
+#include "enemy_type.hpp"
+#include "enemy_prototype.hpp"
 
-#include <memory>
+#include <algorithm>
+#include <cmath>
 #include <functional>
 
 /**
@@ -33,9 +36,9 @@ public:
 		timer_skill.setOneShot(false);
 		timer_skill.setOnTimeOut([&]() { on_skill_released(this); });
 
-		timer_sketch.setOneShot(true);
-		timer_sketch.setWaitTime(0.075);
-		timer_sketch.setOnTimeOut([&]() { is_show_sketch = false; });
+		timer_flash.setOneShot(true);
+		timer_flash.setWaitTime(0.075);
+		timer_flash.setOnTimeOut([&]() { is_show_flash = false; });
 
 		timer_restore_speed.setOneShot(true);
 		timer_restore_speed.setOnTimeOut([&]() { speed = max_speed; });
@@ -43,6 +46,65 @@ public:
 
 	~Enemy() = default;
 
+	/**
+	 * @brief 从原型复制属性并重置状态
+	 * @param prototype 敌人原型
+	 *
+	 * 帧数据只复制共享指针，生成敌人时不涉及精灵图切分与堆分配
+	 */
+	void applyPrototype(const EnemyPrototype& prototype)
+	{
+		copyPrototype(prototype);
+		reset();
+	}
+
+	/**
+	 * @brief 配置热重载后从重新烘焙的原型刷新属性
+	 * @param prototype 敌人原型
+	 *
+	 * 当前生命值按原有比例缩放，减速中的敌人保持相同的减速量，位置与路径不变，动画从头播放
+	 */
+	void refreshPrototype(const EnemyPrototype& prototype)
+	{
+		const double ratio_hp = max_hp > 0 ? hp / max_hp : 1;
+		const double speed_slowed = max_speed - speed;
+
+		copyPrototype(prototype);
+
+		hp = max_hp * ratio_hp;
+		speed = max_speed - speed_slowed;
+
+		for (Animation* anim : { &anim_up, &anim_down, &anim_left, &anim_right })
+			anim->reset();
+	}
+
+	/**
+	 * @brief 重置敌人状态
+	 *
+	 * 对象池复用敌人时调用，恢复到刚构造完成时的状态，不触发堆分配
+	 */
+	void reset()
+	{
+		hp = max_hp;
+		speed = max_speed;
+
+		position = position_last = velocity = direction = target_position = Vector2();
+		is_valid = true;
+		is_show_flash = false;
+		anim_current = nullptr;
+
+		route = nullptr;
+		index_target = 0;
+		time_spawn_delay = 0;
+
+		timer_skill.restart();
+		timer_flash.restart();
+		timer_restore_speed.restart();
+
+		for (Animation* anim : { &anim_up, &anim_down, &anim_left, &anim_right })
+			anim->reset();
+	}
+
 	/**
 	 * @brief 更新敌人状态
 	 * @param delta_time 帧间隔时间
@@ -54,18 +116,39 @@ public:
 	 */
 	void onUpdate(double delta_time)
 	{
+		position_last = position;
+
+		// 在更新步长中途生成的敌人只经历生成之后的时间
+		if (time_spawn_delay > 0) {
+			const double time_skip = std::min(time_spawn_delay, delta_time);
+			time_spawn_delay -= time_skip;
+			delta_time -= time_skip;
+		}
+
 		timer_skill.onUpdate(delta_time);
-		timer_sketch.onUpdate(delta_time);
+		timer_flash.onUpdate(delta_time);
 		timer_restore_speed.onUpdate(delta_time);
 
-		Vector2 move_distance = velocity * delta_time;
-		Vector2 target_distace = target_position - position;
-		position += move_distance < target_distace ? move_distance : target_distace;
+		// 按本帧可移动的路程沿路径前进，到达路径点后剩余路程继续用于下一段，
+		// 使移动结果与更新频率无关
+		double move_length = speed * TILE_SIZE * delta_time;
+		while (true) {
+			Vector2 target_distace = target_position - position;
+			double target_length = target_distace.length();
+			if (target_length > move_length) {
+				direction = target_distace.normalize();
+				position += direction * move_length;
+				break;
+			}
+
+			position = target_position;
+			move_length -= target_length;
+
+			if (index_target + 1 >= (int)route->getIndexList().size())
+				break;
 
-		if (target_distace.approxZero()) {
 			index_target++;
 			refreshPositionTarget();
-
 			direction = (target_position - position).normalize();
 		}
 
@@ -74,54 +157,50 @@ public:
 
 		bool is_show_x_anim = abs(velocity.x) >= abs(velocity.y);
 
-		if (is_show_sketch) {
-			if (is_show_x_anim)
-				anim_current = velocity.x > 0 ? &anim_right_sketch : &anim_left_sketch;
-			else
-				anim_current = velocity.y > 0 ? &anim_down_sketch : &anim_up_sketch;
-		}
-		else {
-			if (is_show_x_anim)
-				anim_current = velocity.x > 0 ? &anim_right : &anim_left;
-			else
-				anim_current = velocity.y > 0 ? &anim_down : &anim_up;
-		}
+		if (is_show_x_anim)
+			anim_current = velocity.x > 0 ? &anim_right : &anim_left;
+		else
+			anim_current = velocity.y > 0 ? &anim_down : &anim_up;
 
 		anim_current->onUpdate(delta_time);
 	}
 
 	/**
 	 * @brief 渲染敌人
-	 * @param renderer SDL渲染器指针
+	 * @param render_list 渲染命令列表
+	 * @param alpha 插值系数，在上次与本次更新的位置之间插值
+	 * @param is_show_hp_bar 是否绘制生命值条，敌人被合并绘制时由群体标记代替
 	 *
 	 * 渲染内容：
-	 * - 敌人精灵
+	 * - 敌人精灵，受击时叠加闪白
 	 * - 生命值条
 	 */
-	void onRender(SDL_Renderer* renderer)
+	void onRender(RenderList& render_list, double alpha, bool is_show_hp_bar = true) const
 	{
-		static SDL_Point point;
-		static SDL_Rect rect;
+		SDL_Point point;
+		SDL_Rect rect;
 		static const int offset_y = 2;
 		static const Vector2 size_hp_bar = { 40, 8 };
 		static const SDL_Color color_border = { 116, 185, 124, 255 };
 		static const SDL_Color color_content = { 226, 255, 194, 255 };
 
-		point.x = (int)(position.x - size.x / 2);
-		point.y = (int)(position.y - size.y / 2);
-		anim_current->onRender(renderer, point);
+		const Vector2 position_render = Vector2::lerp(position_last, position, alpha);
 
-		if (hp < max_hp) {
-			rect.x = (int)(position.x - size_hp_bar.x / 2);
-			rect.y = (int)(position.y - size.y / 2 - size_hp_bar.y - offset_y);
+		point.x = (int)(position_render.x - size.x / 2);
+		point.y = (int)(position_render.y - size.y / 2);
+		render_list.setLayer(RenderLayer::Actor, (int)(position_render.y + size.y / 2));
+		anim_current->onRender(render_list, point, 0, is_show_flash);
+
+		if (is_show_hp_bar && hp < max_hp) {
+			render_list.setLayer(RenderLayer::Overlay);
+			rect.x = (int)(position_render.x - size_hp_bar.x / 2);
+			rect.y = (int)(position_render.y - size.y / 2 - size_hp_bar.y - offset_y);
 			rect.w = (int)(size_hp_bar.x * (hp / max_hp));
 			rect.h = (int)size_hp_bar.y;
-			SDL_SetRenderDrawColor(renderer, color_content.r, color_content.g, color_content.b, color_content.a);
-			SDL_RenderFillRect(renderer, &rect);
+			render_list.fillRect(rect, color_content);
 
 			rect.w = (int)size_hp_bar.x;
-			SDL_SetRenderDrawColor(renderer, color_border.r, color_border.g, color_border.b, color_border.a);
-			SDL_RenderDrawRect(renderer, &rect);
+			render_list.drawRect(rect, color_border);
 		}
 	}
 
@@ -163,8 +242,8 @@ public:
 			is_valid = false;
 		}
 
-		is_show_sketch = true;
-		timer_sketch.restart();
+		is_show_flash = true;
+		timer_flash.restart();
 	}
 
 	/**
@@ -187,17 +266,72 @@ public:
 	void setPosition(const Vector2& position)
 	{
 		this->position = position;
+		this->position_last = position;
+	}
+
+	/**
+	 * @brief 设置生成延迟
+	 * @param delay 下次更新中从步长开始到生成时刻的时间(秒)
+	 */
+	void setSpawnDelay(double delay)
+	{
+		time_spawn_delay = delay;
 	}
 
 	/**
 	 * @brief 设置敌人移动路径
 	 * @param route 新的路径对象
 	 *
-	 * 设置新路径并刷新目标位置
+	 * 设置新路径并刷新目标位置，路径由地图的生成点路由池持有，此处只保存引用
 	 */
 	void setRoute(const Route* route)
 	{
-		this->route = std::make_unique<Route>(*route);
+		this->route = route;
+
+		refreshPositionTarget();
+	}
+
+	/**
+	 * @brief 路径被重新计算后，把目标点对应到新的路径点列表上
+	 *
+	 * 所在瓦片仍在路径上时从该瓦片继续前进，原目标恰好是其下一个路径点时保持原目标；
+	 * 所在瓦片已不在路径上时走向距离最近的路径点
+	 */
+	void remapRoute()
+	{
+		static const SDL_Rect& rect_tile_map = ConfigManager::instance()->rect_tile_map;
+
+		const auto& index_list = route->getIndexList();
+		if (index_list.empty()) return;
+
+		auto isSameIndex = [](const SDL_Point& lhs, const SDL_Point& rhs) { return lhs.x == rhs.x && lhs.y == rhs.y; };
+		auto getTileCenter = [](const SDL_Point& index)
+		{
+			return Vector2(rect_tile_map.x + index.x * TILE_SIZE + TILE_SIZE / 2, rect_tile_map.y + index.y * TILE_SIZE + TILE_SIZE / 2);
+		};
+
+		const SDL_Point index_current = { (int)std::floor((position.x - rect_tile_map.x) / TILE_SIZE),
+			(int)std::floor((position.y - rect_tile_map.y) / TILE_SIZE) };
+		const SDL_Point index_target_last = { (int)std::floor((target_position.x - rect_tile_map.x) / TILE_SIZE),
+			(int)std::floor((target_position.y - rect_tile_map.y) / TILE_SIZE) };
+
+		auto itor = std::find_if(index_list.begin(), index_list.end(),
+			[&](const SDL_Point& index) { return isSameIndex(index, index_current); });
+		if (itor != index_list.end()) {
+			index_target = (int)(itor - index_list.begin());
+			if (index_target + 1 < (int)index_list.size() && isSameIndex(index_list[index_target + 1], index_target_last))
+				index_target++;
+		}
+		else {
+			double distance_min = -1;
+			for (size_t i = 0; i < index_list.size(); i++) {
+				const double distance = (getTileCenter(index_list[i]) - position).length();
+				if (distance_min < 0 || distance < distance_min) {
+					distance_min = distance;
+					index_target = (int)i;
+				}
+			}
+		}
 
 		refreshPositionTarget();
 	}
@@ -221,12 +355,29 @@ public:
 		return !is_valid; 
 	}
 
+	/**
+	 * @brief 获取敌人类型
+	 * @return 敌人类型
+	 */
+	EnemyType getType() const { return type; }
+
+	/**
+	 * @brief 原型已从配置中删除时调用，敌人保留现有属性，不再随热重载刷新
+	 */
+	void detachPrototype() { type = ENEMY_TYPE_NONE; }
+
 	/**
 	 * @brief 获取敌人生命值
 	 * @return 生命值
 	 */
 	double getHp() const{ return hp;}
 
+	/**
+	 * @brief 获取敌人最大生命值
+	 * @return 最大生命值
+	 */
+	double getMaxHp() const{ return max_hp;}
+
 	/**
 	 * @brief 获取敌人尺寸
 	 * @return 尺寸向量
@@ -239,6 +390,12 @@ public:
 	 */
 	const Vector2& getPosition() const{ return position;}
 
+	/**
+	 * @brief 获取敌人本次更新前的位置
+	 * @return 位置向量，用于扫掠碰撞检测
+	 */
+	const Vector2& getLastPosition() const{ return position_last;}
+
 	/**
 	 * @brief 获取敌人速度
 	 * @return 速度向量
@@ -301,27 +458,45 @@ private:
 		}
 	}
 
-protected:
+	/**
+	 * @brief 从原型复制属性与帧数据，不改变运行状态
+	 */
+	void copyPrototype(const EnemyPrototype& prototype)
+	{
+		type = prototype.type;
+		size = prototype.size;
+
+		max_hp = prototype.hp;
+		max_speed = prototype.speed;
+		damage = prototype.damage;
+		reward_ratio = prototype.reward_ratio;
+		recover_interval = prototype.recover_interval;
+		recover_range = prototype.recover_range;
+		recover_intensity = prototype.recover_intensity;
+		timer_skill.setWaitTime(recover_interval);
+
+		Animation* anim_list[4] = { &anim_up, &anim_down, &anim_left, &anim_right };
+		for (int i = 0; i < 4; i++)
+			setAnimation(*anim_list[i], prototype.clip_list[i], prototype.frame_interval);
+	}
+
 	/**
 	 * @brief 设置动画
 	 * @param anim 动画对象
-	 * @param texture 动画纹理
-	 * @param loop 是否循环播放
-	 * @param num_h 动画横向帧数
-	 * @param num_v 动画纵向帧数
-	 * @param index_list 动画帧索引列表
+	 * @param clip 原型中共享的帧数据
 	 * @param interval 动画播放间隔
 	 *
-	 * 设置动画的播放间隔、贴图、帧索引列表、循环播放等属性
+	 * 敌人的移动动画均为循环播放
 	 */
-	void setAnimation(Animation& anim, SDL_Texture* texture, bool loop, int num_h, int num_v, const std::vector<int>& index_list, double interval)
+	void setAnimation(Animation& anim, const std::shared_ptr<const AnimationClip>& clip, double interval)
 	{
-		anim.setLoop(loop);
+		anim.setLoop(true);
 		anim.setInterval(interval);
-		anim.setFrameData(texture, num_h, num_v, index_list);
+		anim.setClip(clip);
 	}
 
-protected:
+private:
+	EnemyType type = 0;							// 敌人类型
 	Vector2 size;								// 敌人尺寸
 	Timer timer_skill;							// 技能计时器
 
@@ -329,10 +504,6 @@ protected:
 	Animation anim_down;						// 向下移动动画
 	Animation anim_left;						// 向左移动动画
 	Animation anim_right;						// 向右移动动画
-	Animation anim_up_sketch;					// 向上移动受击动画
-	Animation anim_down_sketch;					// 向下移动受击动画
-	Animation anim_left_sketch;					// 向左移动受击动画
-	Animation anim_right_sketch;				// 向右移动受击动画
 
 	double hp = 0;								// 当前生命值
 	double max_hp = 0;							// 最大生命值
@@ -346,13 +517,14 @@ protected:
 
 private:
 	Vector2 position;							// 当前位置
+	Vector2 position_last;						// 本次更新前的位置
 	Vector2 velocity;							// 当前速度向量				
 	Vector2 direction;							// 移动方向
 
 	bool is_valid = true;						// 敌人是否有效
 
-	Timer timer_sketch;							// 受击特效计时器
-	bool is_show_sketch = false;				// 是否显示受击特效
+	Timer timer_flash;							// 受击特效计时器
+	bool is_show_flash = false;				// 是否显示受击特效
 
 	Animation* anim_current = nullptr;			// 当前播放的动画
 
@@ -360,7 +532,9 @@ private:
 
 	Timer timer_restore_speed;					// 速度恢复计时器
 
-	std::unique_ptr<Route> route;				// 移动路径
+	const Route* route = nullptr;				// 移动路径
 	int index_target = 0;						// 当前目标点索引
 	Vector2 target_position;					// 目标位置
+
+	double time_spawn_delay = 0;				// 生成前剩余的延迟时间
 };
@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include "enemy_type.hpp"
+#include "../util/vector2.hpp"
+#include "../util/animation.hpp"
+#include "../manager/config_manager.hpp"
+#include "../manager/resource_manager.hpp"
+
+#include <SDL.h>
+#include <memory>
+#include <string>
+#include <utility>
+
+/**
+ * @brief 敌人原型，由配置中的敌人模板烘焙而成
+ *
+ * 原型创建后不再修改，帧数据由同一原型的所有敌人共享，
+ * 生成敌人时只需复制属性并引用帧数据，无需重新切分精灵图
+ */
+struct EnemyPrototype
+{
+	EnemyType type = 0;										// 敌人类型
+	std::string name;										// 原型名称，热重载时据此对应新的类型
+	Vector2 size;											// 碰撞箱尺寸
+	double frame_interval = 0.1;							// 动画帧间隔
+
+	TextureHandle texture;									// 精灵图，原型持有引用使其不被卸载
+	std::shared_ptr<const AnimationClip> clip_list[4];		// 各朝向移动动画，按Facing顺序存放
+
+	double hp = 0;											// 最大生命值
+	double speed = 0;										// 最大速度
+	double damage = 0;										// 伤害值
+	double reward_ratio = 0;								// 奖励系数
+	double recover_interval = 0;							// 恢复间隔
+	double recover_range = 0;								// 恢复范围
+	double recover_intensity = 0;							// 恢复强度
+
+	/**
+	 * @brief 根据配置模板烘焙原型
+	 * @param type 敌人类型
+	 * @param tmpl 敌人配置模板
+	 * @param prototype 输出参数，烘焙后的原型
+	 * @return 纹理资源全部有效返回true，否则返回false
+	 *
+	 * 需在主线程中调用，纹理在此时加载
+	 */
+	static bool bake(EnemyType type, const ConfigManager::EnemyTemplate& tmpl, EnemyPrototype& prototype)
+	{
+		static auto* resource = ResourceManager::instance();
+
+		TextureHandle texture = resource->acquireTexture(tmpl.anim.texture);
+		if (!texture) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "enemy archetype %s: texture not found", tmpl.name.c_str());
+			return false;
+		}
+
+		const auto& anim = tmpl.anim;
+		for (int i = 0; i < 4; i++)
+			prototype.clip_list[i] = AnimationClip::create(texture, anim.num_h, anim.num_v, anim.index_list[i]);
+
+		prototype.texture = std::move(texture);
+		prototype.type = type;
+		prototype.name = tmpl.name;
+		prototype.size = { tmpl.size[0], tmpl.size[1] };
+		prototype.frame_interval = anim.interval;
+
+		prototype.hp = tmpl.hp;
+		prototype.speed = tmpl.speed;
+		prototype.damage = tmpl.damage;
+		prototype.reward_ratio = tmpl.reward_ratio;
+		prototype.recover_interval = tmpl.recover_interval;
+		prototype.recover_range = tmpl.recover_range;
+		prototype.recover_intensity = tmpl.recover_intensity;
+
+		return true;
+	}
+};
\ No newline at end of file
@@ -1,13 +1,16 @@
 ﻿#pragma once
 
+#include <cstddef>
+
+/**
+ * @brief 敌人类型，即敌人原型在config.json中"enemy"节点下的声明序号
+ *
+ * 敌人原型完全由配置描述，新增敌人只需添加配置项，
+ * 关卡配置通过原型的"name"字段引用
+ */
+using EnemyType = size_t;
+
 /**
- * @brief 敌人类型枚举
+ * @brief 不对应任何原型的敌人类型，原型在热重载中被删除的存活敌人使用
  */
-enum class EnemyType
-{
-	Slime,			// 史莱姆
-	KingSlime,		// 皇家史莱姆
-	Skeleton,		// 骷髅
-	Goblin,			// 哥布林
-	GoblinPriest	// 哥布林祭司
-};
\ No newline at end of file
+constexpr EnemyType ENEMY_TYPE_NONE = (EnemyType)-1;
\ No newline at end of file
@@ -3,70 +3,95 @@
 #include "manager.hpp"
 #include "../bullet/bullet.hpp"
 #include "../bullet/bullet_type.hpp"
-#include "../bullet/arrow_bullet.hpp"
-#include "../bullet/axe_bullet.hpp"
-#include "../bullet/shell_bullet.hpp"
+#include "../bullet/bullet_traits.hpp"
+#include "../util/slot_map.hpp"
 
-#include <vector>
-#include <memory>
 #include <algorithm>
+#include <array>
 
 /**
  * @brief 子弹管理器类，负责管理游戏中所有子弹的生命周期
- * @details 继承自Manager单例模板类，实现了子弹的更新、渲染和发射等功能
+ * @details 继承自Manager单例模板类，实现了子弹的更新、渲染和发射等功能。
+ *          子弹按类型分别按值存放在紧密数组中，每种类型的更新与渲染
+ *          都是以类型为模板参数的独立循环，可被编译器内联展开。
+ *          管理器维护子弹的模拟时钟，子弹位置由该时钟按解析式求得
  */
 class BulletManager : public Manager<BulletManager>
 {
 	friend class Manager<BulletManager>;
 
 public:
-	using BulletList = std::vector<Bullet *>; // 子弹列表类型别名
+	using BulletList = SlotMap<Bullet>; // 同类型子弹列表类型别名
 
 public:
 	/**
 	 * @brief 更新所有子弹的状态
 	 * @param delta_time 帧间隔时间
-	 * @details 遍历所有子弹进行更新，并清理需要移除的子弹
+	 * @details 推进模拟时钟，逐类型更新子弹，并清理需要移除的子弹
 	 */
 	void onUpdate(double delta_time)
 	{
-		for (auto *bullet : m_bullet_list)
-		{
-			bullet->onUpdate(delta_time);
-		}
+		m_time_last = m_time;
+		m_time += delta_time;
 
-		m_bullet_list.erase(std::remove_if(
-								m_bullet_list.begin(), m_bullet_list.end(),
-								[](const Bullet *bullet)
-								{
-									bool deletable = bullet->canRemove();
-									if (deletable)
-										delete bullet;
-
-									return deletable;
-								}),
-							m_bullet_list.end());
+		updateBulletList<BulletType::Arrow>(delta_time);
+		updateBulletList<BulletType::Axe>(delta_time);
+		updateBulletList<BulletType::Shell>(delta_time);
 	}
 
 	/**
 	 * @brief 渲染所有子弹
-	 * @param renderer SDL渲染器指针
+	 * @param render_list 渲染命令列表
+	 * @param alpha 插值系数，在上次与本次更新的模拟时间之间插值
 	 */
-	void onRender(SDL_Renderer *renderer)
+	void onRender(RenderList &render_list, double alpha)
 	{
-		for (auto *bullet : m_bullet_list)
-		{
-			bullet->onRender(renderer);
-		}
+		const double time_render = m_time_last + (m_time - m_time_last) * alpha;
+
+		renderBulletList<BulletType::Arrow>(render_list, time_render);
+		renderBulletList<BulletType::Axe>(render_list, time_render);
+		renderBulletList<BulletType::Shell>(render_list, time_render);
+	}
+
+	/**
+	 * @brief 获取子弹模拟时钟的当前时间
+	 * @return 模拟时间(秒)，用于求子弹的当前位置
+	 */
+	double getTime() const
+	{
+		return m_time;
 	}
 
 	/**
-	 * @brief 获取子弹列表
+	 * @brief 获取指定类型的子弹列表
+	 * @tparam TYPE 子弹类型
 	 * @return 返回子弹列表的引用
 	 */
+	template <BulletType TYPE>
 	BulletList &getBulletList()
 	{
-		return m_bullet_list;
+		return m_bullet_list_table[(size_t)TYPE];
+	}
+
+	/**
+	 * @brief 获取指定类型的子弹列表
+	 * @param type 子弹类型
+	 * @return 返回子弹列表的引用
+	 */
+	BulletList &getBulletList(BulletType type)
+	{
+		return m_bullet_list_table[(size_t)type];
+	}
+
+	/**
+	 * @brief 通过句柄获取子弹
+	 * @param type 子弹类型，句柄只在同类型的列表内有效
+	 * @param handle 子弹句柄
+	 * @return 子弹指针，子弹已被移除时返回nullptr。指针在下次移除子弹前有效
+	 */
+	Bullet *getBullet(BulletType type, SlotHandle handle)
+	{
+		return getBulletList(type).get(handle);
 	}
 
 	/**
@@ -75,44 +100,84 @@ public:
 	 * @param position 初始位置
 	 * @param velocity 初始速度
 	 * @param damage 伤害值
-	 * @details 根据类型创建对应的子弹对象，设置其属性后加入管理列表
+	 * @param time_elapsed 发射时刻距当前模拟时间已经过的时间(秒)
+	 * @return 新子弹在对应类型列表中的句柄
 	 */
-	void fireBullet(BulletType type, const Vector2 &position, const Vector2 &velocity, double damage)
+	SlotHandle fireBullet(BulletType type, const Vector2 &position, const Vector2 &velocity, double damage, double time_elapsed = 0.0)
 	{
-		std::unique_ptr<Bullet> bullet = nullptr;
 		switch (type)
 		{
-		case BulletType::Arrow:
-			bullet = std::make_unique<ArrowBullet>();
-			break;
 		case BulletType::Axe:
-			bullet = std::make_unique<AxeBullet>();
-			break;
+			return fireBullet<BulletType::Axe>(position, velocity, damage, time_elapsed);
 		case BulletType::Shell:
-			bullet = std::make_unique<ShellBullet>();
-			break;
+			return fireBullet<BulletType::Shell>(position, velocity, damage, time_elapsed);
 		default:
-			bullet = std::make_unique<ArrowBullet>();
-			break;
+			return fireBullet<BulletType::Arrow>(position, velocity, damage, time_elapsed);
 		}
+	}
 
-		bullet->setPosition(position);
-		bullet->setVelocity(velocity);
-		bullet->setDamage(damage);
+	/**
+	 * @brief 发射指定类型的新子弹
+	 * @tparam TYPE 子弹类型
+	 * @param position 初始位置
+	 * @param velocity 初始速度
+	 * @param damage 伤害值
+	 * @param time_elapsed 发射时刻距当前模拟时间已经过的时间(秒)，
+	 *        发射发生在更新步长之间时子弹从真实的发射时刻开始运动
+	 * @return 新子弹在对应类型列表中的句柄
+	 */
+	template <BulletType TYPE>
+	SlotHandle fireBullet(const Vector2 &position, const Vector2 &velocity, double damage, double time_elapsed = 0.0)
+	{
+		BulletList &bullet_list = getBulletList<TYPE>();
 
-		m_bullet_list.push_back(bullet.release());
+		SlotHandle handle = bullet_list.emplace();
+		if (Bullet *bullet = bullet_list.get(handle))
+			bullet->init<TYPE>(m_time - time_elapsed, position, velocity, damage);
+
+		return handle;
 	}
 
 protected:
 	BulletManager() = default;
-	~BulletManager()
+	~BulletManager() = default;
+
+private:
+	std::array<BulletList, BULLET_TYPE_COUNT> m_bullet_list_table; // 按类型存放所有活动子弹，下标即BulletType
+	double m_time = 0.0;										   // 子弹模拟时钟(秒)
+	double m_time_last = 0.0;									   // 上次更新前的模拟时间(秒)
+
+private:
+	/**
+	 * @brief 更新指定类型的所有子弹并移除失效子弹
+	 * @tparam TYPE 子弹类型
+	 * @param delta_time 帧间隔时间
+	 */
+	template <BulletType TYPE>
+	void updateBulletList(double delta_time)
 	{
-		for (auto &bullet : m_bullet_list)
+		BulletList &bullet_list = getBulletList<TYPE>();
+
+		for (Bullet &bullet : bullet_list)
 		{
-			delete bullet;
+			bullet.onUpdate<TYPE>(m_time, delta_time);
 		}
+
+		bullet_list.eraseIf([](const Bullet &bullet) { return bullet.canRemove(); });
 	}
 
-private:
-	BulletList m_bullet_list; // 存储所有活动子弹的列表
-};
+	/**
+	 * @brief 渲染指定类型的所有子弹
+	 * @tparam TYPE 子弹类型
+	 * @param render_list 渲染命令列表
+	 * @param time 渲染时刻(模拟时间，秒)，本次更新中发射的子弹从发射时刻开始渲染
+	 */
+	template <BulletType TYPE>
+	void renderBulletList(RenderList &render_list, double time)
+	{
+		for (const Bullet &bullet : getBulletList<TYPE>())
+		{
+			bullet.onRender<TYPE>(render_list, std::max(time, bullet.getLaunchTime()));
+		}
+	}
+};
\ No newline at end of file
@@ -3,10 +3,8 @@
 #include "manager.hpp"
 #include "config_manager.hpp"
 #include "../basic/coin_prop.hpp"
-
-#include <vector>
-#include <memory>
-#include <algorithm>
+#include "../util/slot_map.hpp"
+#include "../util/object_pool.hpp"
 
 /**
  * @brief 金币管理器类，负责管理游戏中的金币数量
@@ -18,7 +16,7 @@ class CoinManager : public Manager<CoinManager>
     friend class Manager<CoinManager>;
 
 public:
-    using CoinPropList = std::vector<CoinProp*>;  // 金币道具列表类型别名
+    using CoinPropList = SlotMap<CoinProp*>;  // 金币道具列表类型别名
 
 public:
     /**
@@ -50,25 +48,25 @@ public:
             coin_prop->onUpdate(delta_time);
         }
 
-        // 移除并删除标记为可删除的金币道具
-        m_coin_prop_list.erase(std::remove_if(
-            m_coin_prop_list.begin(), m_coin_prop_list.end(),
-            [](CoinProp* coin_prop) {
+        // 移除标记为可删除的金币道具并归还对象池
+        m_coin_prop_list.eraseIf(
+            [this](CoinProp* coin_prop) {
                 bool deletable = coin_prop->canRemove();
-                if (deletable) delete coin_prop;
+                if (deletable) m_coin_prop_pool.release(coin_prop);
                 return deletable;
-            }), m_coin_prop_list.end());
+            });
     }
 
     /**
      * @brief 渲染金币系统
-     * @param renderer SDL渲染器指针
+     * @param render_list 渲染命令列表
+     * @param alpha 插值系数，在上次与本次更新的位置之间插值
      * @details 渲染所有活跃的金币道具
      */
-    void onRender(SDL_Renderer* renderer)
+    void onRender(RenderList& render_list, double alpha)
     {
         for (auto* coin_prop : m_coin_prop_list) {
-            coin_prop->onRender(renderer);
+            coin_prop->onRender(render_list, alpha);
         }
     }
 
@@ -90,16 +88,40 @@ public:
         return m_coin_prop_list;
     }
 
+    /**
+     * @brief 通过句柄获取金币道具
+     * @param handle 金币道具句柄
+     * @return 金币道具指针，道具已被移除时返回nullptr
+     */
+    CoinProp* getCoinProp(SlotHandle handle)
+    {
+        CoinProp** coin_prop = m_coin_prop_list.get(handle);
+        return coin_prop ? *coin_prop : nullptr;
+    }
+
     /**
      * @brief 在指定位置生成金币道具
      * @param position 生成位置的坐标
-     * @details 使用智能指针确保内存安全，将所有权转移到列表中
+     * @return 新金币道具的句柄
+     * @details 从对象池中取出金币道具并重置状态，所有权始终归对象池
      */
-    void spawnCoinProp(const Vector2& position)
+    SlotHandle spawnCoinProp(const Vector2& position)
     {
-        std::unique_ptr<CoinProp> coin_prop = std::make_unique<CoinProp>();
+        CoinProp* coin_prop = m_coin_prop_pool.acquire();
+        coin_prop->reset();
         coin_prop->setPosition(position);
-        m_coin_prop_list.push_back(coin_prop.release());
+        return m_coin_prop_list.insert(coin_prop);
+    }
+
+    /**
+     * @brief 预热金币道具对象池
+     * @param count 即将到来的波次最多可能掉落的金币数量
+     * @details 在波次间歇期调用，上一波尚未消失的金币仍占用对象，因此按空闲数量预留
+     */
+    void prewarm(size_t count)
+    {
+        m_coin_prop_pool.reserve(count);
+        m_coin_prop_list.reserve(m_coin_prop_list.size() + count);
     }
 
 protected:
@@ -112,18 +134,10 @@ protected:
         m_num_coin = ConfigManager::instance()->num_initial_coin;
     }
 
-    /**
-     * @brief 析构函数
-     * @details 清理所有动态分配的金币道具
-     */
-    ~CoinManager()
-    {
-        for (auto* coin_prop : m_coin_prop_list) {
-            delete coin_prop;
-        }
-    }
+    ~CoinManager() = default;
 
 private:
-    double m_num_coin = 0;          // 当前金币数量
-    CoinPropList m_coin_prop_list;  // 金币道具列表
+    double m_num_coin = 0;                      // 当前金币数量
+    CoinPropList m_coin_prop_list;              // 金币道具列表
+    ObjectPool<CoinProp> m_coin_prop_pool;      // 金币道具对象池，持有所有金币道具
 };
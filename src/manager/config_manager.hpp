@@ -1,17 +1,24 @@
 ﻿#pragma once
 
 #include "manager.hpp"
+#include "resource_manager.hpp"
 #include "../basic/map.hpp"
-#include "../basic/wave.hpp"
+#include "../bullet/bullet_type.hpp"
+#include "../enemy/enemy_type.hpp"
+#include "../tower/tower_type.hpp"
+#include "../util/frame_pacer.hpp"
+#include "../util/wave_timeline.hpp"
 
 #include <SDL.h>
 #include <cJSON.h>
 #include <string>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <memory>
 #include <array>
+#include <unordered_map>
 
 /**
  * @brief 游戏配置管理类，负责加载和管理所有游戏相关的配置数据
@@ -20,6 +27,7 @@
 class ConfigManager : public Manager<ConfigManager>
 {
 	friend class Manager<ConfigManager>;
+	friend class ConfigReloader;
 
 public:
 	/**
@@ -30,6 +38,12 @@ public:
 		std::string window_title = "Tower Defence"; // 游戏窗口标题
 		int window_width = 1280;					// 窗口宽度
 		int window_height = 720;					// 窗口高度
+		double sim_rate = 60;						// 游戏逻辑更新频率(Hz)
+		double render_rate = 60;					// 渲染频率(Hz)
+		PacingMode pacing = PacingMode::VSync;		// 帧率控制模式
+		int tile_cache_size = 64;					// 瓦片地图区块缓存的纹理大小预算(MB)
+		int resource_cache_size = 256;				// 纹理与音效的驻留大小预算(MB)，超出时卸载无引用的资源
+		int crowd_lod_threshold = 8;				// 同一瓦片中的敌人达到该数量时合并绘制，0表示不合并
 	};
 
 	/**
@@ -44,11 +58,27 @@ public:
 		double skill_damage = 1;			 // 技能伤害
 	};
 
+	/**
+	 * @brief 四向动画配置结构体
+	 * @details 纹理按资源名引用，帧索引列表按Facing枚举顺序(上、下、左、右)存放
+	 */
+	struct FacingAnimTemplate
+	{
+		std::string texture;			 // 精灵图纹理资源名
+		int num_h = 1;					 // 水平方向帧数
+		int num_v = 1;					 // 垂直方向帧数
+		double interval = 0.1;			 // 帧间隔(秒)
+		std::vector<int> index_list[4];	 // 各朝向的动画帧索引列表
+	};
+
 	/**
 	 * @brief 敌人单位配置结构体
 	 */
 	struct EnemyTemplate
 	{
+		std::string name;			   // 原型名称，关卡配置通过该名称引用
+		FacingAnimTemplate anim;	   // 移动动画
+		double size[2] = {48, 48};	   // 碰撞箱尺寸(宽、高)
 		double hp = 100;			   // 生命值
 		double speed = 1.0;			   // 移动速度
 		double damage = 1;			   // 攻击伤害
@@ -68,17 +98,22 @@ public:
 		double view_range[10] = {5};   // 攻击范围（各等级）
 		double cost[10] = {50};		   // 建造费用（各等级）
 		double upgrade_cost[9] = {75}; // 升级费用（各等级）
+
+		FacingAnimTemplate anim_idle;				  // 静止动画
+		FacingAnimTemplate anim_fire;				  // 开火动画
+		double size[2] = {48, 48};					  // 尺寸(宽、高)
+		double fire_speed = 6;						  // 子弹飞行速度
+		BulletType bullet_type = BulletType::Arrow;	  // 子弹类型
+		std::vector<std::string> fire_sound_list;	  // 开火音效资源名列表，开火时随机选取
 	};
 
 public:
 	// 游戏状态相关成员
-	Map map;					 // 游戏地图实例
-	std::vector<Wave> wave_list; // 敌人波次列表
+	Map map;					// 游戏地图实例
+	WaveTimeline wave_timeline; // 敌人波次时间线
 
-	// 防御塔等级状态
-	int level_archer = 0; // 弓箭手塔当前等级
-	int level_axeman = 0; // 斧头兵塔当前等级
-	int level_gunner = 0; // 枪手塔当前等级
+	// 防御塔等级状态，下标即TowerType
+	int tower_level_list[TOWER_TYPE_COUNT] = {0};
 
 	// 游戏状态标志
 	bool is_game_win = true;   // 游戏胜利标志
@@ -90,17 +125,11 @@ public:
 	BasicTemplate basic_template;	// 基础配置
 	PlayerTemplate player_template; // 玩家配置
 
-	// 敌人类型配置
-	EnemyTemplate slime_template;		  // 史莱姆配置
-	EnemyTemplate king_slime_template;	  // 皇家史莱姆配置
-	EnemyTemplate skeleton_template;	  // 骷髅配置
-	EnemyTemplate goblin_template;		  // 哥布林配置
-	EnemyTemplate goblin_priest_template; // 哥布林祭司配置
+	// 敌人原型配置，下标即EnemyType
+	std::vector<EnemyTemplate> enemy_template_list;
 
-	// 防御塔类型配置
-	TowerTemplate archer_template; // 弓箭手塔配置
-	TowerTemplate axeman_template; // 斧头兵塔配置
-	TowerTemplate gunner_template; // 枪手塔配置
+	// 防御塔配置，下标即TowerType
+	TowerTemplate tower_template_list[TOWER_TYPE_COUNT];
 
 	// 游戏常量配置
 	static constexpr double num_initial_hp = 10;	// 初始生命值
@@ -108,44 +137,123 @@ public:
 	static constexpr double num_coin_per_prop = 10; // 每个道具价值
 
 public:
+	/**
+	 * @brief 获取防御塔配置模板
+	 * @param type 防御塔类型
+	 * @return 对应类型的配置模板
+	 */
+	TowerTemplate &getTowerTemplate(TowerType type)
+	{
+		return tower_template_list[(size_t)type];
+	}
+
+	/**
+	 * @brief 获取防御塔当前等级
+	 * @param type 防御塔类型
+	 * @return 对应类型的等级引用
+	 */
+	int &getTowerLevel(TowerType type)
+	{
+		return tower_level_list[(size_t)type];
+	}
+
+	/**
+	 * @brief 统计关卡中出现的敌人类型
+	 * @return 下标为敌人类型，在关卡的生成事件中出现过的为true
+	 * @details 只有这些类型的敌人原型与资源需要在开局前准备；
+	 *          直接取自时间线的类型名表，不需要遍历生成记录
+	 */
+	std::vector<bool> collectLevelEnemyTypes() const
+	{
+		std::vector<bool> is_used_list(enemy_template_list.size(), false);
+		for (uint32_t i = 0; wave_timeline.isOpen() && i < wave_timeline.getTypeCount(); i++)
+		{
+			const EnemyType type = wave_timeline.getType((uint16_t)i);
+			if (type < is_used_list.size())
+				is_used_list[type] = true;
+		}
+
+		return is_used_list;
+	}
+
+	/**
+	 * @brief 解析敌人类型字符串
+	 * @param str 敌人原型名称
+	 * @param type 输出参数，原型在enemy_template_list中的下标
+	 * @return 解析成功返回true，失败返回false
+	 */
+	bool parseEnemyType(const char *str, EnemyType &type) const
+	{
+		for (size_t i = 0; i < enemy_template_list.size(); i++)
+		{
+			if (enemy_template_list[i].name == str)
+			{
+				type = i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief 应用热重载时解析出的游戏配置
+	 * @param other 解析了新游戏配置的副本
+	 * @details 替换玩家、敌人与防御塔模板；基础配置中只有crowd_lod_threshold立即生效，
+	 *          窗口、频率与缓存大小等在重启后生效。需在逻辑线程空闲时调用
+	 */
+	void applyGameConfig(const ConfigManager &other)
+	{
+		basic_template.crowd_lod_threshold = other.basic_template.crowd_lod_threshold;
+		player_template = other.player_template;
+		enemy_template_list = other.enemy_template_list;
+		for (size_t i = 0; i < TOWER_TYPE_COUNT; i++)
+			tower_template_list[i] = other.tower_template_list[i];
+	}
+
+	/**
+	 * @brief 应用热重载时解析出的关卡配置
+	 * @param other 解析了新关卡配置的副本，其波次时间线被交换出来
+	 * @details 需在逻辑线程空闲时调用，之后由WaveManager重新定位读取进度
+	 */
+	void applyLevelConfig(ConfigManager &other)
+	{
+		wave_timeline.swap(other.wave_timeline);
+	}
+
 	/**
 	 * @brief 加载关卡配置文件
 	 * @param path 关卡配置文件路径
 	 * @return 加载成功返回true，失败返回false
-	 * @details 从JSON格式的配置文件中读取并解析关卡波次信息
+	 * @details 优先使用编译好的波次时间线(与关卡文件同名的.wave文件)：
+	 *          资源包中有该条目且关卡文件不比资源包新时直接引用映射的内存，
+	 *          磁盘上的文件比关卡文件新时映射该文件，否则把JSON格式的关卡文件编译到内存中。
+	 *          生成事件按名称引用敌人原型，需在loadGameConfig之后调用
 	 */
 	bool loadLevelConfig(const std::string &path)
 	{
-		// 读取文件内容
-		std::ifstream file(path);
-		if (!file.good())
-			return false;
+		const std::string path_compiled = std::filesystem::path(path).replace_extension(".wave").string();
 
-		std::stringstream buffer;
-		buffer << file.rdbuf();
-		file.close();
+		static auto *resource = ResourceManager::instance();
 
-		// 解析JSON
-		JsonPtr json_root = makeJsonPtr(cJSON_Parse(buffer.str().c_str()));
-		if (!json_root || json_root->type != cJSON_Array)
-			return false;
+		const uint8_t *data = nullptr;
+		size_t size = 0;
+		bool is_opened = false;
+		if (!is_loose_file_only && !resource->isLooseFileNewer(path) && resource->findPackFile(path_compiled, data, size))
+			is_opened = wave_timeline.open(data, size);
+		else if (isCompiledLevelNewer(path, path_compiled))
+			is_opened = wave_timeline.openFile(path_compiled);
 
-		// 清空现有数据
-		wave_list.clear();
-
-		// 解析每个波次
-		cJSON *json_wave = nullptr;
-		cJSON_ArrayForEach(json_wave, json_root.get())
+		if (!is_opened)
 		{
-			wave_list.emplace_back();
-			if (!parseWave(json_wave, wave_list.back()))
-			{
-				wave_list.pop_back();
-				continue;
-			}
+			std::string content;
+			std::vector<uint8_t> buffer;
+			if (!readConfigFile(path, content) || !WaveTimelineCompiler::compile(content.c_str(), buffer)
+				|| !wave_timeline.openBuffer(std::move(buffer)))
+				return false;
 		}
 
-		return !wave_list.empty();
+		bindWaveTypes();
+		return true;
 	}
 
 	/**
@@ -157,16 +265,12 @@ public:
 	bool loadGameConfig(const std::string &path)
 	{
 		// 读取文件内容
-		std::ifstream file(path);
-		if (!file)
+		std::string content;
+		if (!readConfigFile(path, content))
 			return false;
 
-		std::stringstream buffer;
-		buffer << file.rdbuf();
-		file.close();
-
 		// 解析JSON
-		JsonPtr json_root = makeJsonPtr(cJSON_Parse(buffer.str().c_str()));
+		JsonPtr json_root = makeJsonPtr(cJSON_Parse(content.c_str()));
 		if (!json_root || json_root->type != cJSON_Object)
 		{
 			return false;
@@ -186,39 +290,27 @@ public:
 			!parsePlayerTemplate(player_template, json_player))
 			return false;
 
-		// 解析敌人配置
-		struct
-		{
-			const char *key;
-			EnemyTemplate &tmpl;
-		} enemies[] = {
-			{"slime", slime_template},
-			{"king_slime", king_slime_template},
-			{"skeleton", skeleton_template},
-			{"goblin", goblin_template},
-			{"goblin_priest", goblin_priest_template}};
-
-		for (const auto &enemy : enemies)
+		// 解析敌人原型，声明顺序即EnemyType
+		enemy_template_list.clear();
+
+		cJSON *json_enemy_template = nullptr;
+		cJSON_ArrayForEach(json_enemy_template, json_enemy)
 		{
-			if (!parseEnemyTemplate(enemy.tmpl, getJsonObject(json_enemy, enemy.key)))
+			enemy_template_list.emplace_back();
+			if (!parseEnemyTemplate(enemy_template_list.back(), json_enemy_template))
 			{
+				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "invalid enemy archetype: %s", json_enemy_template->string);
 				return false;
 			}
 		}
 
+		if (enemy_template_list.empty())
+			return false;
+
 		// 解析防御塔配置
-		struct
+		for (size_t i = 0; i < TOWER_TYPE_COUNT; i++)
 		{
-			const char *key;
-			TowerTemplate &tmpl;
-		} towers[] = {
-			{"archer", archer_template},
-			{"axeman", axeman_template},
-			{"gunner", gunner_template}};
-
-		for (const auto &tower : towers)
-		{
-			if (!parseTowerTemplate(tower.tmpl, getJsonObject(json_tower, tower.key)))
+			if (!parseTowerTemplate(tower_template_list[i], getJsonObject(json_tower, TOWER_TYPE_KEY_LIST[i])))
 			{
 				return false;
 			}
@@ -323,97 +415,78 @@ private:
 	}
 
 	/**
-	 * @brief 解析敌人类型字符串
-	 * @param str 类型字符串
-	 * @param type 输出参数，解析后的敌人类型枚举值
-	 * @return 解析成功返回true，失败返回false
+	 * @brief 解析JSON数组中的整数列表
+	 * @param list 输出参数，解析后的列表
+	 * @param json_array JSON数组对象
+	 * @return 解析出至少一个元素返回true，否则返回false
 	 */
-	bool parseEnemyType(const char *str, EnemyType &type)
+	bool parseIntList(std::vector<int> &list, const cJSON *json_array)
 	{
-		static const std::unordered_map<std::string, EnemyType> enemyTypes = {
-			{"Slime", EnemyType::Slime},
-			{"KingSlime", EnemyType::KingSlime},
-			{"Skeleton", EnemyType::Skeleton},
-			{"Goblin", EnemyType::Goblin},
-			{"GoblinPriest", EnemyType::GoblinPriest}};
-
-		auto it = enemyTypes.find(str);
-		if (it != enemyTypes.end())
+		list.clear();
+		if (!json_array || json_array->type != cJSON_Array)
+			return false;
+
+		cJSON *item = nullptr;
+		cJSON_ArrayForEach(item, json_array)
 		{
-			type = it->second;
-			return true;
+			if (item->type == cJSON_Number)
+				list.push_back(item->valueint);
 		}
-		return false;
+
+		return !list.empty();
 	}
 
 	/**
-	 * @brief 解析敌人生成事件配置
-	 * @param json_spawn_event 生成事件的JSON对象
-	 * @param spawn_event 输出参数，解析后的生成事件结构
+	 * @brief 解析子弹类型字符串
+	 * @param str 类型字符串
+	 * @param type 输出参数，解析后的子弹类型枚举值
 	 * @return 解析成功返回true，失败返回false
 	 */
-	bool parseSpawnEvent(const cJSON *json_spawn_event, Wave::SpawnEvent &spawn_event)
+	bool parseBulletType(const char *str, BulletType &type)
 	{
-		if (!json_spawn_event || json_spawn_event->type != cJSON_Object)
-		{
-			return false;
-		}
+		static const std::unordered_map<std::string, BulletType> bulletTypes = {
+			{"Arrow", BulletType::Arrow},
+			{"Axe", BulletType::Axe},
+			{"Shell", BulletType::Shell}};
 
-		// 获取基本属性
-		if (!getJsonNumber(json_spawn_event, "interval", spawn_event.interval) ||
-			!getJsonNumber(json_spawn_event, "spawn_point", spawn_event.spawn_point))
+		auto it = bulletTypes.find(str);
+		if (it != bulletTypes.end())
 		{
-			return false;
-		}
-
-		// 解析敌人类型
-		auto json_enemy_type = cJSON_GetObjectItem(json_spawn_event, "enemy_type");
-		if (!json_enemy_type || json_enemy_type->type != cJSON_String ||
-			!parseEnemyType(json_enemy_type->valuestring, spawn_event.enemy_type))
-		{
-			return false;
+			type = it->second;
+			return true;
 		}
-
-		return true;
+		return false;
 	}
 
 	/**
-	 * @brief 解析波次配置
-	 * @param json_wave 波次的JSON对象
-	 * @param wave 输出参数，解析后的波次结构
+	 * @brief 解析四向动画配置
+	 * @param anim_template 输出参数，解析后的动画配置
+	 * @param json_root 动画配置的JSON对象
 	 * @return 解析成功返回true，失败返回false
 	 */
-	bool parseWave(const cJSON *json_wave, Wave &wave)
+	bool parseFacingAnimTemplate(FacingAnimTemplate &anim_template, const cJSON *json_root)
 	{
-		if (!json_wave || json_wave->type != cJSON_Object)
-		{
+		if (!json_root || json_root->type != cJSON_Object)
 			return false;
-		}
 
-		// 获取基本属性
-		if (!getJsonNumber(json_wave, "rewards", wave.rewards) ||
-			!getJsonNumber(json_wave, "interval", wave.interval))
-		{
+		static const char *facing_keys[4] = {"up", "down", "left", "right"};
+
+		if (!getJsonString(json_root, "texture", anim_template.texture) ||
+			!getJsonNumber(json_root, "num_h", anim_template.num_h) ||
+			!getJsonNumber(json_root, "num_v", anim_template.num_v) ||
+			!getJsonNumber(json_root, "interval", anim_template.interval))
 			return false;
-		}
 
-		// 解析生成事件列表
-		auto json_spawn_list = cJSON_GetObjectItem(json_wave, "spawn_list");
-		if (!json_spawn_list || json_spawn_list->type != cJSON_Array)
+		if (anim_template.num_h <= 0 || anim_template.num_v <= 0)
 			return false;
 
-		cJSON *json_spawn_event = nullptr;
-		cJSON_ArrayForEach(json_spawn_event, json_spawn_list)
+		for (int i = 0; i < 4; i++)
 		{
-			wave.spawn_event_list.emplace_back();
-			if (!parseSpawnEvent(json_spawn_event, wave.spawn_event_list.back()))
-			{
-				wave.spawn_event_list.pop_back();
-				continue;
-			}
+			if (!parseIntList(anim_template.index_list[i], cJSON_GetObjectItem(json_root, facing_keys[i])))
+				return false;
 		}
 
-		return !wave.spawn_event_list.empty();
+		return true;
 	}
 
 	/**
@@ -427,9 +500,16 @@ private:
 		if (!json_root)
 			return false;
 
+		std::string pacing;
 		return getJsonString(json_root, "window_title", basic_template.window_title) &&
 			   getJsonNumber(json_root, "window_width", basic_template.window_width) &&
-			   getJsonNumber(json_root, "window_height", basic_template.window_height);
+			   getJsonNumber(json_root, "window_height", basic_template.window_height) &&
+			   getJsonNumber(json_root, "sim_rate", basic_template.sim_rate) && basic_template.sim_rate > 0 &&
+			   getJsonNumber(json_root, "render_rate", basic_template.render_rate) && basic_template.render_rate > 0 &&
+			   getJsonString(json_root, "pacing", pacing) && FramePacer::parseMode(pacing, basic_template.pacing) &&
+			   getJsonNumber(json_root, "tile_cache_size", basic_template.tile_cache_size) && basic_template.tile_cache_size > 0 &&
+			   getJsonNumber(json_root, "resource_cache_size", basic_template.resource_cache_size) && basic_template.resource_cache_size > 0 &&
+			   getJsonNumber(json_root, "crowd_lod_threshold", basic_template.crowd_lod_threshold) && basic_template.crowd_lod_threshold >= 0;
 	}
 
 	/**
@@ -458,9 +538,15 @@ private:
 	 */
 	bool parseEnemyTemplate(EnemyTemplate &enemy_template, const cJSON *json_root)
 	{
-		if (!json_root)
+		if (!json_root || json_root->type != cJSON_Object)
 			return false;
 
+		if (!getJsonString(json_root, "name", enemy_template.name) ||
+			!parseFacingAnimTemplate(enemy_template.anim, cJSON_GetObjectItem(json_root, "animation")))
+			return false;
+
+		parseNumberArray(enemy_template.size, 2, cJSON_GetObjectItem(json_root, "size"));
+
 		return getJsonNumber(json_root, "hp", enemy_template.hp) &&
 			   getJsonNumber(json_root, "speed", enemy_template.speed) &&
 			   getJsonNumber(json_root, "damage", enemy_template.damage) &&
@@ -486,11 +572,80 @@ private:
 		parseNumberArray(tower_template.view_range, 10, cJSON_GetObjectItem(json_root, "view_range"));
 		parseNumberArray(tower_template.cost, 10, cJSON_GetObjectItem(json_root, "cost"));
 		parseNumberArray(tower_template.upgrade_cost, 9, cJSON_GetObjectItem(json_root, "upgrade_cost"));
+		parseNumberArray(tower_template.size, 2, cJSON_GetObjectItem(json_root, "size"));
+
+		if (!parseFacingAnimTemplate(tower_template.anim_idle, cJSON_GetObjectItem(json_root, "anim_idle")) ||
+			!parseFacingAnimTemplate(tower_template.anim_fire, cJSON_GetObjectItem(json_root, "anim_fire")) ||
+			!getJsonNumber(json_root, "fire_speed", tower_template.fire_speed))
+			return false;
+
+		std::string bullet_type;
+		if (!getJsonString(json_root, "bullet_type", bullet_type) ||
+			!parseBulletType(bullet_type.c_str(), tower_template.bullet_type))
+			return false;
+
+		tower_template.fire_sound_list.clear();
+		const cJSON *json_sound_list = cJSON_GetObjectItem(json_root, "fire_sound");
+		if (json_sound_list && json_sound_list->type == cJSON_Array)
+		{
+			cJSON *json_sound = nullptr;
+			cJSON_ArrayForEach(json_sound, json_sound_list)
+			{
+				if (json_sound->type == cJSON_String)
+					tower_template.fire_sound_list.push_back(json_sound->valuestring);
+			}
+		}
 
 		return true;
 	}
 
+	/**
+	 * @brief 磁盘上编译好的时间线是否比关卡文件新
+	 * @details 关卡文件不存在时只要时间线文件存在即可
+	 */
+	static bool isCompiledLevelNewer(const std::string &path, const std::string &path_compiled)
+	{
+		std::error_code error;
+		const auto time_compiled = std::filesystem::last_write_time(path_compiled, error);
+		if (error)
+			return false;
+
+		const auto time_level = std::filesystem::last_write_time(path, error);
+		return error || time_compiled >= time_level;
+	}
+
+	/**
+	 * @brief 把时间线的类型名表按名称映射为敌人类型
+	 * @details 找不到的原型映射为无效类型，对应的生成事件被跳过
+	 */
+	void bindWaveTypes()
+	{
+		std::vector<size_t> type_map(wave_timeline.getTypeCount(), SIZE_MAX);
+		for (uint32_t i = 0; i < wave_timeline.getTypeCount(); i++)
+		{
+			if (!parseEnemyType(wave_timeline.getTypeName(i), type_map[i]))
+				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "unknown enemy archetype in level: %s", wave_timeline.getTypeName(i));
+		}
+
+		wave_timeline.setTypeMap(std::move(type_map));
+	}
+
+	/**
+	 * @brief 读取配置文件的全部内容
+	 * @details 热重载的副本跳过资源包读取磁盘上的松散文件，单例优先从资源包读取
+	 */
+	bool readConfigFile(const std::string &path, std::string &content) const
+	{
+		if (is_loose_file_only)
+			return ResourceManager::readLooseFile(path, content);
+
+		return ResourceManager::instance()->readFile(path, content);
+	}
+
 protected:
 	ConfigManager() = default;
 	~ConfigManager() = default;
+
+private:
+	bool is_loose_file_only = false; // 是否只读取松散文件，热重载的副本使用
 };
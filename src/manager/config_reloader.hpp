@@ -0,0 +1,164 @@
+﻿#pragma once
+
+#include "config_manager.hpp"
+#include "../util/file_watcher.hpp"
+#include "../util/worker_thread.hpp"
+
+#include <SDL.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 配置热重载器
+ *
+ * 监视游戏配置与关卡配置文件，文件变化后在后台线程中用loadGameConfig/loadLevelConfig
+ * 把配置解析到独立的副本，解析期间游戏照常运行；解析成功后由主线程在两次逻辑更新之间
+ * 调用apply()一次性替换到配置管理器。解析失败时保留当前配置，等待文件再次变化。
+ * 游戏配置变化时关卡配置也一并重新解析，因为生成事件按名称引用的敌人类型可能改变了顺序
+ */
+class ConfigReloader
+{
+public:
+    /**
+     * @brief 一次热重载替换的内容
+     */
+    struct Result
+    {
+        bool is_game_reloaded = false;  // 游戏配置是否已替换
+        bool is_level_reloaded = false; // 关卡配置是否已替换
+    };
+
+public:
+    ConfigReloader()
+    {
+        staging.is_loose_file_only = true;
+    }
+
+    ~ConfigReloader() = default;
+
+    ConfigReloader(const ConfigReloader&) = delete;
+    ConfigReloader& operator=(const ConfigReloader&) = delete;
+
+    /**
+     * @brief 开始监视配置文件
+     * @param path_game 游戏配置文件路径
+     * @param path_level 关卡配置文件路径
+     * @return 监视成功返回true，否则返回false
+     */
+    bool start(const std::string& path_game, const std::string& path_level)
+    {
+        this->path_game = path_game;
+        this->path_level = path_level;
+
+        is_active = watcher.watch(path_game) && watcher.watch(path_level);
+        if (!is_active)
+            watcher.close();
+
+        return is_active;
+    }
+
+    bool isActive() const { return is_active; }
+
+    /**
+     * @brief 检查文件变化与后台解析的进度
+     * @return 有解析成功、等待apply()的配置时返回true
+     * @details 需在主线程中、逻辑线程空闲时调用；不会等待后台解析
+     */
+    bool poll()
+    {
+        if (!is_active)
+            return false;
+
+        if (is_parsing) {
+            if (!thread_parse.isIdle())
+                return false;
+
+            is_parsing = false;
+            if (is_parse_success)
+                return true;
+
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "config reload failed, keeping the current config");
+        }
+
+        watcher.poll(path_changed_list);
+        for (const auto& path : path_changed_list) {
+            is_game_pending |= (path == path_game);
+            is_level_pending |= (path == path_level);
+        }
+
+        if (is_game_pending || is_level_pending)
+            startParse();
+
+        return false;
+    }
+
+    /**
+     * @brief 把解析好的配置替换到配置管理器
+     * @return 本次替换的内容
+     * @details 需在poll()返回true之后、逻辑线程空闲时调用
+     */
+    Result apply()
+    {
+        auto* config = ConfigManager::instance();
+
+        Result result;
+        result.is_game_reloaded = is_game_parsed;
+        result.is_level_reloaded = is_level_parsed;
+
+        if (is_game_parsed)
+            config->applyGameConfig(staging);
+        if (is_level_parsed)
+            config->applyLevelConfig(staging);
+
+        SDL_Log("config reloaded:%s%s, parsed in %.1fms",
+                is_game_parsed ? " game" : "", is_level_parsed ? " level" : "", time_parse);
+
+        is_game_parsed = is_level_parsed = false;
+        return result;
+    }
+
+private:
+    ConfigManager staging;                      // 解析新配置的副本
+    FileWatcher watcher;                        // 配置文件监视器
+    WorkerThread thread_parse;                  // 后台解析线程
+    std::vector<std::string> path_changed_list; // 本次检查发生变化的文件
+    std::string path_game;                      // 游戏配置文件路径
+    std::string path_level;                     // 关卡配置文件路径
+
+    bool is_active = false;                     // 是否正在监视
+    bool is_parsing = false;                    // 后台线程是否正在解析
+    bool is_parse_success = false;              // 最近一次解析是否成功
+    bool is_game_pending = false;               // 游戏配置是否有尚未解析的变化
+    bool is_level_pending = false;              // 关卡配置是否有尚未解析的变化
+    bool is_game_parsed = false;                // 副本中是否有待替换的游戏配置
+    bool is_level_parsed = false;               // 副本中是否有待替换的关卡配置
+    double time_parse = 0;                      // 最近一次解析的耗时(毫秒)
+
+private:
+    /**
+     * @brief 在后台线程中解析有变化的配置文件
+     */
+    void startParse()
+    {
+        const bool is_game = is_game_pending;
+        is_game_pending = is_level_pending = false;
+
+        // 只有关卡变化时按当前的敌人模板解析生成事件，此时逻辑线程空闲，可以安全复制
+        if (!is_game)
+            staging.enemy_template_list = ConfigManager::instance()->enemy_template_list;
+
+        is_parsing = true;
+        thread_parse.post([this, is_game]()
+            {
+                const auto time_begin = std::chrono::steady_clock::now();
+
+                is_parse_success = (!is_game || staging.loadGameConfig(path_game))
+                    && staging.loadLevelConfig(path_level);
+                is_game_parsed = is_parse_success && is_game;
+                is_level_parsed = is_parse_success;
+
+                time_parse = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_begin).count();
+            });
+    }
+};
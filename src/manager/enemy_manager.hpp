@@ -5,16 +5,18 @@
 #include "home_manager.hpp"
 #include "bullet_manager.hpp"
 #include "coin_manager.hpp"
+#include "particle_manager.hpp"
 #include "../enemy/enemy.hpp"
-#include "../enemy/slime_enemy.hpp"
-#include "../enemy/king_slime_enemy.hpp"
-#include "../enemy/skeleton_enemy.hpp"
-#include "../enemy/goblin_enemy.hpp"
-#include "../enemy/goblin_priest_enemy.hpp"
+#include "../enemy/enemy_prototype.hpp"
+#include "../util/slot_map.hpp"
+#include "../util/object_pool.hpp"
+#include "../util/spatial_grid.hpp"
+#include "../util/sweep.hpp"
 
-#include <vector>
-#include <memory>
 #include <algorithm>
+#include <cmath>
+
+#include <vector>
 
 /**
  * @brief 敌人管理器类，负责管理游戏中所有敌人单位
@@ -25,7 +27,7 @@ class EnemyManager : public Manager<EnemyManager>
     friend class Manager<EnemyManager>;
 
 public:
-    using EnemyList = std::vector<Enemy*>;  // 敌人列表类型别名
+    using EnemyList = SlotMap<Enemy*>;  // 敌人列表类型别名
 
 public:
     /**
@@ -39,81 +41,155 @@ public:
             enemy->onUpdate(delta_time);
         }
 
-        processHomeCollision();      // 处理与基地的碰撞
-        processBulletCollision();    // 处理与子弹的碰撞
+        // 子弹时钟在本帧稍后才推进，碰撞检测使用与敌人相同的时间步
+        const double time = BulletManager::instance()->getTime() + delta_time;
+
+        processHomeCollision(time);     // 处理与基地的碰撞
+        processBulletCollision(time);   // 处理与子弹的碰撞
 
         removeInvaliedEnemy();       // 移除无效的敌人
     }
 
     /**
      * @brief 渲染所有敌人
-     * @param renderer SDL渲染器指针
+     * @param render_list 渲染命令列表
+     * @param alpha 插值系数，在上次与本次更新的位置之间插值
+     * @details 开启群体细节层次时，敌人按所在瓦片分组，
+     *          数量达到阈值的瓦片只绘制一个代表敌人与显示数量和总生命值的群体标记，
+     *          绘制命令数不再随堆叠的敌人数增长
      */
-    void onRender(SDL_Renderer* renderer)
+    void onRender(RenderList& render_list, double alpha)
     {
+        static const auto& rect_tile_map = ConfigManager::instance()->rect_tile_map;
+        const int threshold = ConfigManager::instance()->basic_template.crowd_lod_threshold;  // 热重载可能修改，每帧读取
+
+        if (!m_is_crowd_lod || threshold <= 0 || m_enemy_list.size() < (size_t)threshold) {
+            for (auto* enemy : m_enemy_list) {
+                enemy->onRender(render_list, alpha);
+            }
+            return;
+        }
+
+        m_grid_render.reset(rect_tile_map, TILE_SIZE);
+        for (size_t i = 0; i < m_enemy_list.size(); i++)
+            m_grid_render.insert((uint32_t)i, m_enemy_list[i]->getPosition());
+        m_grid_render.build();
+
+        m_grid_render.forEachCell(
+            [&](const uint32_t* id_list, uint32_t num) {
+                if (num < (uint32_t)threshold) {
+                    for (uint32_t i = 0; i < num; i++)
+                        m_enemy_list[id_list[i]]->onRender(render_list, alpha);
+                }
+                else
+                    renderCrowd(render_list, alpha, id_list, num);
+            });
+    }
+
+    /**
+     * @brief 切换群体细节层次，只影响绘制
+     */
+    void toggleCrowdLOD() { m_is_crowd_lod = !m_is_crowd_lod; }
+
+    bool isCrowdLOD() const { return m_is_crowd_lod; }  // 是否开启群体细节层次
+
+    /**
+     * @brief 根据配置中的敌人模板烘焙关卡中出现的敌人原型
+     * @return 所有原型烘焙成功返回true，否则返回false
+     *
+     * 需在游戏配置加载完成后、在主线程中调用；
+     * 关卡中没有出现的类型不烘焙，其精灵图也不会加载
+     */
+    bool loadPrototypes()
+    {
+        const auto* config = ConfigManager::instance();
+        const auto& enemy_template_list = config->enemy_template_list;
+        const auto is_used_list = config->collectLevelEnemyTypes();
+
+        m_prototype_list.clear();
+        m_prototype_list.resize(enemy_template_list.size());
+        for (size_t i = 0; i < enemy_template_list.size(); i++) {
+            if (is_used_list[i] && !EnemyPrototype::bake(i, enemy_template_list[i], m_prototype_list[i]))
+                return false;
+        }
+
+        return !m_prototype_list.empty();
+    }
+
+    /**
+     * @brief 配置热重载后重新烘焙敌人原型，并刷新存活敌人的属性
+     * @return 烘焙成功返回true；失败时保留原有原型
+     *
+     * 原型的下标随配置中的顺序变化，存活敌人按原型名称对应到新的类型；
+     * 新关卡不再使用的原型为其按需烘焙，名称已被删除的敌人保持原样。
+     * 需在主线程中、逻辑线程空闲时调用
+     */
+    bool reloadPrototypes()
+    {
+        auto* config = ConfigManager::instance();
+
+        auto prototype_list_last = std::move(m_prototype_list);
+        if (!loadPrototypes()) {
+            m_prototype_list = std::move(prototype_list_last);
+            return false;
+        }
+
         for (auto* enemy : m_enemy_list) {
-            enemy->onRender(renderer);
+            const EnemyType type_last = enemy->getType();
+            if (type_last >= prototype_list_last.size()) continue;
+
+            EnemyType type;
+            if (!config->parseEnemyType(prototype_list_last[type_last].name.c_str(), type)) {
+                enemy->detachPrototype();
+                continue;
+            }
+
+            EnemyPrototype& prototype = m_prototype_list[type];
+            if (!prototype.texture && !EnemyPrototype::bake(type, config->enemy_template_list[type], prototype))
+                continue;
+
+            enemy->refreshPrototype(prototype);
         }
+
+        return true;
+    }
+
+    /**
+     * @brief 地图路径被重新计算后，把存活敌人的目标点对应到新的路径上
+     *
+     * 路径对象的地址不变，但其路径点列表可能变短或改变走向，
+     * 敌人缓存的目标点下标随之失效。需在主线程中、逻辑线程空闲时调用
+     */
+    void remapRoutes()
+    {
+        for (auto* enemy : m_enemy_list)
+            enemy->remapRoute();
     }
 
     /**
      * @brief 在指定生成点生成指定类型的敌人
-     * @param type 敌人类型枚举值
+     * @param type 敌人类型
      * @param index_spawn_point 生成点的索引
+     * @param delay 生成时刻距本次更新步长开始的时间(秒)，敌人在本次更新中只移动生成之后的部分
+     * @return 新敌人的句柄，生成点或敌人类型不存在、或该类型的原型未烘焙时返回空句柄
      *
      * @details 函数功能：
      * 1. 根据给定的生成点索引获取路径信息
-     * 2. 根据敌人类型创建对应的敌人实例
-     * 3. 设置敌人的技能释放回调（处理治疗范围效果）
-     * 4. 设置敌人的初始位置和移动路径
+     * 2. 从对象池中取出敌人实例，复制对应原型的属性并重置状态
+     * 3. 设置敌人的初始位置和移动路径
      */
-    void spawnEnemy(EnemyType type, const int index_spawn_point)
+    SlotHandle spawnEnemy(EnemyType type, const int index_spawn_point, double delay = 0)
     {
         static Vector2 position_spawn;  // 敌人生成位置
         static const auto& rect_tile_map = ConfigManager::instance()->rect_tile_map;  // 地图矩形区域
         static const auto& spawner_route_pool = ConfigManager::instance()->map.getSpawnerRoutePool();  // 生成点路径池
 
         const auto& itor = spawner_route_pool.find(index_spawn_point);
-        if (itor == spawner_route_pool.end()) return;
-
-        std::unique_ptr<Enemy> enemy = nullptr;
-        switch (type) {
-        case EnemyType::Slime:
-            enemy = std::make_unique<SlimeEnemy>();
-            break;
-        case EnemyType::KingSlime:
-            enemy = std::make_unique<KingSlimeEnemy>();
-            break;
-        case EnemyType::Skeleton:
-            enemy = std::make_unique<SkeletonEnemy>();
-            break;
-        case EnemyType::Goblin:
-            enemy = std::make_unique<GoblinEnemy>();
-            break;
-        case EnemyType::GoblinPriest:
-            enemy = std::make_unique<GoblinPriestEnemy>();
-            break;
-        default:
-            enemy = std::make_unique<SlimeEnemy>();
-            break;
-        }
-
-        // 设置敌人的技能释放回调，处理治疗范围效果
-        enemy->setOnSkillReleased(
-            [&](Enemy* enemy_src) {
-                double recover_radius = enemy_src->getRecoverRadius();
-                if (recover_radius < 0) return;
+        if (itor == spawner_route_pool.end()) return SlotHandle();
+        if (type >= m_prototype_list.size() || !m_prototype_list[type].texture) return SlotHandle();
 
-                const Vector2 position_src = enemy_src->getPosition();
-                for (auto* enemy_dst : m_enemy_list) {
-                    if (enemy_dst == enemy_src) continue;
-
-                    const Vector2& position_dst = enemy_dst->getPosition();
-                    double distance = (position_dst - position_src).length();
-                    if (distance <= recover_radius)
-                        enemy_dst->increaseHP(enemy_src->getRecoverIntensity());
-                }
-            });
+        Enemy* enemy = m_enemy_pool.acquire();
+        enemy->applyPrototype(m_prototype_list[type]);
 
         // 计算生成位置坐标
         const auto& index_list = itor->second.getIndexList();
@@ -122,8 +198,23 @@ public:
 
         enemy->setPosition(position_spawn);
         enemy->setRoute(&itor->second);
+        enemy->setSpawnDelay(delay);
 
-        m_enemy_list.push_back(enemy.release());
+        return m_enemy_list.insert(enemy);
+    }
+
+    /**
+     * @brief 按波次的生成事件数预热对象池
+     * @param count 即将开始的波次要生成的敌人数
+     *
+     * 在波次间歇期调用，保证空闲敌人数量不少于该数量，
+     * 使波次开始后的生成过程不再触发堆分配。
+     * 敌人的类型差异全部来自原型，不同类型共用同一个对象池
+     */
+    void prewarm(size_t count)
+    {
+        m_enemy_pool.reserve(count);
+        m_enemy_list.reserve(m_enemy_list.size() + count);
     }
 
     /**
@@ -135,6 +226,15 @@ public:
         return m_enemy_list.empty();
     }
 
+    /**
+     * @brief 获取最后一个敌人被移除后经过的时间
+     * @return 距上次更新结束的时间(秒)，敌人在更新步长中途被击杀时不为0
+     */
+    double getTimeSinceLastRemoval() const
+    {
+        return m_time_collision_last - m_time_last_removal;
+    }
+
     /**
      * @brief 获取敌人列表
      * @return EnemyList& 敌人列表引用
@@ -144,24 +244,72 @@ public:
         return m_enemy_list;
     }
 
+    /**
+     * @brief 通过句柄获取敌人
+     * @param handle 敌人句柄
+     * @return 敌人指针，敌人已被移除时返回nullptr
+     */
+    Enemy* getEnemy(SlotHandle handle)
+    {
+        Enemy** enemy = m_enemy_list.get(handle);
+        return enemy ? *enemy : nullptr;
+    }
+
 protected:
-    EnemyManager() = default;
-    ~EnemyManager()
+    /**
+     * @brief 构造函数
+     * @details 池中的敌人在创建时就绑定了技能释放回调（处理治疗范围效果），
+     *          复用时无需重新构造回调
+     */
+    EnemyManager()
     {
-        for (auto* enemy : m_enemy_list) {
-            delete enemy;
-        }
+        m_enemy_pool.setFactory(
+            [this]() {
+                Enemy* enemy = new Enemy();
+                enemy->setOnSkillReleased(
+                    [this](Enemy* enemy_src) {
+                        double recover_radius = enemy_src->getRecoverRadius();
+                        if (recover_radius < 0) return;
+
+                        const Vector2 position_src = enemy_src->getPosition();
+                        for (auto* enemy_dst : m_enemy_list) {
+                            if (enemy_dst == enemy_src) continue;
+
+                            const Vector2& position_dst = enemy_dst->getPosition();
+                            double distance = (position_dst - position_src).length();
+                            if (distance <= recover_radius)
+                                enemy_dst->increaseHP(enemy_src->getRecoverIntensity());
+                        }
+                    });
+
+                return enemy;
+            });
     }
 
+    ~EnemyManager() = default;
+
 private:
-    EnemyList m_enemy_list;  // 存储所有敌人对象的容器
+    using EnemyPool = ObjectPool<Enemy>;  // 敌人对象池类型别名
+
+private:
+    EnemyList m_enemy_list;                          // 存储所有敌人对象的容器
+    EnemyPool m_enemy_pool;                          // 敌人对象池
+    std::vector<EnemyPrototype> m_prototype_list;    // 敌人原型，下标即EnemyType
+
+    SpatialGrid m_grid_enemy;                        // 碰撞检测粗筛网格
+    SpatialGrid m_grid_render;                       // 群体细节层次的分组网格
+    bool m_is_crowd_lod = true;                      // 是否开启群体细节层次
+    double m_broad_phase_margin = 0;                 // 粗筛查询范围的扩展距离
+    double m_time_collision_last = 0;                // 上次碰撞检测的子弹模拟时间
+    double m_time_last_removal = 0;                  // 最后一个敌人被击杀或到达基地的子弹模拟时间
 
 private:
     /**
      * @brief 处理敌人与基地的碰撞检测
+     * @param time 本次更新结束时的子弹模拟时间
      * @details 检查每个敌人是否与基地位置重叠，如果重叠则造成伤害
      */
-    void processHomeCollision()
+    void processHomeCollision(double time)
     {
         // 获取基地相关的静态配置
         static const auto& index_home = ConfigManager::instance()->map.getIndexHome();
@@ -183,80 +331,210 @@ private:
                 && position_enemy.y <= position_home_tile.y + TILE_SIZE) {
                 enemy->makeInvalid();
                 HomeManager::instance()->decreaseHP(enemy->getDamage());
+                m_time_last_removal = time;
             }
         }
     }
 
     /**
      * @brief 处理敌人与子弹的碰撞检测
-     * @details 检查每个敌人是否与子弹位置重叠，如果重叠则造成伤害
+     * @param time 本次更新结束时的子弹模拟时间
+     * @details 采用连续碰撞检测：子弹从上次检测到本次检测的运动轨迹与敌人碰撞箱
+     *          做扫掠测试(扣除敌人自身的位移)，命中最早接触的敌人，
+     *          因此高速子弹或较大的时间步长也不会穿透敌人。
+     *          敌人先按中心点放入网格，子弹只检测轨迹附近格子中的敌人。
+     *          子弹按类型分组存放，逐类型进行检测
      */
-    void processBulletCollision()
+    void processBulletCollision(double time)
     {
-        static const auto& bullet_list = BulletManager::instance()->getBulletList();
+        static const auto& rect_tile_map = ConfigManager::instance()->rect_tile_map;
 
-        for (auto* enemy : m_enemy_list) {
+        // 重建粗筛网格，同时统计候选范围需要扩展的距离
+        m_grid_enemy.reset(rect_tile_map, TILE_SIZE);
+        m_broad_phase_margin = 0;
+        for (size_t i = 0; i < m_enemy_list.size(); i++) {
+            const Enemy* enemy = m_enemy_list[i];
             if (enemy->canRemove()) continue;
 
             const Vector2& size_enemy = enemy->getSize();
-            const Vector2& position_enemy = enemy->getPosition();
-            const double min_x = position_enemy.x - size_enemy.x / 2;
-            const double max_x = position_enemy.x + size_enemy.x / 2;
-            const double min_y = position_enemy.y - size_enemy.y / 2;
-            const double max_y = position_enemy.y + size_enemy.y / 2;
-
-            for (auto* bullet : bullet_list) {
-                if (!bullet->canCollide()) continue;
-
-                const Vector2& position_bullet = bullet->getPosition();
-                // 如果子弹与敌人的边界没有交集，直接跳过
-                if (position_bullet.x < min_x
-                    || position_bullet.x > max_x 
-                    || position_bullet.y < min_y 
-                    || position_bullet.y > max_y)
-                    continue;
-
-                double damage = bullet->getDamage();
-                double damage_range = bullet->getDamageRange();
-
-                if (damage_range < 0) {
-                    // 处理伤害
-                    enemy->decreaseHP(damage);
-                    if (enemy->canRemove())
-                        trySpawnCoinProp(position_enemy, enemy->getRewardRatio());
+            const Vector2 displacement = enemy->getPosition() - enemy->getLastPosition();
+            m_broad_phase_margin = std::max(m_broad_phase_margin,
+                std::max(size_enemy.x, size_enemy.y) / 2 + std::max(std::abs(displacement.x), std::abs(displacement.y)));
+
+            m_grid_enemy.insert((uint32_t)i, enemy->getPosition());
+        }
+        m_grid_enemy.build();
+
+        processBulletCollision<BulletType::Arrow>(m_time_collision_last, time);
+        processBulletCollision<BulletType::Axe>(m_time_collision_last, time);
+        processBulletCollision<BulletType::Shell>(m_time_collision_last, time);
+
+        m_time_collision_last = time;
+    }
+
+    /**
+     * @brief 处理指定类型的子弹与敌人的碰撞
+     * @tparam TYPE 子弹类型
+     * @param time_last 上次碰撞检测的子弹模拟时间
+     * @param time 本次碰撞检测的子弹模拟时间
+     */
+    template <BulletType TYPE>
+    void processBulletCollision(double time_last, double time)
+    {
+        static auto& bullet_list = BulletManager::instance()->getBulletList<TYPE>();
+        static auto* particle = ParticleManager::instance();
+
+        for (Bullet& bullet : bullet_list) {
+            if (!bullet.canCollide()) continue;
+
+            // 子弹在本时间步内的轨迹，新发射的子弹从发射时刻开始
+            const double time_start = std::max(time_last, bullet.getLaunchTime());
+            const Vector2 position_start = bullet.getPosition(time_start);
+            const Vector2 position_end = bullet.getPosition(time);
+            const Vector2 delta_bullet = position_end - position_start;
+
+            // 敌人在本时间步内匀速移动，轨迹截取到与子弹相同的时间段
+            const double ratio_start = time > time_last ? (time_start - time_last) / (time - time_last) : 0;
+
+            Enemy* enemy_hit = nullptr;
+            double time_hit = 1.0;
+
+            m_grid_enemy.query(
+                std::min(position_start.x, position_end.x) - m_broad_phase_margin,
+                std::min(position_start.y, position_end.y) - m_broad_phase_margin,
+                std::max(position_start.x, position_end.x) + m_broad_phase_margin,
+                std::max(position_start.y, position_end.y) + m_broad_phase_margin,
+                [&](uint32_t index) {
+                    Enemy* enemy = m_enemy_list[index];
+                    if (enemy->canRemove()) return;
+
+                    // 在敌人参考系中扫掠：起点相对于敌人在子弹起始时刻的位置，位移扣除敌人在同一时间段内的位移
+                    const Vector2& position_enemy_last = enemy->getLastPosition();
+                    const Vector2 delta_enemy_step = enemy->getPosition() - position_enemy_last;
+                    const Vector2 position_enemy_start = position_enemy_last + delta_enemy_step * ratio_start;
+                    const Vector2 delta_enemy = delta_enemy_step * (1 - ratio_start);
+
+                    double time_contact = 0;
+                    if (sweepPointAABB(position_start - position_enemy_start, delta_bullet - delta_enemy,
+                        enemy->getSize() * 0.5, time_contact) && (!enemy_hit || time_contact < time_hit)) {
+                        enemy_hit = enemy;
+                        time_hit = time_contact;
+                    }
+                });
+
+            if (!enemy_hit) continue;
+
+            const Vector2 position_bullet = position_start + delta_bullet * time_hit;
+            const double time_collide = time_start + (time - time_start) * time_hit;
+            double damage = bullet.getDamage();
+            double damage_range = bullet.getDamageRange();
+
+            if (damage_range < 0) {
+                // 处理伤害
+                enemy_hit->decreaseHP(damage);
+                spawnDamageText(enemy_hit, damage);
+                particle->emit(EmitterType::HitSpark, position_bullet);
+                if (enemy_hit->canRemove()) {
+                    trySpawnCoinProp(enemy_hit->getPosition(), enemy_hit->getRewardRatio());
+                    m_time_last_removal = std::max(m_time_last_removal, time_collide);
                 }
-                else {
-                    for (auto* target_enemy : m_enemy_list) {
-                        const Vector2& position_target_enemy = target_enemy->getPosition();
-                        if ((position_target_enemy - position_bullet).length() <= damage_range) {
-                            target_enemy->decreaseHP(damage);
-                            if (target_enemy->canRemove())
-                                trySpawnCoinProp(position_target_enemy, target_enemy->getRewardRatio());
+            }
+            else {
+                // 本帧内已被击杀的敌人要到帧末才移除，不再重复结算
+                for (auto* target_enemy : m_enemy_list) {
+                    if (target_enemy->canRemove()) continue;
+
+                    const Vector2& position_target_enemy = target_enemy->getPosition();
+                    if ((position_target_enemy - position_bullet).length() <= damage_range) {
+                        target_enemy->decreaseHP(damage);
+                        spawnDamageText(target_enemy, damage);
+                        if (target_enemy->canRemove()) {
+                            trySpawnCoinProp(position_target_enemy, target_enemy->getRewardRatio());
+                            m_time_last_removal = std::max(m_time_last_removal, time_collide);
                         }
                     }
                 }
-
-                bullet->onCollide(enemy);
             }
+
+            bullet.onCollide<TYPE>(enemy_hit, time_collide);
         }
     }
 
+    /**
+     * @brief 合并绘制同一瓦片中的一群敌人
+     * @param render_list 渲染命令列表
+     * @param alpha 插值系数
+     * @param id_list 敌人在列表中的下标
+     * @param num 敌人数量
+     * @details 绘制路径进度最靠前的敌人作为代表，
+     *          在其上方绘制所有敌人的总生命值条与数量
+     */
+    void renderCrowd(RenderList& render_list, double alpha, const uint32_t* id_list, uint32_t num)
+    {
+        static const FontHandle font = ResourceManager::instance()->acquireFont(ResID::Font_Main);
+        static const Vector2 size_hp_bar = { 48, 8 };
+        static const SDL_Color color_border = { 116, 185, 124, 255 };
+        static const SDL_Color color_content = { 226, 255, 194, 255 };
+        static const SDL_Color color_count = { 255, 255, 255, 255 };
+
+        const Enemy* enemy_front = m_enemy_list[id_list[0]];
+        double hp = 0, max_hp = 0;
+        for (uint32_t i = 0; i < num; i++) {
+            const Enemy* enemy = m_enemy_list[id_list[i]];
+            hp += enemy->getHp();
+            max_hp += enemy->getMaxHp();
+            if (enemy->getRouteProcess() > enemy_front->getRouteProcess())
+                enemy_front = enemy;
+        }
+
+        enemy_front->onRender(render_list, alpha, false);
+
+        const Vector2 position = Vector2::lerp(enemy_front->getLastPosition(), enemy_front->getPosition(), alpha);
+        SDL_Rect rect;
+        rect.x = (int)(position.x - size_hp_bar.x / 2);
+        rect.y = (int)(position.y - enemy_front->getSize().y / 2 - size_hp_bar.y - 2);
+        rect.w = (int)(size_hp_bar.x * (max_hp > 0 ? hp / max_hp : 0));
+        rect.h = (int)size_hp_bar.y;
+
+        render_list.setLayer(RenderLayer::Overlay);
+        render_list.fillRect(rect, color_content);
+        rect.w = (int)size_hp_bar.x;
+        render_list.drawRect(rect, color_border);
+        render_list.drawText(font, "x" + std::to_string(num), color_count,
+            { (int)position.x, rect.y - TTF_FontHeight(font) }, TextAlign::Center);
+    }
+
+    /**
+     * @brief 在敌人头顶生成伤害飘字
+     * @param enemy 受到伤害的敌人
+     * @param damage 伤害值
+     */
+    void spawnDamageText(const Enemy* enemy, double damage)
+    {
+        static const SDL_Color color_damage = { 255, 255, 255, 255 };
+
+        const Vector2& position = enemy->getPosition();
+        ParticleManager::instance()->spawnFloatingText({ position.x, position.y - enemy->getSize().y / 2 },
+            (int)std::ceil(damage), color_damage);
+    }
 
     /**
      * @brief 移除标记为无效的敌人对象
-     * @details 使用remove_if算法清理已经标记为可移除的敌人
+     * @details 逐个交换到末尾弹出，每次移除为O(1)，已发出的句柄随之失效，
+     *          移除的敌人归还到对象池，被击杀的敌人留下死亡烟尘
      */
     void removeInvaliedEnemy()
     {
-        m_enemy_list.erase(std::remove_if(
-            m_enemy_list.begin(), m_enemy_list.end(),
-            [](const Enemy* enemy) { 
+        m_enemy_list.eraseIf(
+            [this](Enemy* enemy) { 
                 bool deletable = enemy->canRemove();
+                if (deletable && enemy->getHp() <= 0)
+                    ParticleManager::instance()->emit(EmitterType::DeathPuff, enemy->getPosition());
                 if (deletable) 
-                    delete enemy;
+                    m_enemy_pool.release(enemy);
 
                 return deletable;
-            }), m_enemy_list.end());
+            });
     }
 
     /**
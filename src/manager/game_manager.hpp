@@ -3,16 +3,27 @@
 #include "manager.hpp"
 #include "resource_manager.hpp"
 #include "config_manager.hpp"
+#include "config_reloader.hpp"
 #include "enemy_manager.hpp"
 #include "player_manager.hpp"
 #include "wave_manager.hpp"
 #include "tower_manager.hpp"
 #include "bullet_manager.hpp"
+#include "particle_manager.hpp"
+#include "replay_manager.hpp"
 #include "../ui/status_bar.hpp"
 #include "../ui/end_banner.hpp"
 #include "../ui/panel/panel.hpp"
 #include "../ui/panel/place_panel.hpp"
 #include "../ui/panel/upgrade_panel.hpp"
+#include "../util/cpu_usage.hpp"
+#include "../util/frame_pacer.hpp"
+#include "../util/latency_stats.hpp"
+#include "../util/worker_thread.hpp"
+#include "../render/camera.hpp"
+#include "../render/render_list.hpp"
+#include "../render/render_device.hpp"
+#include "../render/tile_chunk_cache.hpp"
 
 #include <SDL.h>
 #include <SDL_image.h>
@@ -22,6 +33,8 @@
 #include <stdexcept>
 #include <string>
 #include <chrono>
+#include <cstdlib>
+#include <vector>
 
 // 自定义删除器，用于智能指针管理SDL资源
 struct SDLDeleter
@@ -39,45 +52,115 @@ class GameManager : public Manager<GameManager>
     friend class Manager<GameManager>;
 
 public:
-    /** @brief 运行游戏主循环 */
+    /**
+     * @brief 运行游戏主循环
+     * @details 支持命令行参数：
+     *          --record <path> 录制本局游戏；
+     *          --replay <path> 回放录像，录像结束后退出并报告状态是否一致；
+     *          --speed <1|2|4|16|max> 初始时间倍率，运行中可用数字键1~5切换；
+     *          --pacing <vsync|limiter|uncapped> 覆盖配置中的帧率控制模式；
+     *          --watch 监视游戏配置与关卡配置，修改后不重启即可生效，录制与回放时不可用。
+     *          游戏逻辑以固定步长推进，倍速只改变每帧推进的步数，
+     *          因此相同输入下倍速运行与正常速度运行的结果一致。
+     *          逻辑频率与渲染频率分别由配置的sim_rate与render_rate决定，
+     *          渲染时按累积的剩余时间在最近两次逻辑状态之间插值。
+     *          滚轮缩放、按住中键拖拽或方向键平移摄像机；
+     *          按P键暂停，按E键进入地图编辑模式；暂停、失去焦点、最小化与游戏结束时转为事件驱动，
+     *          只在画面需要更新时渲染，退出时输出各状态的CPU占用率，
+     *          以及输入事件到逻辑更新、到画面呈现的延迟百分位数。
+     *          游戏逻辑与渲染命令的生成在逻辑线程中进行，主线程负责事件与SDL渲染，
+     *          第N+1帧的逻辑更新与第N帧渲染命令的提交同时进行
+     */
     int run(int argc, char **argv)
     {
-        Mix_FadeInMusic(ResourceManager::instance()->getMusicPool().find(ResID::Music_BGM)->second, -1, 1500);
+        if (!parseArguments(argc, argv))
+            return -1;
+
+        m_music_bgm = ResourceManager::instance()->acquireMusic(ResID::Music_BGM);
+        Mix_FadeInMusic(m_music_bgm, -1, 1500);
 
         using clock = std::chrono::high_resolution_clock;
-        constexpr double TARGET_FPS = 60.0;
-        constexpr double FRAME_TIME = 1.0 / TARGET_FPS;
 
         auto last_time = clock::now();
 
         while (!m_quit)
         {
-            // 事件处理
-            processEvents();
+            // 运行状态变化时切换CPU统计并重绘一次
+            const RunState state = getRunState();
+            if (state != m_state_last)
+            {
+                m_cpu_usage.switchTo((size_t)state);
+                m_need_redraw = true;
+                m_state_last = state;
+            }
 
-            // 时间控制和帧率限制
-            auto current_time = clock::now();
-            double delta_time = std::chrono::duration<double>(current_time - last_time).count();
+            // 帧率控制：在处理事件之前等待，使本帧读取到尽可能新的输入
+            if (state == RunState::Running)
+                m_frame_pacer.wait();
 
-            if (delta_time < FRAME_TIME)
+            // 上一帧已呈现的输入在逻辑线程空闲时结束测量，逻辑线程会读取测量状态
+            if (m_is_input_presented)
             {
-                auto sleep_time = static_cast<Uint32>((FRAME_TIME - delta_time) * 1000);
-                SDL_Delay(sleep_time);
-                current_time = clock::now();
-                delta_time = FRAME_TIME;
+                m_is_input_pending = false;
+                m_is_input_presented = false;
             }
 
+            // 事件处理，空闲状态下阻塞等待事件而不是空转；此时逻辑线程空闲，可以安全地修改游戏状态
+            processEvents(state == RunState::Running ? 0 : IDLE_WAIT_TIME);
+
+            // 时间控制
+            auto current_time = clock::now();
+            double delta_time = std::chrono::duration<double>(current_time - last_time).count();
             last_time = current_time;
 
-            // 更新和渲染
-            onUpdate(delta_time);
+            // 运行中每帧渲染；静止画面只在状态变化或窗口需要重绘时渲染；最小化时不渲染
+            const bool need_render = (state == RunState::Running) || (state != RunState::Minimized && m_need_redraw);
+            m_need_redraw = false;
+
+            // 逻辑线程推进本帧并生成渲染命令，同时主线程提交上一帧的渲染命令
+            m_sim_thread.post([this, state, delta_time, need_render]()
+                              { updateFrame(state, delta_time, need_render); });
+
+            if (m_has_frame_ready)
+                presentFrame();
+
+            m_sim_thread.wait();
 
-            SDL_SetRenderDrawColor(m_renderer.get(), 0, 0, 0, 255);
-            SDL_RenderClear(m_renderer.get());
+            // 逻辑线程空闲且上一帧已提交，卸载超出预算的无引用资源
+            ResourceManager::instance()->trim();
 
-            onRender();
+            // 在两次逻辑更新之间替换热重载的配置
+            applyConfigReload();
 
-            SDL_RenderPresent(m_renderer.get());
+            if (m_is_replay_end)
+                break;
+
+            if (need_render)
+            {
+                std::swap(m_render_list_front, m_render_list_back);
+                m_has_frame_ready = true;
+                m_is_input_in_front = m_is_input_pending && m_is_input_ticked && !m_is_input_presented;
+
+                // 静止画面没有下一帧可以重叠，直接提交
+                if (state != RunState::Running)
+                    presentFrame();
+            }
+        }
+
+        m_cpu_usage.switchTo((size_t)m_state_last);
+        logCpuUsage();
+        logLatency();
+        logTileChunkStats();
+        logRetainedStats();
+        logPrimitiveCacheStats();
+        logParticleStats();
+        logResourceStats();
+
+        if (m_replay->isReplaying())
+        {
+            size_t num_mismatch = m_replay->getMismatchCount();
+            SDL_Log("replay finished, %zu mismatched frame(s)", num_mismatch);
+            return num_mismatch == 0 ? 0 : 1;
         }
 
         return 0;
@@ -91,8 +174,19 @@ protected:
         loadConfig();
         createWindowAndRenderer();
 
-        initAssert(ResourceManager::instance()->loadFromFile(m_renderer.get()), u8"资源管理器初始化失败");
-        initAssert(generateTileMapTexture(), u8"瓦片地图纹理生成失败");
+        ResourceManager::instance()->init(m_renderer.get(), (size_t)ConfigManager::instance()->basic_template.resource_cache_size * 1024 * 1024);
+        initAssert(preloadResources(), u8"资源预加载失败");
+        initAssert(initTileMap(), u8"瓦片地图初始化失败");
+        m_camera.setViewport(m_size_screen.x, m_size_screen.y);
+        m_camera.setBounds(ConfigManager::instance()->rect_tile_map);
+        initAssert(EnemyManager::instance()->loadPrototypes(), u8"敌人原型生成失败");
+        initAssert(TowerManager::instance()->loadPrototypes(), u8"防御塔原型生成失败");
+        initAssert(ParticleManager::instance()->init(m_renderer.get()), u8"粒子纹理创建失败");
+
+        m_sim_step = 1.0 / ConfigManager::instance()->basic_template.sim_rate;
+        m_frame_time = 1.0 / ConfigManager::instance()->basic_template.render_rate;
+        m_frame_pacer.setFrameTime(m_frame_time);
+        m_frame_pacer.setMode(ConfigManager::instance()->basic_template.pacing);
 
         m_status_bar.setPosition(15, 15);
 
@@ -118,12 +212,91 @@ private:
 
     std::unique_ptr<SDL_Window, SDLDeleter> m_window;        // 游戏窗口
     std::unique_ptr<SDL_Renderer, SDLDeleter> m_renderer;    // 渲染器
-    std::unique_ptr<SDL_Texture, SDLDeleter> m_tex_tile_map; // 瓦片地图纹理
 
     std::unique_ptr<PlacePanel> m_place_panel;     // 放置塔面板
     std::unique_ptr<UpgradePanel> m_upgrade_panel; // 升级塔面板
     std::unique_ptr<Banner> m_banner;              // 游戏结束弹窗
 
+    ReplayManager *m_replay = ReplayManager::instance(); // 录像管理器
+
+    static constexpr int MAX_STEP_PER_FRAME = 64;        // 单帧最多推进的步数
+    static constexpr double TIME_SCALE_LIST[] = {1, 2, 4, 16, 0}; // 可选时间倍率，0表示最大倍率
+
+    /**
+     * @brief 主循环的运行状态
+     */
+    enum class RunState
+    {
+        Running,    // 正常运行
+        Paused,     // 玩家暂停
+        Background, // 窗口失去焦点，自动暂停
+        Editing,    // 地图编辑模式，暂停游戏逻辑
+        Minimized,  // 窗口最小化，自动暂停且不渲染
+        GameOver,   // 游戏结束，显示结束画面
+        Count
+    };
+
+    static constexpr const char *PATH_GAME_CONFIG = "res/file/config.json";  // 游戏配置文件路径
+    static constexpr const char *PATH_LEVEL_CONFIG = "res/file/level.json";  // 关卡配置文件路径
+    static constexpr int IDLE_WAIT_TIME = 100;                   // 空闲状态下单次等待事件的最长时间(毫秒)
+    static constexpr const char *RUN_STATE_NAME_LIST[] = {"running", "paused", "background", "editing", "minimized", "game over"}; // 运行状态名称
+
+    double m_time_scale = 1;          // 当前时间倍率，0表示最大倍率
+    double m_sim_step = 1.0 / 60.0;   // 游戏逻辑固定步长(秒)
+    double m_frame_time = 1.0 / 60.0; // 目标渲染帧间隔(秒)
+
+    bool m_is_paused = false;                  // 玩家是否暂停
+    bool m_has_focus = true;                   // 窗口是否拥有输入焦点
+    bool m_is_minimized = false;               // 窗口是否最小化
+    bool m_need_redraw = true;                 // 静止画面是否需要重绘
+    RunState m_state_last = RunState::Running; // 上一帧的运行状态
+    CpuUsage m_cpu_usage{(size_t)RunState::Count}; // 各运行状态的CPU占用统计
+
+    using LatencyClock = std::chrono::steady_clock;
+
+    FramePacer m_frame_pacer;                  // 帧率控制器
+    LatencyStats m_latency_tick;               // 输入事件到逻辑更新的延迟
+    LatencyStats m_latency_present;            // 输入事件到画面呈现的延迟
+    bool m_is_input_pending = false;           // 是否有正在测量延迟的输入
+    bool m_is_input_ticked = false;            // 正在测量的输入是否已经过逻辑更新
+    bool m_is_input_in_front = false;          // 正在测量的输入的结果是否已在待呈现的渲染命令中
+    bool m_is_input_presented = false;         // 正在测量的输入的结果是否已呈现，待逻辑线程空闲时结束测量
+    LatencyClock::time_point m_time_input;     // 正在测量的输入事件的产生时刻
+
+    double m_accumulator = 0;                  // 尚未推进的模拟时间(秒)
+    bool m_is_replay_end = false;              // 回放的录像是否已经结束
+    bool m_has_frame_ready = false;            // 是否有尚未呈现的渲染命令
+    SDL_Point m_size_screen = {0, 0};          // 窗口的像素尺寸
+    Camera m_camera;                           // 摄像机，只在主线程处理事件时修改
+
+    /**
+     * @brief 地图编辑画笔
+     */
+    struct EditorBrush
+    {
+        int terrian = 0;                                // 地形类型ID
+        int decoration = -1;                            // 装饰物ID(-1表示无装饰)
+        Tile::Direction direction = Tile::Direction::NONE; // 瓦片朝向
+    };
+
+    bool m_is_editing = false;                 // 是否处于地图编辑模式
+    bool m_is_painting = false;                // 是否按住左键连续绘制
+    EditorBrush m_brush;                       // 当前画笔
+    SDL_Point m_index_tile_hovered = {-1, -1}; // 编辑模式下鼠标悬停的瓦片
+    int m_num_tile_set = 1;                    // 瓦片集中的瓦片数
+    int m_num_tile_set_line = 1;               // 瓦片集每行的瓦片数
+    std::string m_str_editor;                  // 编辑模式提示文本
+
+    RenderList m_render_list_front;            // 主线程正在提交的渲染命令
+    RenderList m_render_list_back;             // 逻辑线程正在生成的渲染命令
+    RenderDevice m_render_device;              // 执行渲染命令的渲染设备
+    TileChunkCache m_tile_chunk_cache;         // 瓦片地图区块缓存，只在主线程中使用
+    TextureHandle m_tex_tile_set;              // 瓦片集纹理，由区块缓存使用
+    TextureHandle m_tex_home;                  // home标记纹理，由区块缓存使用
+    MusicHandle m_music_bgm;                   // 背景音乐
+    WorkerThread m_sim_thread;                 // 逻辑线程
+    ConfigReloader m_config_reloader;          // 配置热重载器
+
 private:
     /** @brief 初始化检查 */
     void initAssert(bool flag, const char *error_message)
@@ -149,12 +322,15 @@ private:
         SDL_SetHint(SDL_HINT_IME_SHOW_UI, "1");
     }
 
-    /** @brief 加载配置文件 */
+    /** @brief 加载配置文件，存在资源包时之后的所有资源优先从资源包加载 */
     void loadConfig()
     {
+        if (!ResourceManager::instance()->openPack("res/pack.bin"))
+            SDL_Log("resource pack not found, loading loose files");
+
         initAssert(ConfigManager::instance()->map.loadMap("res/file/map.csv"), u8"地图加载失败");
-        initAssert(ConfigManager::instance()->loadLevelConfig("res/file/level.json"), u8"关卡配置加载失败");
-        initAssert(ConfigManager::instance()->loadGameConfig("res/file/config.json"), u8"游戏配置加载失败");
+        initAssert(ConfigManager::instance()->loadGameConfig(PATH_GAME_CONFIG), u8"游戏配置加载失败");
+        initAssert(ConfigManager::instance()->loadLevelConfig(PATH_LEVEL_CONFIG), u8"关卡配置加载失败");
     }
 
     /** @brief 创建窗口和渲染器 */
@@ -173,26 +349,710 @@ private:
         m_renderer.reset(SDL_CreateRenderer(
             m_window.get(),
             -1,
-            SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE));
+            SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE |
+                (ConfigManager::instance()->basic_template.pacing == PacingMode::VSync ? SDL_RENDERER_PRESENTVSYNC : 0)));
 
         initAssert(m_renderer.get(), u8"创建渲染器失败");
+
+        m_render_device.setRenderer(m_renderer.get());
+        SDL_GetWindowSizeInPixels(m_window.get(), &m_size_screen.x, &m_size_screen.y);
     }
 
-    /** @brief 处理SDL事件 */
-    void processEvents()
+    /**
+     * @brief 处理SDL事件
+     * @param timeout 没有待处理事件时最多等待的时间(毫秒)，0表示不等待
+     */
+    void processEvents(int timeout)
     {
-        while (SDL_PollEvent(&m_event))
+        bool has_event = (timeout > 0) ? SDL_WaitEventTimeout(&m_event, timeout) : SDL_PollEvent(&m_event);
+        while (has_event)
         {
             switch (m_event.type)
             {
             case SDL_QUIT:
                 m_quit = true;
                 break;
+            case SDL_WINDOWEVENT:
+                processWindowEvent();
+                break;
+            case SDL_KEYDOWN:
+                // 切换时间倍率与暂停，不影响游戏逻辑，因此不录制且回放时同样可用
+                if (m_event.key.keysym.sym >= SDLK_1 && m_event.key.keysym.sym <= SDLK_5)
+                {
+                    m_time_scale = TIME_SCALE_LIST[m_event.key.keysym.sym - SDLK_1];
+                    break;
+                }
+                if (m_event.key.keysym.sym == SDLK_p)
+                {
+                    m_is_paused = !m_is_paused;
+                    break;
+                }
+                if (m_event.key.keysym.sym == SDLK_e)
+                {
+                    toggleEditor();
+                    break;
+                }
+                if (m_event.key.keysym.sym == SDLK_l)
+                {
+                    EnemyManager::instance()->toggleCrowdLOD();
+                    SDL_Log("crowd lod %s", EnemyManager::instance()->isCrowdLOD() ? "on" : "off");
+                    break;
+                }
+                [[fallthrough]];
             default:
+                if (processCameraEvent())
+                    break;
+
+                // 鼠标坐标转换为世界坐标后再录制与处理，录像与摄像机位置无关
+                convertMouseToWorld();
+
+                if (m_is_editing && processEditorEvent())
+                    break;
+
+                // 回放时忽略实时输入，输入来自录像；暂停或编辑时只放行按键抬起，避免按键状态残留
+                if (m_replay->isReplaying() || ((m_is_paused || m_is_editing) && m_event.type != SDL_KEYUP))
+                    break;
+
+                m_replay->recordEvent(m_event);
+                trackInputLatency();
                 onInput();
                 break;
             }
+
+            has_event = SDL_PollEvent(&m_event);
+        }
+    }
+
+    /**
+     * @brief 处理摄像机操作：滚轮缩放、中键拖拽与方向键平移
+     * @return 事件被摄像机消耗返回true
+     * @details 摄像机只影响画面，不录制且回放时同样可用
+     */
+    bool processCameraEvent()
+    {
+        static const double ZOOM_STEP = 1.1;
+        static const double PAN_STEP = TILE_SIZE;
+
+        switch (m_event.type)
+        {
+        case SDL_MOUSEWHEEL:
+            m_camera.zoomAt({(double)m_event.wheel.mouseX, (double)m_event.wheel.mouseY}, std::pow(ZOOM_STEP, m_event.wheel.preciseY));
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            if (m_event.button.button != SDL_BUTTON_MIDDLE)
+                return false;
+            break;
+        case SDL_MOUSEMOTION:
+            if (!(m_event.motion.state & SDL_BUTTON_MMASK))
+                return false;
+            m_camera.pan({(double)m_event.motion.xrel, (double)m_event.motion.yrel});
+            break;
+        case SDL_KEYDOWN:
+            switch (m_event.key.keysym.sym)
+            {
+            case SDLK_LEFT:
+                m_camera.pan({PAN_STEP, 0});
+                break;
+            case SDLK_RIGHT:
+                m_camera.pan({-PAN_STEP, 0});
+                break;
+            case SDLK_UP:
+                m_camera.pan({0, PAN_STEP});
+                break;
+            case SDLK_DOWN:
+                m_camera.pan({0, -PAN_STEP});
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+
+        m_need_redraw = true;
+        return true;
+    }
+
+    /** @brief 将当前鼠标事件中的屏幕坐标转换为世界坐标 */
+    void convertMouseToWorld()
+    {
+        switch (m_event.type)
+        {
+        case SDL_MOUSEMOTION:
+        {
+            const Vector2 position = m_camera.screenToWorld({(double)m_event.motion.x, (double)m_event.motion.y});
+            m_event.motion.x = (int)std::floor(position.x);
+            m_event.motion.y = (int)std::floor(position.y);
+        }
+        break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        {
+            const Vector2 position = m_camera.screenToWorld({(double)m_event.button.x, (double)m_event.button.y});
+            m_event.button.x = (int)std::floor(position.x);
+            m_event.button.y = (int)std::floor(position.y);
+        }
+        break;
+        default:
+            break;
+        }
+    }
+
+    /**
+     * @brief 进入或退出地图编辑模式
+     * @details 编辑不会被录制，因此录制或回放时不可编辑
+     */
+    void toggleEditor()
+    {
+        if (m_replay->getMode() != ReplayManager::Mode::None)
+        {
+            SDL_Log("map editor is unavailable while recording or replaying");
+            return;
+        }
+
+        m_is_editing = !m_is_editing;
+        m_is_painting = false;
+        m_need_redraw = true;
+        SDL_Log("map editor %s", m_is_editing ? "on" : "off");
+    }
+
+    /**
+     * @brief 处理编辑模式下的输入
+     * @return 事件被编辑器消耗返回true
+     * @details 左键绘制画笔，右键从瓦片吸取画笔；
+     *          [ ]切换地形，- =切换装饰，R切换方向，Ctrl+S保存地图
+     */
+    bool processEditorEvent()
+    {
+        static const char *MAP_PATH = "res/file/map.csv";
+        SDL_Point index_tile;
+
+        switch (m_event.type)
+        {
+        case SDL_MOUSEMOTION:
+            m_index_tile_hovered = getCursorIndexTile(index_tile, m_event.motion.x, m_event.motion.y) ? index_tile : SDL_Point{-1, -1};
+            m_need_redraw = true;
+            if (m_is_painting && m_index_tile_hovered.x >= 0)
+                paintTile(m_index_tile_hovered);
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+            if (!getCursorIndexTile(index_tile, m_event.button.x, m_event.button.y))
+                break;
+
+            if (m_event.button.button == SDL_BUTTON_LEFT)
+            {
+                m_is_painting = true;
+                paintTile(index_tile);
+            }
+            else if (m_event.button.button == SDL_BUTTON_RIGHT)
+            {
+                const Tile &tile = ConfigManager::instance()->map.getTileMap()[index_tile.y][index_tile.x];
+                m_brush = {tile.terrian, tile.decoration, tile.direction};
+                m_need_redraw = true;
+            }
+            break;
+        case SDL_MOUSEBUTTONUP:
+            if (m_event.button.button == SDL_BUTTON_LEFT)
+                m_is_painting = false;
+            break;
+        case SDL_KEYDOWN:
+            switch (m_event.key.keysym.sym)
+            {
+            case SDLK_LEFTBRACKET:
+                m_brush.terrian = (m_brush.terrian + m_num_tile_set - 1) % m_num_tile_set;
+                break;
+            case SDLK_RIGHTBRACKET:
+                m_brush.terrian = (m_brush.terrian + 1) % m_num_tile_set;
+                break;
+            case SDLK_MINUS:
+                m_brush.decoration = (m_brush.decoration + m_num_tile_set + 1) % (m_num_tile_set + 1) - 1;
+                break;
+            case SDLK_EQUALS:
+                m_brush.decoration = (m_brush.decoration + 2) % (m_num_tile_set + 1) - 1;
+                break;
+            case SDLK_r:
+                m_brush.direction = (Tile::Direction)(((int)m_brush.direction + 1) % ((int)Tile::Direction::RIGHT + 1));
+                break;
+            case SDLK_s:
+                if (!(m_event.key.keysym.mod & KMOD_CTRL))
+                    return false;
+                if (ConfigManager::instance()->map.saveMap(MAP_PATH))
+                    SDL_Log("map saved to %s", MAP_PATH);
+                else
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, u8"地图保存失败: %s", MAP_PATH);
+                break;
+            default:
+                return false;
+            }
+            m_need_redraw = true;
+            break;
+        default:
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief 用画笔修改瓦片，只重绘该瓦片并重新计算受影响的路径
+     * @param index_tile 瓦片坐标
+     */
+    void paintTile(const SDL_Point &index_tile)
+    {
+        auto &map = ConfigManager::instance()->map;
+        const Tile &tile = map.getTileMap()[index_tile.y][index_tile.x];
+        if (tile.terrian == m_brush.terrian && tile.decoration == m_brush.decoration && tile.direction == m_brush.direction)
+            return;
+
+        const size_t num_route = map.setTile(index_tile, m_brush.terrian, m_brush.decoration, m_brush.direction);
+        if (num_route > 0)
+        {
+            EnemyManager::instance()->remapRoutes();
+            SDL_Log("%zu route(s) recomputed", num_route);
+        }
+
+        m_tile_chunk_cache.invalidateTile(index_tile);
+        m_need_redraw = true;
+    }
+
+    /**
+     * @brief 生成编辑模式的渲染命令：悬停瓦片边框与画笔预览
+     * @param render_list 渲染命令列表
+     */
+    void onRenderEditor(RenderList &render_list)
+    {
+        static const char *DIRECTION_NAME_LIST[] = {"none", "up", "down", "left", "right"};
+        static const SDL_Color color_frame = {255, 255, 255, 255};
+        static const SDL_Color color_background = {0, 0, 0, 160};
+        static const TextureHandle tex_tile_set = ResourceManager::instance()->acquireTexture(ResID::Tex_TileSet);
+        static const FontHandle font = ResourceManager::instance()->acquireFont(ResID::Font_Main);
+        static const auto &rect_tile_map = ConfigManager::instance()->rect_tile_map;
+
+        if (m_index_tile_hovered.x >= 0)
+        {
+            render_list.setLayer(RenderLayer::Overlay);
+            render_list.drawRect({rect_tile_map.x + m_index_tile_hovered.x * TILE_SIZE,
+                                  rect_tile_map.y + m_index_tile_hovered.y * TILE_SIZE, TILE_SIZE, TILE_SIZE},
+                                 color_frame);
+        }
+
+        render_list.setLayer(RenderLayer::UI);
+
+        const SDL_Rect rect_brush = {10, m_size_screen.y - TILE_SIZE - 10, TILE_SIZE, TILE_SIZE};
+        render_list.fillRect({0, rect_brush.y - 10, m_size_screen.x, TILE_SIZE + 20}, color_background);
+
+        SDL_Rect rect_src = getTileSetRect(m_brush.terrian);
+        render_list.drawTexture(tex_tile_set, &rect_src, rect_brush);
+        if (m_brush.decoration >= 0)
+        {
+            rect_src = getTileSetRect(m_brush.decoration);
+            render_list.drawTexture(tex_tile_set, &rect_src, rect_brush);
+        }
+        render_list.drawRect(rect_brush, color_frame);
+
+        m_str_editor = "EDIT  terrain " + std::to_string(m_brush.terrian) +
+                       "  decoration " + std::to_string(m_brush.decoration) +
+                       "  direction " + DIRECTION_NAME_LIST[(int)m_brush.direction] +
+                       "    [ ] - = R  Ctrl+S save";
+        render_list.drawText(font, m_str_editor, color_frame,
+                             {rect_brush.x + rect_brush.w + 10, rect_brush.y + (TILE_SIZE - TTF_FontHeight(font)) / 2});
+    }
+
+    /** @brief 瓦片集中指定编号瓦片的源矩形 */
+    SDL_Rect getTileSetRect(int index) const
+    {
+        const int num_tile_single_line = std::max(m_num_tile_set_line, 1);
+        return {(index % num_tile_single_line) * TILE_SIZE, (index / num_tile_single_line) * TILE_SIZE, TILE_SIZE, TILE_SIZE};
+    }
+
+    /** @brief 处理窗口事件：焦点、最小化与重绘请求 */
+    void processWindowEvent()
+    {
+        switch (m_event.window.event)
+        {
+        case SDL_WINDOWEVENT_FOCUS_GAINED:
+            m_has_focus = true;
+            break;
+        case SDL_WINDOWEVENT_FOCUS_LOST:
+            m_has_focus = false;
+            break;
+        case SDL_WINDOWEVENT_MINIMIZED:
+            m_is_minimized = true;
+            break;
+        case SDL_WINDOWEVENT_RESTORED:
+        case SDL_WINDOWEVENT_MAXIMIZED:
+            m_is_minimized = false;
+            m_need_redraw = true;
+            break;
+        case SDL_WINDOWEVENT_EXPOSED:
+            m_need_redraw = true;
+            break;
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+            SDL_GetWindowSizeInPixels(m_window.get(), &m_size_screen.x, &m_size_screen.y);
+            m_camera.setViewport(m_size_screen.x, m_size_screen.y);
+            m_need_redraw = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    /** @brief 获取主循环当前的运行状态 */
+    RunState getRunState() const
+    {
+        if (m_is_minimized)
+            return RunState::Minimized;
+        if (!m_has_focus)
+            return RunState::Background;
+        if (m_is_editing)
+            return RunState::Editing;
+        if (m_is_paused)
+            return RunState::Paused;
+        if (ConfigManager::instance()->is_game_over)
+            return RunState::GameOver;
+
+        return RunState::Running;
+    }
+
+    /** @brief 指定运行状态下模拟时钟是否停止 */
+    static bool isSimulationHalted(RunState state)
+    {
+        return state == RunState::Paused || state == RunState::Background || state == RunState::Editing || state == RunState::Minimized;
+    }
+
+    /**
+     * @brief 推进一帧的游戏逻辑并生成渲染命令，在逻辑线程中执行
+     * @param state 本帧的运行状态
+     * @param delta_time 距上一帧的时间(秒)
+     * @param need_render 是否需要生成本帧的渲染命令
+     */
+    void updateFrame(RunState state, double delta_time, bool need_render)
+    {
+        using clock = std::chrono::high_resolution_clock;
+        const auto time_begin = clock::now();
+
+        if (isSimulationHalted(state))
+        {
+            // 暂停、失去焦点或最小化时模拟时钟停止
+            m_accumulator = 0;
+        }
+        else if (m_time_scale > 0)
+        {
+            // 按时间倍率以固定步长推进游戏逻辑
+            m_accumulator += delta_time * m_time_scale;
+            for (int i = 0; m_accumulator >= m_sim_step && !m_quit; i++)
+            {
+                // 单帧步数超限时丢弃积压的时间，避免越落越多
+                if (i >= MAX_STEP_PER_FRAME)
+                {
+                    m_accumulator = 0;
+                    break;
+                }
+
+                m_accumulator -= m_sim_step;
+                if (!stepSimulation())
+                {
+                    m_is_replay_end = true;
+                    return;
+                }
+            }
+        }
+        else
+        {
+            // 最大倍率：在一帧的时间预算内尽可能多地推进
+            do
+            {
+                if (!stepSimulation())
+                {
+                    m_is_replay_end = true;
+                    return;
+                }
+            } while (!m_quit && std::chrono::duration<double>(clock::now() - time_begin).count() < m_frame_time);
+
+            m_accumulator = 0;
+        }
+
+        if (!need_render)
+            return;
+
+        // 最大倍率下直接渲染最新状态
+        m_render_list_back.clear();
+        m_render_list_back.setCamera(m_camera);
+        onRender(m_render_list_back, m_time_scale > 0 ? std::min(m_accumulator / m_sim_step, 1.0) : 1.0);
+
+        // 暂停时在画面上覆盖半透明遮罩
+        if (state == RunState::Paused || state == RunState::Background)
+            m_render_list_back.fillRect({0, 0, m_size_screen.x, m_size_screen.y}, {0, 0, 0, 128});
+
+        // 按层与脚底位置排序，排序在逻辑线程中完成
+        m_render_list_back.sort();
+    }
+
+    /**
+     * @brief 在主线程中执行已生成的渲染命令并呈现画面
+     * @details 可能与逻辑线程并行执行，因此不修改逻辑线程会读写的输入测量状态
+     */
+    void presentFrame()
+    {
+        m_render_device.prepare(m_render_list_front);
+
+        SDL_SetRenderDrawColor(m_renderer.get(), 0, 0, 0, 255);
+        SDL_RenderClear(m_renderer.get());
+
+        m_render_device.execute(m_render_list_front);
+
+        SDL_RenderPresent(m_renderer.get());
+        m_has_frame_ready = false;
+
+        // 输入的结果已经过逻辑更新并呈现到画面上
+        if (m_is_input_in_front)
+        {
+            m_latency_present.add(std::chrono::duration<double>(LatencyClock::now() - m_time_input).count());
+            m_is_input_in_front = false;
+            m_is_input_presented = true;
+        }
+    }
+
+    /**
+     * @brief 开始测量一个输入事件的延迟
+     * @details 只测量按键与鼠标按下，且同一时间只跟踪一个输入。
+     *          事件的产生时刻由SDL的毫秒时间戳折算到高精度时钟
+     */
+    void trackInputLatency()
+    {
+        if (m_is_input_pending || (m_event.type != SDL_KEYDOWN && m_event.type != SDL_MOUSEBUTTONDOWN))
+            return;
+
+        const Uint32 age = SDL_GetTicks() - m_event.common.timestamp;
+        m_time_input = LatencyClock::now() - std::chrono::milliseconds(age);
+        m_is_input_pending = true;
+        m_is_input_ticked = false;
+    }
+
+    /** @brief 输出输入延迟的百分位数 */
+    void logLatency() const
+    {
+        auto logStats = [](const char *name, const LatencyStats &stats)
+        {
+            if (stats.getCount() == 0)
+                return;
+
+            SDL_Log("latency [%s]: p50 %.2fms, p90 %.2fms, p99 %.2fms, max %.2fms (%zu samples)", name,
+                    stats.getPercentile(50) * 1000, stats.getPercentile(90) * 1000,
+                    stats.getPercentile(99) * 1000, stats.getPercentile(100) * 1000, stats.getCount());
+        };
+
+        logStats("input to tick", m_latency_tick);
+        logStats("input to present", m_latency_present);
+    }
+
+    /** @brief 输出瓦片地图区块缓存的统计 */
+    void logTileChunkStats() const
+    {
+        const auto &stats = m_tile_chunk_cache.getStats();
+        const double mb = 1024.0 * 1024.0;
+
+        SDL_Log("tile chunks: %zu/%d resident, %.1fMB (peak %.1fMB, budget %.1fMB), %zu baked, %zu evicted, %zu tile(s) rebaked",
+                stats.num_resident, m_tile_chunk_cache.getChunkCountX() * m_tile_chunk_cache.getChunkCountY(),
+                stats.size_resident / mb, stats.size_peak / mb, m_tile_chunk_cache.getBudget() / mb,
+                stats.num_bake, stats.num_evict, stats.num_rebake_tile);
+    }
+
+    /** @brief 输出保留层界面的重绘次数与失效原因 */
+    void logRetainedStats() const
+    {
+        SDL_Log("ui [status bar]: %zu redraw(s), invalidated by hp %zu, coin %zu, mp %zu",
+                m_render_device.getRetainedRedrawCount(RetainedID::StatusBar),
+                m_status_bar.getInvalidateCountHP(), m_status_bar.getInvalidateCountCoin(), m_status_bar.getInvalidateCountMP());
+    }
+
+    /** @brief 输出预光栅化图元缓存的统计 */
+    void logPrimitiveCacheStats() const
+    {
+        const auto &stats = m_render_device.getPrimitiveCacheStats();
+
+        SDL_Log("primitives: %zu resident, %.1fMB, %zu hit(s), %zu rasterized, %zu evicted",
+                stats.num_resident, stats.size_resident / (1024.0 * 1024.0), stats.num_hit, stats.num_miss, stats.num_evict);
+    }
+
+    /** @brief 输出资源的驻留大小、加载与卸载次数以及首次使用停顿 */
+    void logResourceStats() const
+    {
+        const auto *resource = ResourceManager::instance();
+        const auto &stats = resource->getStats();
+        const double mb = 1024.0 * 1024.0;
+
+        SDL_Log("resources: %zu resident, %.1fMB (peak %.1fMB, budget %.1fMB), %zu loaded, %zu unloaded",
+                stats.num_resident, stats.size_resident / mb, stats.size_peak / mb, resource->getBudget() / mb,
+                stats.num_load, stats.num_unload);
+        SDL_Log("resources: %zu loaded on first use, stalled %.2fms in total, %.2fms at most (%s)",
+                stats.num_lazy_load, stats.time_stall_total, stats.time_stall_max, ResourceManager::getName(stats.id_stall_max));
+    }
+
+    /** @brief 输出粒子系统的统计 */
+    void logParticleStats() const
+    {
+        const auto &stats = ParticleManager::instance()->getStats();
+
+        SDL_Log("particles: peak %zu/%zu, %zu spawned, %zu dropped by budget, %zu floating text(s) dropped",
+                stats.num_peak, ParticleManager::getCapacity(), stats.num_spawn, stats.num_drop, stats.num_text_drop);
+    }
+
+    /** @brief 输出各运行状态的CPU占用率 */
+    void logCpuUsage() const
+    {
+        for (size_t i = 0; i < (size_t)RunState::Count; i++)
+        {
+            if (m_cpu_usage.getWallTime(i) <= 0)
+                continue;
+
+            SDL_Log("cpu usage [%s]: %.1f%% over %.1fs", RUN_STATE_NAME_LIST[i],
+                    m_cpu_usage.getUsage(i) * 100, m_cpu_usage.getWallTime(i));
+        }
+    }
+
+    /**
+     * @brief 解析命令行参数
+     * @return 参数有效返回true，否则返回false
+     */
+    bool parseArguments(int argc, char **argv)
+    {
+        bool is_watch = false;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg == "--watch")
+            {
+                is_watch = true;
+                continue;
+            }
+
+            // 其余参数都带有一个值
+            if (i + 1 >= argc)
+                break;
+
+            if (arg == "--record")
+            {
+                if (!m_replay->startRecord(argv[++i]))
+                {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to create replay file: %s", argv[i]);
+                    return false;
+                }
+            }
+            else if (arg == "--replay")
+            {
+                if (!m_replay->startReplay(argv[++i]))
+                {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to open replay file: %s", argv[i]);
+                    return false;
+                }
+            }
+            else if (arg == "--pacing")
+            {
+                PacingMode pacing;
+                if (!FramePacer::parseMode(argv[++i], pacing))
+                {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "invalid pacing mode: %s", argv[i]);
+                    return false;
+                }
+
+                m_frame_pacer.setMode(pacing);
+                SDL_RenderSetVSync(m_renderer.get(), pacing == PacingMode::VSync ? 1 : 0);
+            }
+            else if (arg == "--speed")
+            {
+                std::string speed = argv[++i];
+                m_time_scale = (speed == "max") ? 0 : std::atof(speed.c_str());
+                if (m_time_scale < 0 || (m_time_scale == 0 && speed != "max"))
+                {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "invalid time scale: %s", argv[i]);
+                    return false;
+                }
+            }
+        }
+
+        // 热重载会在录像之外改变游戏状态
+        if (is_watch && m_replay->getMode() != ReplayManager::Mode::None)
+            SDL_Log("config watching is disabled while recording or replaying");
+        else if (is_watch && !m_config_reloader.start(PATH_GAME_CONFIG, PATH_LEVEL_CONFIG))
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to watch config files");
+        else if (is_watch)
+            SDL_Log("watching %s and %s for changes", PATH_GAME_CONFIG, PATH_LEVEL_CONFIG);
+
+        return true;
+    }
+
+    /**
+     * @brief 替换后台解析好的配置，并刷新原型与存活对象缓存的属性
+     * @details 在主线程中、逻辑线程空闲时调用；没有待替换的配置时立即返回
+     */
+    void applyConfigReload()
+    {
+        if (!m_config_reloader.poll())
+            return;
+
+        const auto result = m_config_reloader.apply();
+
+        if (result.is_game_reloaded)
+        {
+            if (!TowerManager::instance()->reloadPrototypes())
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to rebake tower archetypes, keeping the previous ones");
+            PlayerManager::instance()->refreshTemplate();
+        }
+
+        // 关卡变化可能引入新的敌人类型
+        if (!EnemyManager::instance()->reloadPrototypes())
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to rebake enemy archetypes, keeping the previous ones");
+
+        if (result.is_level_reloaded)
+            WaveManager::instance()->onLevelReloaded();
+
+        m_need_redraw = true;
+    }
+
+    /**
+     * @brief 以固定步长推进一步游戏逻辑
+     * @return 回放的录像结束返回false
+     * @details 回放时以录制的步长和输入驱动游戏
+     */
+    bool stepSimulation()
+    {
+        double delta_time = m_sim_step;
+        if (m_replay->isReplaying() && !processReplayFrame(delta_time))
+            return false;
+
+        onUpdate(delta_time);
+        m_replay->endFrame(delta_time);
+
+        if (m_is_input_pending && !m_is_input_ticked)
+        {
+            m_latency_tick.add(std::chrono::duration<double>(LatencyClock::now() - m_time_input).count());
+            m_is_input_ticked = true;
         }
+
+        return true;
+    }
+
+    /**
+     * @brief 读取并应用录像中的一帧
+     * @param delta_time 输出参数，录制时的帧间隔
+     * @return 录像结束返回false
+     */
+    bool processReplayFrame(double &delta_time)
+    {
+        const auto *event_list = m_replay->readFrame(delta_time);
+        if (!event_list)
+            return false;
+
+        for (const SDL_Event &event : *event_list)
+        {
+            m_event = event;
+            onInput();
+        }
+
+        return true;
     }
 
     /** @brief 处理输入 */
@@ -249,25 +1109,27 @@ private:
 
         if (!config->is_game_over)
         {
-            m_place_panel->onUpdate(m_renderer.get());
-            m_upgrade_panel->onUpdate(m_renderer.get());
-            m_status_bar.onUpdate(m_renderer.get());
+            m_place_panel->onUpdate();
+            m_upgrade_panel->onUpdate();
+            m_status_bar.onUpdate();
             WaveManager::instance()->onUpdate(delta_time);
             EnemyManager::instance()->onUpdate(delta_time);
             PlayerManager::instance()->onUpdate(delta_time);
             BulletManager::instance()->onUpdate(delta_time);
             TowerManager::instance()->onUpdate(delta_time);
             CoinManager::instance()->onUpdate(delta_time);
+            ParticleManager::instance()->onUpdate(delta_time);
 
             return;
         }
 
         if (!is_game_over_last && config->is_game_over)
         {
-            static const auto &sound_pool = ResourceManager::instance()->getSoundPool();
+            // 胜负音效只播放一次，在此时才加载
+            static const SoundHandle sound_end = ResourceManager::instance()->acquireSound(config->is_game_win ? ResID::Sound_Win : ResID::Sound_Loss);
 
             Mix_FadeOutMusic(1500);
-            Mix_PlayChannel(-1, sound_pool.find(config->is_game_win ? ResID::Sound_Win : ResID::Sound_Loss)->second, 0);
+            Mix_PlayChannel(-1, sound_end, 0);
         }
 
         is_game_over_last = config->is_game_over;
@@ -277,183 +1139,171 @@ private:
             m_quit = true;
     }
 
-    /** @brief 渲染游戏画面 */
-    void onRender()
+    /**
+     * @brief 生成游戏画面的渲染命令
+     * @details 各对象按所在渲染层与脚底位置排序，追加顺序不影响遮挡关系；
+     *          除界面外均使用世界坐标，由渲染命令列表按摄像机变换并剔除
+     * @param render_list 渲染命令列表
+     * @param alpha 插值系数，渲染时刻在上次与本次逻辑更新之间的位置(0~1)
+     */
+    void onRender(RenderList &render_list, double alpha)
     {
         static auto *config = ConfigManager::instance();
-        static SDL_Rect &rect_dst = config->rect_tile_map;
-        SDL_RenderCopy(m_renderer.get(), m_tex_tile_map.get(), nullptr, &rect_dst);
-
-        EnemyManager::instance()->onRender(m_renderer.get());
-        BulletManager::instance()->onRender(m_renderer.get());
-        TowerManager::instance()->onRender(m_renderer.get());
-        CoinManager::instance()->onRender(m_renderer.get());
-        PlayerManager::instance()->onRender(m_renderer.get());
+        static SDL_Rect &rect_tile_map = config->rect_tile_map;
 
-        if (!config->is_game_over)
+        // 只绘制可见的地图区块，绘制开销与地图尺寸无关
+        const SDL_Rect rect_view = m_camera.getViewRect();
+        SDL_Rect rect_visible;
+        if (SDL_IntersectRect(&rect_view, &rect_tile_map, &rect_visible))
         {
-            m_place_panel->onRender(m_renderer.get());
-            m_upgrade_panel->onRender(m_renderer.get());
-            m_status_bar.onRender(m_renderer.get());
-
-            return;
-        }
-
-        int width_screen, height_screen;
-        SDL_GetWindowSizeInPixels(m_window.get(), &width_screen, &height_screen);
-        m_banner->setCenterPosition({(double)width_screen / 2, (double)height_screen / 2});
-        m_banner->onRender(m_renderer.get());
-    }
-
-    /** @brief 生成瓦片地图纹理 */
-    bool generateTileMapTexture()
-    {
-        try
-        {
-            // 获取必要的资源和配置
-            const auto &config = ConfigManager::instance();
-            const auto &map = config->map;
-            const auto &tile_map = map.getTileMap();
-            auto &rect_tile_map = config->rect_tile_map;
-
-            // 获取tile set纹理
-            auto tex_tile_set = ResourceManager::instance()->getTexturePool().find(ResID::Tex_TileSet);
-            if (tex_tile_set == ResourceManager::instance()->getTexturePool().end())
+            static const int CHUNK_PIXEL_SIZE = TileChunkCache::CHUNK_SIZE * TILE_SIZE;
+            const int num_chunk_x = m_tile_chunk_cache.getChunkCountX();
+            const int index_x_begin = (rect_visible.x - rect_tile_map.x) / CHUNK_PIXEL_SIZE;
+            const int index_y_begin = (rect_visible.y - rect_tile_map.y) / CHUNK_PIXEL_SIZE;
+            const int index_x_end = std::min((rect_visible.x + rect_visible.w - rect_tile_map.x - 1) / CHUNK_PIXEL_SIZE + 1, num_chunk_x);
+            const int index_y_end = std::min((rect_visible.y + rect_visible.h - rect_tile_map.y - 1) / CHUNK_PIXEL_SIZE + 1, m_tile_chunk_cache.getChunkCountY());
+
+            render_list.setLayer(RenderLayer::Map);
+            for (int y = index_y_begin; y < index_y_end; y++)
             {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, u8"获取tile set纹理失败");
-                return false;
+                for (int x = index_x_begin; x < index_x_end; x++)
+                {
+                    SDL_Rect rect_dst = m_tile_chunk_cache.getChunkRect(x, y);
+                    rect_dst.x += rect_tile_map.x;
+                    rect_dst.y += rect_tile_map.y;
+                    render_list.drawTileChunk((uint32_t)(y * num_chunk_x + x), rect_dst);
+                }
             }
+        }
 
-            // 查询tile set尺寸
-            int tile_set_width, tile_set_height;
-            if (SDL_QueryTexture(tex_tile_set->second, nullptr, nullptr, &tile_set_width, &tile_set_height) < 0)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"查询tile set尺寸: %s", SDL_GetError());
-                return false;
-            }
+        EnemyManager::instance()->onRender(render_list, alpha);
+        BulletManager::instance()->onRender(render_list, alpha);
+        TowerManager::instance()->onRender(render_list);
+        CoinManager::instance()->onRender(render_list, alpha);
+        PlayerManager::instance()->onRender(render_list, alpha);
+        ParticleManager::instance()->onRender(render_list, alpha);
 
-            // 计算尺寸
-            const int num_tile_single_line = static_cast<int>(std::ceil(static_cast<double>(tile_set_width) / TILE_SIZE));
-            const int tile_map_width = static_cast<int>(map.getWidth()) * TILE_SIZE;
-            const int tile_map_height = static_cast<int>(map.getHeight()) * TILE_SIZE;
+        if (!config->is_game_over)
+        {
+            // 面板跟随所选瓦片，位于世界坐标中
+            render_list.setLayer(RenderLayer::Overlay);
+            m_place_panel->onRender(render_list);
+            m_upgrade_panel->onRender(render_list);
 
-            // 创建tile map纹理
-            m_tex_tile_map.reset(SDL_CreateTexture(
-                m_renderer.get(),
-                SDL_PIXELFORMAT_ARGB8888,
-                SDL_TEXTUREACCESS_TARGET,
-                tile_map_width,
-                tile_map_height));
+            // 界面层使用屏幕坐标并保持追加顺序
+            render_list.setLayer(RenderLayer::UI);
+            m_status_bar.onRender(render_list);
 
-            if (!m_tex_tile_map)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"创建tile map纹理: %s", SDL_GetError());
-                return false;
-            }
+            if (m_is_editing)
+                onRenderEditor(render_list);
 
-            // 设置纹理位置
-            const auto &basic_template = config->basic_template;
-            rect_tile_map = {
-                (basic_template.window_width - tile_map_width) / 2,
-                (basic_template.window_height - tile_map_height) / 2,
-                tile_map_width,
-                tile_map_height};
+            return;
+        }
 
-            // 设置混合模式
-            if (SDL_SetTextureBlendMode(m_tex_tile_map.get(), SDL_BLENDMODE_BLEND) < 0)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"设置混合模式失败: %s", SDL_GetError());
-                return false;
-            }
+        if (m_is_editing)
+            onRenderEditor(render_list);
 
-            // 设置渲染目标
-            if (SDL_SetRenderTarget(m_renderer.get(), m_tex_tile_map.get()) < 0)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"设置渲染目标失败: %s", SDL_GetError());
-                return false;
-            }
+        render_list.setLayer(RenderLayer::UI);
+        m_banner->setCenterPosition({(double)m_size_screen.x / 2, (double)m_size_screen.y / 2});
+        m_banner->onRender(render_list);
+    }
 
-            // 渲染tile map
-            SDL_Rect rect_src, rect_dst;
-            for (int y = 0; y < map.getHeight(); ++y)
-            {
-                for (int x = 0; x < map.getWidth(); ++x)
-                {
-                    const auto &tile = tile_map[y][x];
-
-                    // 设置目标矩形(在循环外计算不变的部分)
-                    rect_dst = {
-                        x * TILE_SIZE,
-                        y * TILE_SIZE,
-                        TILE_SIZE,
-                        TILE_SIZE};
-
-                    // 渲染地形
-                    rect_src = {
-                        (tile.terrian % num_tile_single_line) * TILE_SIZE,
-                        (tile.terrian / num_tile_single_line) * TILE_SIZE,
-                        TILE_SIZE,
-                        TILE_SIZE};
-
-                    if (SDL_RenderCopy(m_renderer.get(), tex_tile_set->second, &rect_src, &rect_dst) < 0)
-                    {
-                        SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"渲染地形失败: %s", SDL_GetError());
-                        return false;
-                    }
-
-                    // 渲染装饰
-                    if (tile.decoration >= 0)
-                    {
-                        rect_src = {
-                            (tile.decoration % num_tile_single_line) * TILE_SIZE,
-                            (tile.decoration / num_tile_single_line) * TILE_SIZE,
-                            TILE_SIZE,
-                            TILE_SIZE};
-
-                        if (SDL_RenderCopy(m_renderer.get(), tex_tile_set->second, &rect_src, &rect_dst) < 0)
-                        {
-                            SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"渲染装饰失败: %s", SDL_GetError());
-                            return false;
-                        }
-                    }
-                }
-            }
+    /**
+     * @brief 预加载资源
+     * @details 逻辑线程中首次使用的纹理无法在逻辑线程中加载，必须在此预加载；
+     *          此外预加载关卡中出现的敌人与所有防御塔的精灵图和开火音效，避免开局后的首次使用停顿。
+     *          开始菜单、关卡中没有出现的敌人与胜负音效不预加载，在首次使用时才加载
+     */
+    bool preloadResources()
+    {
+        static const ResID core_list[] = {
+            ResID::Tex_TileSet, ResID::Tex_Home, ResID::Tex_Player, ResID::Tex_Coin,
+            ResID::Tex_BulletArrow, ResID::Tex_BulletAxe, ResID::Tex_BulletShell,
+            ResID::Tex_EffectFlash_Up, ResID::Tex_EffectFlash_Down, ResID::Tex_EffectFlash_Left, ResID::Tex_EffectFlash_Right,
+            ResID::Tex_EffectImpact_Up, ResID::Tex_EffectImpact_Down, ResID::Tex_EffectImpact_Left, ResID::Tex_EffectImpact_Right,
+            ResID::Tex_EffectExplode,
+            ResID::Tex_UIHomeAvatar, ResID::Tex_UIPlayerAvatar, ResID::Tex_UIHeart, ResID::Tex_UICoin,
+            ResID::Sound_ArrowHit_1, ResID::Sound_ArrowHit_2, ResID::Sound_ArrowHit_3,
+            ResID::Sound_AxeHit_1, ResID::Sound_AxeHit_2, ResID::Sound_AxeHit_3, ResID::Sound_ShellHit,
+            ResID::Sound_Flash, ResID::Sound_Impact, ResID::Sound_Coin, ResID::Sound_HomeHurt,
+            ResID::Sound_PlaceTower, ResID::Sound_TowerLevelUp,
+            ResID::Font_Main};
+
+        auto *config = ConfigManager::instance();
+        std::vector<ResID> id_list(std::begin(core_list), std::end(core_list));
+
+        // 名称无效的资源由原型烘焙时报告
+        auto append = [&id_list](const std::string &name)
+        {
+            ResID id;
+            if (ResourceManager::findResID(name, id))
+                id_list.push_back(id);
+        };
 
-            // 渲染home标记
-            const auto &index_home = map.getIndexHome();
-            rect_dst = {
-                index_home.x * TILE_SIZE,
-                index_home.y * TILE_SIZE,
-                TILE_SIZE,
-                TILE_SIZE};
+        const auto is_used_list = config->collectLevelEnemyTypes();
+        for (size_t i = 0; i < is_used_list.size(); i++)
+        {
+            if (is_used_list[i])
+                append(config->enemy_template_list[i].anim.texture);
+        }
 
-            auto tex_home = ResourceManager::instance()->getTexturePool().find(ResID::Tex_Home);
-            if (tex_home == ResourceManager::instance()->getTexturePool().end())
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, u8"获取home标记失败");
-                return false;
-            }
+        for (const auto &tmpl : config->tower_template_list)
+        {
+            append(tmpl.anim_idle.texture);
+            append(tmpl.anim_fire.texture);
+            for (const auto &name : tmpl.fire_sound_list)
+                append(name);
+        }
 
-            if (SDL_RenderCopy(m_renderer.get(), tex_home->second, nullptr, &rect_dst) < 0)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"渲染home标记失败: %s", SDL_GetError());
-                return false;
-            }
+        return ResourceManager::instance()->preload(id_list);
+    }
 
-            // 恢复默认渲染目标
-            if (SDL_SetRenderTarget(m_renderer.get(), nullptr) < 0)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"恢复默认渲染目标失败: %s", SDL_GetError());
-                return false;
-            }
+    /** @brief 计算地图区域并初始化瓦片地图区块缓存 */
+    bool initTileMap()
+    {
+        const auto &config = ConfigManager::instance();
+        const auto &map = config->map;
+        auto *resource = ResourceManager::instance();
 
-            return true;
+        // 获取tile set与home标记纹理
+        m_tex_tile_set = resource->acquireTexture(ResID::Tex_TileSet);
+        if (!m_tex_tile_set)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, u8"获取tile set纹理失败");
+            return false;
         }
-        catch (const std::exception &e)
+
+        m_tex_home = resource->acquireTexture(ResID::Tex_Home);
+        if (!m_tex_home)
         {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, u8"生成瓦片地图纹理失败: %s", e.what());
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, u8"获取home标记失败");
             return false;
         }
+
+        // 记录瓦片集尺寸，供编辑器切换画笔
+        int tile_set_width = 0, tile_set_height = 0;
+        SDL_QueryTexture(m_tex_tile_set, nullptr, nullptr, &tile_set_width, &tile_set_height);
+        m_num_tile_set_line = std::max(tile_set_width / TILE_SIZE, 1);
+        m_num_tile_set = std::max(m_num_tile_set_line * (tile_set_height / TILE_SIZE), 1);
+
+        // 设置地图位置，地图在窗口中居中
+        const int tile_map_width = static_cast<int>(map.getWidth()) * TILE_SIZE;
+        const int tile_map_height = static_cast<int>(map.getHeight()) * TILE_SIZE;
+        const auto &basic_template = config->basic_template;
+        config->rect_tile_map = {
+            (basic_template.window_width - tile_map_width) / 2,
+            (basic_template.window_height - tile_map_height) / 2,
+            tile_map_width,
+            tile_map_height};
+
+        // 区块在第一次可见时才烘焙
+        const size_t size_budget = (size_t)basic_template.tile_cache_size * 1024 * 1024;
+        if (!m_tile_chunk_cache.init(m_renderer.get(), &map, m_tex_tile_set, m_tex_home, size_budget))
+            return false;
+
+        m_render_device.setTileChunkCache(&m_tile_chunk_cache);
+
+        return true;
     }
 
     /** @brief 是否在home位置
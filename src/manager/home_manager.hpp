@@ -28,11 +28,11 @@ public:
         num_hp -= damage;
         if (num_hp < 0) num_hp = 0;
 
-        // 获取音效资源池的静态引用
-        static const ResourceManager::SoundPool& sound_pool = ResourceManager::instance()->getSoundPool();
+        // 获取基地受伤音效的静态句柄
+        static const SoundHandle sound_hurt = ResourceManager::instance()->acquireSound(ResID::Sound_HomeHurt);
 
         // 播放基地受伤音效
-        Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_HomeHurt)->second, 0);
+        Mix_PlayChannel(-1, sound_hurt, 0);
     }
 
 protected:
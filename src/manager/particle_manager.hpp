@@ -0,0 +1,373 @@
+﻿#pragma once
+
+#include "manager.hpp"
+#include "resource_manager.hpp"
+#include "../util/vector2.hpp"
+#include "../render/render_list.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 粒子发射器类型
+ */
+enum class EmitterType
+{
+    HitSpark,       // 子弹命中的火花
+    CoinSparkle,    // 金币漂浮时的闪光
+    DeathPuff,      // 敌人死亡的烟尘
+    Count
+};
+
+/**
+ * @brief 粒子管理器类，负责粒子特效与伤害飘字
+ * @details 继承自Manager模板类，使用单例模式实现。
+ *          粒子以结构数组(SoA)形式存放在固定容量的缓冲区中，更新时先以无分支的循环积分速度、位置与寿命，
+ *          便于编译器向量化，再把死亡的粒子与末尾交换移除。
+ *          所有粒子使用同一张纹理，以一个精灵批次提交。
+ *          每次更新可生成的粒子数有上限，缓冲区占用超过一半后按剩余容量的比例减少生成数量，
+ *          密集波次中特效逐渐变稀而不会拖慢帧率。
+ *          粒子只影响画面，使用独立的随机数生成器，不改变游戏逻辑的随机序列
+ */
+class ParticleManager : public Manager<ParticleManager>
+{
+    friend class Manager<ParticleManager>;
+
+public:
+    /**
+     * @brief 粒子统计
+     */
+    struct Stats
+    {
+        size_t num_peak = 0;        // 同时存在的粒子数峰值
+        size_t num_spawn = 0;       // 累计生成的粒子数
+        size_t num_drop = 0;        // 因预算或容量放弃生成的粒子数
+        size_t num_text_drop = 0;   // 因容量放弃生成的飘字数
+    };
+
+public:
+    /**
+     * @brief 创建粒子纹理
+     * @param renderer SDL渲染器
+     * @return 创建成功返回true，否则返回false
+     */
+    bool init(SDL_Renderer* renderer)
+    {
+        static const int SIZE = 16;
+
+        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface(
+            SDL_CreateRGBSurfaceWithFormat(0, SIZE, SIZE, 32, SDL_PIXELFORMAT_ARGB8888), SDL_FreeSurface);
+        if (!surface)
+            return false;
+
+        // 白色圆点，透明度由中心向边缘平滑衰减
+        SDL_LockSurface(surface.get());
+        for (int y = 0; y < SIZE; y++)
+        {
+            Uint32* pixel_list = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+            for (int x = 0; x < SIZE; x++)
+            {
+                const double dx = (x + 0.5) / SIZE * 2 - 1, dy = (y + 0.5) / SIZE * 2 - 1;
+                const double t = std::clamp(1 - std::sqrt(dx * dx + dy * dy), 0.0, 1.0);
+                pixel_list[x] = ((Uint32)std::lround(std::sqrt(t) * 255) << 24) | 0x00FFFFFF;
+            }
+        }
+        SDL_UnlockSurface(surface.get());
+
+        m_texture.reset(SDL_CreateTextureFromSurface(renderer, surface.get()));
+        if (!m_texture)
+            return false;
+
+        SDL_SetTextureBlendMode(m_texture.get(), SDL_BLENDMODE_BLEND);
+        return true;
+    }
+
+    /**
+     * @brief 在指定位置爆发一次粒子
+     * @param type 发射器类型
+     * @param position 发射位置
+     */
+    void emit(EmitterType type, const Vector2& position)
+    {
+        const EmitterPreset& preset = PRESET_LIST[(size_t)type];
+        spawn(preset, position, preset.count);
+    }
+
+    /**
+     * @brief 按发射器的生成速率持续发射粒子
+     * @param type 发射器类型
+     * @param position 发射位置
+     * @param delta_time 帧间隔时间
+     * @param carry 输入输出参数，由发射源保存的不足一个粒子的累计量
+     */
+    void emitOverTime(EmitterType type, const Vector2& position, double delta_time, double& carry)
+    {
+        const EmitterPreset& preset = PRESET_LIST[(size_t)type];
+
+        carry += preset.rate * delta_time;
+        const int count = (int)carry;
+        carry -= count;
+
+        if (count > 0)
+            spawn(preset, position, count);
+    }
+
+    /**
+     * @brief 生成伤害飘字
+     * @param position 生成位置
+     * @param value 显示的数值
+     * @param color 文本颜色
+     */
+    void spawnFloatingText(const Vector2& position, int value, const SDL_Color& color)
+    {
+        if (m_text_count >= MAX_TEXT)
+        {
+            m_stats.num_text_drop++;
+            return;
+        }
+
+        const size_t i = m_text_count++;
+        m_text_x[i] = (float)position.x + randRange(-6, 6);
+        m_text_y[i] = (float)position.y;
+        m_text_age[i] = 0;
+        m_text_value[i] = value;
+        m_text_color[i] = color;
+    }
+
+    /**
+     * @brief 更新所有粒子与飘字
+     * @param delta_time 帧间隔时间
+     */
+    void onUpdate(double delta_time)
+    {
+        const float dt = (float)delta_time;
+        const size_t num = m_count;
+
+        // 积分与老化：各数组独立、无分支，便于向量化
+        float* __restrict vel_x = m_vel_x.data();
+        float* __restrict vel_y = m_vel_y.data();
+        float* __restrict pos_x = m_pos_x.data();
+        float* __restrict pos_y = m_pos_y.data();
+        float* __restrict age = m_age.data();
+        const float* __restrict gravity = m_gravity.data();
+        const float* __restrict damping = m_damping.data();
+        for (size_t i = 0; i < num; i++)
+        {
+            const float factor = std::max(0.0f, 1.0f - damping[i] * dt);
+            vel_x[i] *= factor;
+            vel_y[i] = vel_y[i] * factor + gravity[i] * dt;
+            pos_x[i] += vel_x[i] * dt;
+            pos_y[i] += vel_y[i] * dt;
+            age[i] += dt;
+        }
+
+        // 移除死亡的粒子，与末尾交换，顺序不影响绘制
+        for (size_t i = 0; i < m_count;)
+        {
+            if (m_age[i] < m_life[i])
+            {
+                i++;
+                continue;
+            }
+
+            m_count--;
+            m_pos_x[i] = m_pos_x[m_count];
+            m_pos_y[i] = m_pos_y[m_count];
+            m_vel_x[i] = m_vel_x[m_count];
+            m_vel_y[i] = m_vel_y[m_count];
+            m_age[i] = m_age[m_count];
+            m_life[i] = m_life[m_count];
+            m_size[i] = m_size[m_count];
+            m_gravity[i] = m_gravity[m_count];
+            m_damping[i] = m_damping[m_count];
+            m_color[i] = m_color[m_count];
+        }
+
+        for (size_t i = 0; i < m_text_count;)
+        {
+            m_text_age[i] += dt;
+            m_text_y[i] -= TEXT_RISE_SPEED * dt;
+            if (m_text_age[i] < TEXT_LIFE)
+            {
+                i++;
+                continue;
+            }
+
+            m_text_count--;
+            m_text_x[i] = m_text_x[m_text_count];
+            m_text_y[i] = m_text_y[m_text_count];
+            m_text_age[i] = m_text_age[m_text_count];
+            m_text_value[i] = m_text_value[m_text_count];
+            m_text_color[i] = m_text_color[m_text_count];
+        }
+
+        m_delta_last = dt;
+        m_num_spawn_tick = 0;
+    }
+
+    /**
+     * @brief 渲染所有粒子与飘字
+     * @param render_list 渲染命令列表
+     * @param alpha 插值系数，按速度把粒子外推回上次与本次更新之间的位置
+     */
+    void onRender(RenderList& render_list, double alpha)
+    {
+        static const FontHandle font = ResourceManager::instance()->acquireFont(ResID::Font_Main);
+
+        const float offset_time = ((float)alpha - 1) * m_delta_last;
+
+        render_list.setLayer(RenderLayer::Overlay);
+        if (m_texture && m_count > 0)
+        {
+            render_list.beginSprites(m_texture.get());
+            for (size_t i = 0; i < m_count; i++)
+            {
+                SDL_Color color = m_color[i];
+                color.a = (Uint8)(color.a * (1 - m_age[i] / m_life[i]));
+                render_list.appendSprite(m_pos_x[i] + m_vel_x[i] * offset_time, m_pos_y[i] + m_vel_y[i] * offset_time,
+                    m_size[i], color);
+            }
+            render_list.endSprites();
+        }
+
+        for (size_t i = 0; i < m_text_count; i++)
+        {
+            SDL_Color color = m_text_color[i];
+            color.a = (Uint8)(255 * std::min(1.0f, 2 * (1 - m_text_age[i] / TEXT_LIFE)));
+            const SDL_Point position = { (int)m_text_x[i], (int)(m_text_y[i] - TEXT_RISE_SPEED * offset_time) };
+            render_list.drawText(font, std::to_string(m_text_value[i]), color, position, TextAlign::Center);
+        }
+    }
+
+    size_t getCount() const { return m_count; }         // 当前粒子数
+    const Stats& getStats() const { return m_stats; }   // 粒子统计
+    static constexpr size_t getCapacity() { return MAX_PARTICLE; } // 粒子容量
+
+protected:
+    /**
+     * @brief 构造函数，按固定容量一次性分配所有缓冲区
+     */
+    ParticleManager()
+    {
+        for (auto* list : { &m_pos_x, &m_pos_y, &m_vel_x, &m_vel_y, &m_age, &m_life, &m_size, &m_gravity, &m_damping })
+            list->resize(MAX_PARTICLE);
+        m_color.resize(MAX_PARTICLE);
+
+        for (auto* list : { &m_text_x, &m_text_y, &m_text_age })
+            list->resize(MAX_TEXT);
+        m_text_value.resize(MAX_TEXT);
+        m_text_color.resize(MAX_TEXT);
+    }
+
+    ~ParticleManager() = default;
+
+private:
+    /**
+     * @brief 发射器参数
+     */
+    struct EmitterPreset
+    {
+        int count;                  // 爆发时的粒子数
+        float rate;                 // 持续发射时每秒的粒子数
+        float speed_min, speed_max; // 初速度范围
+        float life_min, life_max;   // 寿命范围(秒)
+        float size_min, size_max;   // 边长范围
+        float gravity;              // 竖直加速度，负值向上
+        float damping;              // 每秒速度衰减比例
+        SDL_Color color;            // 初始颜色，透明度随寿命线性衰减
+    };
+
+    static constexpr EmitterPreset PRESET_LIST[(size_t)EmitterType::Count] = {
+        { 6, 0, 120, 260, 0.15f, 0.3f, 3, 5, 0, 4, { 255, 220, 120, 255 } },       // HitSpark
+        { 1, 6, 10, 30, 0.4f, 0.7f, 2, 4, -20, 1, { 255, 240, 150, 255 } },        // CoinSparkle
+        { 14, 0, 30, 90, 0.4f, 0.8f, 6, 12, -30, 2, { 200, 200, 200, 200 } }       // DeathPuff
+    };
+
+    static constexpr size_t MAX_PARTICLE = 4096;        // 粒子容量
+    static constexpr size_t MAX_SPAWN_PER_TICK = 256;   // 每次更新最多生成的粒子数
+    static constexpr size_t MAX_TEXT = 64;              // 飘字容量
+    static constexpr float TEXT_LIFE = 0.8f;            // 飘字寿命(秒)
+    static constexpr float TEXT_RISE_SPEED = 40;        // 飘字上升速度
+
+    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> m_texture{ nullptr, SDL_DestroyTexture }; // 粒子纹理
+
+    size_t m_count = 0;                 // 当前粒子数
+    std::vector<float> m_pos_x;         // 粒子位置x
+    std::vector<float> m_pos_y;         // 粒子位置y
+    std::vector<float> m_vel_x;         // 粒子速度x
+    std::vector<float> m_vel_y;         // 粒子速度y
+    std::vector<float> m_age;           // 粒子已存在的时间
+    std::vector<float> m_life;          // 粒子寿命
+    std::vector<float> m_size;          // 粒子边长
+    std::vector<float> m_gravity;       // 粒子竖直加速度
+    std::vector<float> m_damping;       // 粒子速度衰减比例
+    std::vector<SDL_Color> m_color;     // 粒子初始颜色
+
+    size_t m_text_count = 0;            // 当前飘字数
+    std::vector<float> m_text_x;        // 飘字位置x
+    std::vector<float> m_text_y;        // 飘字位置y
+    std::vector<float> m_text_age;      // 飘字已存在的时间
+    std::vector<int> m_text_value;      // 飘字数值
+    std::vector<SDL_Color> m_text_color; // 飘字颜色
+
+    float m_delta_last = 0;             // 上次更新的帧间隔
+    size_t m_num_spawn_tick = 0;        // 本次更新已生成的粒子数
+    uint32_t m_seed = 0x9E3779B9u;      // 随机数状态
+    Stats m_stats;                      // 粒子统计
+
+private:
+    /**
+     * @brief 按预算生成粒子
+     * @param preset 发射器参数
+     * @param position 发射位置
+     * @param count 请求生成的粒子数
+     */
+    void spawn(const EmitterPreset& preset, const Vector2& position, int count)
+    {
+        size_t num = std::min({ (size_t)count, MAX_SPAWN_PER_TICK - m_num_spawn_tick, MAX_PARTICLE - m_count });
+
+        // 占用超过一半后按剩余容量的比例减少生成数量
+        if (m_count > MAX_PARTICLE / 2)
+            num = num * (MAX_PARTICLE - m_count) / (MAX_PARTICLE / 2);
+
+        m_stats.num_drop += count - num;
+        m_stats.num_spawn += num;
+        m_num_spawn_tick += num;
+
+        for (size_t n = 0; n < num; n++)
+        {
+            const size_t i = m_count++;
+            const float angle = randRange(0, 6.2831853f);
+            const float speed = randRange(preset.speed_min, preset.speed_max);
+
+            m_pos_x[i] = (float)position.x;
+            m_pos_y[i] = (float)position.y;
+            m_vel_x[i] = std::cos(angle) * speed;
+            m_vel_y[i] = std::sin(angle) * speed;
+            m_age[i] = 0;
+            m_life[i] = randRange(preset.life_min, preset.life_max);
+            m_size[i] = randRange(preset.size_min, preset.size_max);
+            m_gravity[i] = preset.gravity;
+            m_damping[i] = preset.damping;
+            m_color[i] = preset.color;
+        }
+
+        m_stats.num_peak = std::max(m_stats.num_peak, m_count);
+    }
+
+    /**
+     * @brief 生成[min, max)范围内的随机数
+     */
+    float randRange(float min, float max)
+    {
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        return min + (max - min) * (float)(m_seed >> 8) / (float)(1u << 24);
+    }
+};
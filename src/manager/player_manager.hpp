@@ -89,6 +89,8 @@ public:
 	*/
 	void onUpdate(double delta_time)
 	{
+		pos_player_last = pos_player;
+
 		timer_auto_increase_mp.onUpdate(delta_time);
 		timer_release_flash_cd.onUpdate(delta_time);
 
@@ -180,7 +182,7 @@ public:
 		}
 
 		auto& coin_prop_list = CoinManager::instance()->getCoinPropList();
-		static const auto& sound_pool = ResourceManager::instance()->getSoundPool();
+		static const SoundHandle sound_coin = ResourceManager::instance()->acquireSound(ResID::Sound_Coin);
 		for (auto* coin_prop : coin_prop_list) {
 			if (coin_prop->canRemove()) continue;
 
@@ -192,31 +194,36 @@ public:
 				coin_prop->makeInvalid();
 				CoinManager::instance()->increaseCoin(10);
 
-				Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_Coin)->second, 0);
+				Mix_PlayChannel(-1, sound_coin, 0);
 			}
 		}
 	}
 
 	/**
 	* @brief 渲染玩家
-	* @param renderer 渲染器
+	* @param render_list 渲染命令列表
+	* @param alpha 插值系数，在上次与本次更新的位置之间插值
 	*/
-	void onRender(SDL_Renderer* renderer)
+	void onRender(RenderList& render_list, double alpha)
 	{
-		static SDL_Point point;
-		point.x = (int)(pos_player.x - size.x / 2);
-		point.y = (int)(pos_player.y - size.y / 2);
-		anim_current->onRender(renderer, point);
+		SDL_Point point;
+		const Vector2 pos_player_render = Vector2::lerp(pos_player_last, pos_player, alpha);
+		point.x = (int)(pos_player_render.x - size.x / 2);
+		point.y = (int)(pos_player_render.y - size.y / 2);
+		render_list.setLayer(RenderLayer::Actor, (int)(pos_player_render.y + size.y / 2));
+		anim_current->onRender(render_list, point);
 
 		if (is_releasing_flash) {
+			render_list.setLayer(RenderLayer::Air, rect_hitbox_flash.y + rect_hitbox_flash.h);
 			point.x = rect_hitbox_flash.x;
 			point.y = rect_hitbox_flash.y;
-			anim_effect_flash_current->onRender(renderer, point);
+			anim_effect_flash_current->onRender(render_list, point);
 		}
 		else if (is_releasing_impact) {
+			render_list.setLayer(RenderLayer::Air, rect_hitbox_impact.y + rect_hitbox_impact.h);
 			point.x = rect_hitbox_impact.x;
 			point.y = rect_hitbox_impact.y;
-			anim_effect_impact_current->onRender(renderer, point);
+			anim_effect_impact_current->onRender(render_list, point);
 		}
 	}
 
@@ -225,6 +232,19 @@ public:
 	 */
 	double getCurrentMP() const { return mp; }
 
+	/**
+	 * @brief 配置热重载后刷新缓存的玩家属性
+	 *
+	 * 攻击伤害在使用时读取配置，只需刷新构造时缓存的移动速度与技能冷却时间
+	 */
+	void refreshTemplate()
+	{
+		const auto& player_template = ConfigManager::instance()->player_template;
+
+		speed = player_template.speed;
+		timer_release_flash_cd.setWaitTime(player_template.skill_interval);
+	}
+
 protected:
 	PlayerManager()
 	{
@@ -243,9 +263,15 @@ protected:
 				can_release_flash = true;
 			});
 
-		static const auto& tex_pool = ResourceManager::instance()->getTexturePool();
+		static auto* resource = ResourceManager::instance();
 
-		static auto* tex_player = tex_pool.find(ResID::Tex_Player)->second;
+		static const TextureHandle tex_player = resource->acquireTexture(ResID::Tex_Player);
+		static const TextureHandle tex_flash_list[4] = {
+			resource->acquireTexture(ResID::Tex_EffectFlash_Up), resource->acquireTexture(ResID::Tex_EffectFlash_Down),
+			resource->acquireTexture(ResID::Tex_EffectFlash_Left), resource->acquireTexture(ResID::Tex_EffectFlash_Right) };
+		static const TextureHandle tex_impact_list[4] = {
+			resource->acquireTexture(ResID::Tex_EffectImpact_Up), resource->acquireTexture(ResID::Tex_EffectImpact_Down),
+			resource->acquireTexture(ResID::Tex_EffectImpact_Left), resource->acquireTexture(ResID::Tex_EffectImpact_Right) };
 
 		// 定义空闲状态四个方向的动画帧索引
 		static const std::vector<int> idx_list_idle_up = { 4, 5, 6, 7 };
@@ -282,19 +308,20 @@ protected:
 		setAnimation(anim_attack_left, tex_player, true, 4, 8, idx_list_attack_left, 0.1);
 		setAnimation(anim_attack_right, tex_player, true, 4, 8, idx_list_attack_right, 0.1);
 
-		setAnimation(anim_effect_flash_up, tex_pool.find(ResID::Tex_EffectFlash_Up)->second, false, 5, 1, idx_list_effect_flash_up, 0.1, [&]() { is_releasing_flash = false; });
-		setAnimation(anim_effect_flash_down, tex_pool.find(ResID::Tex_EffectFlash_Down)->second, false, 5, 1, idx_list_effect_flash_down, 0.1, [&]() { is_releasing_flash = false; });
-		setAnimation(anim_effect_flash_left, tex_pool.find(ResID::Tex_EffectFlash_Left)->second, false, 1, 5, idx_list_effect_flash_left, 0.1, [&]() { is_releasing_flash = false; });
-		setAnimation(anim_effect_flash_right, tex_pool.find(ResID::Tex_EffectFlash_Right)->second, false, 1, 5, idx_list_effect_flash_right, 0.1, [&]() { is_releasing_flash = false; });
+		setAnimation(anim_effect_flash_up, tex_flash_list[0], false, 5, 1, idx_list_effect_flash_up, 0.1, [&]() { is_releasing_flash = false; });
+		setAnimation(anim_effect_flash_down, tex_flash_list[1], false, 5, 1, idx_list_effect_flash_down, 0.1, [&]() { is_releasing_flash = false; });
+		setAnimation(anim_effect_flash_left, tex_flash_list[2], false, 1, 5, idx_list_effect_flash_left, 0.1, [&]() { is_releasing_flash = false; });
+		setAnimation(anim_effect_flash_right, tex_flash_list[3], false, 1, 5, idx_list_effect_flash_right, 0.1, [&]() { is_releasing_flash = false; });
 
-		setAnimation(anim_effect_impact_up, tex_pool.find(ResID::Tex_EffectImpact_Up)->second, false, 5, 1, idx_list_effect_impact_up, 0.1, [&]() { is_releasing_impact = false; });
-		setAnimation(anim_effect_impact_down, tex_pool.find(ResID::Tex_EffectImpact_Down)->second, false, 5, 1, idx_list_effect_impact_down, 0.1, [&]() { is_releasing_impact = false; });
-		setAnimation(anim_effect_impact_left, tex_pool.find(ResID::Tex_EffectImpact_Left)->second, false, 1, 5, idx_list_effect_impact_left, 0.1, [&]() { is_releasing_impact = false; });
-		setAnimation(anim_effect_impact_right, tex_pool.find(ResID::Tex_EffectImpact_Right)->second, false, 1, 5, idx_list_effect_impact_right, 0.1, [&]() { is_releasing_impact = false; });
+		setAnimation(anim_effect_impact_up, tex_impact_list[0], false, 5, 1, idx_list_effect_impact_up, 0.1, [&]() { is_releasing_impact = false; });
+		setAnimation(anim_effect_impact_down, tex_impact_list[1], false, 5, 1, idx_list_effect_impact_down, 0.1, [&]() { is_releasing_impact = false; });
+		setAnimation(anim_effect_impact_left, tex_impact_list[2], false, 1, 5, idx_list_effect_impact_left, 0.1, [&]() { is_releasing_impact = false; });
+		setAnimation(anim_effect_impact_right, tex_impact_list[3], false, 1, 5, idx_list_effect_impact_right, 0.1, [&]() { is_releasing_impact = false; });
 
 		const auto& rect_map = ConfigManager::instance()->rect_tile_map;
 		pos_player.x = rect_map.x + rect_map.w / static_cast<double>(2);
 		pos_player.y = rect_map.y + rect_map.h / static_cast<double>(2);
+		pos_player_last = pos_player;
 
 		speed = ConfigManager::instance()->player_template.speed;
 
@@ -306,6 +333,7 @@ protected:
 private:
 	Vector2 size;									  // 玩家大小
 	Vector2 pos_player;								  // 玩家位置
+	Vector2 pos_player_last;						  // 本次更新前的玩家位置
 	Vector2 velocity;								  // 玩家速度
 
 	SDL_Rect rect_hitbox_flash = { 0 };				  // 闪电特效的碰撞矩形
@@ -392,7 +420,8 @@ private:
 		anim_effect_flash_current->reset();
 		timer_release_flash_cd.restart();
 
-		Mix_PlayChannel(-1, ResourceManager::instance()->getSoundPool().find(ResID::Sound_Flash)->second, 0);
+		static const SoundHandle sound_flash = ResourceManager::instance()->acquireSound(ResID::Sound_Flash);
+		Mix_PlayChannel(-1, sound_flash, 0);
 	}
 
 	/**
@@ -436,7 +465,8 @@ private:
 		is_releasing_impact = true;
 		anim_effect_impact_current->reset();
 
-		Mix_PlayChannel(-1, ResourceManager::instance()->getSoundPool().find(ResID::Sound_Impact)->second, 0);
+		static const SoundHandle sound_impact = ResourceManager::instance()->acquireSound(ResID::Sound_Impact);
+		Mix_PlayChannel(-1, sound_impact, 0);
 	}
 
 	/**
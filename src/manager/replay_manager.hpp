@@ -0,0 +1,237 @@
+﻿#pragma once
+
+#include "manager.hpp"
+#include "home_manager.hpp"
+#include "coin_manager.hpp"
+#include "enemy_manager.hpp"
+#include "bullet_manager.hpp"
+
+#include <SDL.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 录像管理器，负责录制与回放游戏过程
+ * @details 继承自Manager单例模板类。
+ *          以游戏逻辑的一个固定步长为一帧，与渲染帧率及时间倍率无关。
+ *          录制时逐帧保存帧间隔、输入事件和帧末的状态校验值；
+ *          回放时用录制的帧间隔与输入事件驱动游戏，并逐帧比对状态校验值，
+ *          用于验证重构前后游戏行为一致。
+ *
+ * 文件格式(小端)：文件头"TDRP"+版本号，之后每帧依次为
+ * 帧间隔(double)、事件数量(uint32)、事件数组(SDL_Event)、状态校验值(uint64)
+ */
+class ReplayManager : public Manager<ReplayManager>
+{
+    friend class Manager<ReplayManager>;
+
+public:
+    /**
+     * @brief 录像模式
+     */
+    enum class Mode
+    {
+        None,       // 未录制也未回放
+        Record,     // 录制
+        Replay      // 回放
+    };
+
+public:
+    /**
+     * @brief 开始录制
+     * @param path 录像文件路径
+     * @return 文件创建成功返回true，否则返回false
+     */
+    bool startRecord(const std::string& path)
+    {
+        m_file_out.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_file_out.good())
+            return false;
+
+        m_file_out.write(MAGIC, sizeof(MAGIC));
+        writeValue(VERSION);
+
+        m_mode = Mode::Record;
+        return true;
+    }
+
+    /**
+     * @brief 开始回放
+     * @param path 录像文件路径
+     * @return 文件存在且格式正确返回true，否则返回false
+     */
+    bool startReplay(const std::string& path)
+    {
+        m_file_in.open(path, std::ios::binary);
+        if (!m_file_in.good())
+            return false;
+
+        char magic[sizeof(MAGIC)] = { 0 };
+        uint32_t version = 0;
+        m_file_in.read(magic, sizeof(magic));
+        if (!readValue(version) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION)
+            return false;
+
+        m_mode = Mode::Replay;
+        return true;
+    }
+
+    Mode getMode() const { return m_mode; }                         // 当前录像模式
+    bool isReplaying() const { return m_mode == Mode::Replay; }     // 是否正在回放
+    size_t getMismatchCount() const { return m_num_mismatch; }      // 回放中状态不一致的帧数
+
+    /**
+     * @brief 录制输入事件
+     * @param event SDL事件
+     * @details 仅录制键盘与鼠标事件，其余事件与游戏逻辑无关或含有指针
+     */
+    void recordEvent(const SDL_Event& event)
+    {
+        if (m_mode != Mode::Record)
+            return;
+
+        switch (event.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEWHEEL:
+            m_event_list.push_back(event);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /**
+     * @brief 读取回放的下一帧
+     * @param delta_time 输出参数，录制时的帧间隔
+     * @return 本帧录制的输入事件列表，录像结束时返回nullptr
+     */
+    const std::vector<SDL_Event>* readFrame(double& delta_time)
+    {
+        uint32_t num_event = 0;
+        if (m_mode != Mode::Replay || !readValue(delta_time) || !readValue(num_event))
+            return nullptr;
+
+        m_event_list.resize(num_event);
+        if (num_event > 0)
+            m_file_in.read((char*)m_event_list.data(), sizeof(SDL_Event) * num_event);
+
+        if (!readValue(m_hash_expected))
+            return nullptr;
+
+        return &m_event_list;
+    }
+
+    /**
+     * @brief 结束一帧
+     * @param delta_time 本帧的帧间隔
+     * @details 录制时写入本帧数据；回放时比对本帧的状态校验值，首次不一致时输出日志
+     */
+    void endFrame(double delta_time)
+    {
+        if (m_mode == Mode::None)
+            return;
+
+        uint64_t hash = computeStateHash();
+
+        if (m_mode == Mode::Record) {
+            writeValue(delta_time);
+            writeValue((uint32_t)m_event_list.size());
+            if (!m_event_list.empty())
+                m_file_out.write((const char*)m_event_list.data(), sizeof(SDL_Event) * m_event_list.size());
+            writeValue(hash);
+
+            m_event_list.clear();
+        }
+        else if (hash != m_hash_expected) {
+            if (m_num_mismatch == 0)
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "replay diverged at frame %zu", m_index_frame);
+            m_num_mismatch++;
+        }
+
+        m_index_frame++;
+    }
+
+    /**
+     * @brief 计算当前游戏状态的校验值
+     * @return 64位校验值
+     * @details 覆盖基地血量、金币数量以及所有敌人、子弹、金币道具的位置与状态。
+     *          各对象的哈希以加法合并，与容器内的遍历顺序无关
+     */
+    static uint64_t computeStateHash()
+    {
+        uint64_t hash = hashValue(HomeManager::instance()->getCurrentHPNum());
+        hash = hash * 31 + hashValue(CoinManager::instance()->getCurrentCoinNum());
+
+        uint64_t hash_enemy = 0;
+        for (const auto* enemy : EnemyManager::instance()->getEnemyList())
+            hash_enemy += hashValue(enemy->getPosition().x, enemy->getPosition().y, enemy->getHp());
+
+        uint64_t hash_bullet = 0;
+        const double time_bullet = BulletManager::instance()->getTime();
+        for (size_t i = 0; i < BULLET_TYPE_COUNT; i++) {
+            for (const auto& bullet : BulletManager::instance()->getBulletList((BulletType)i)) {
+                const Vector2 position_bullet = bullet.getPosition(time_bullet);
+                hash_bullet += hashValue(position_bullet.x, position_bullet.y, (double)bullet.canCollide());
+            }
+        }
+
+        uint64_t hash_coin = 0;
+        for (const auto* coin_prop : CoinManager::instance()->getCoinPropList())
+            hash_coin += hashValue(coin_prop->getPosition().x, coin_prop->getPosition().y);
+
+        return ((hash * 31 + hash_enemy) * 31 + hash_bullet) * 31 + hash_coin;
+    }
+
+protected:
+    ReplayManager() = default;
+    ~ReplayManager() = default;
+
+private:
+    static constexpr char MAGIC[4] = { 'T', 'D', 'R', 'P' };   // 文件头标识
+    static constexpr uint32_t VERSION = 3;                      // 文件格式版本
+
+    Mode m_mode = Mode::None;               // 当前录像模式
+    std::ofstream m_file_out;               // 录制输出文件
+    std::ifstream m_file_in;                // 回放输入文件
+    std::vector<SDL_Event> m_event_list;    // 本帧的输入事件
+    uint64_t m_hash_expected = 0;           // 回放时本帧期望的状态校验值
+    size_t m_index_frame = 0;               // 当前帧序号
+    size_t m_num_mismatch = 0;              // 状态不一致的帧数
+
+private:
+    template <typename T>
+    void writeValue(const T& value)
+    {
+        m_file_out.write((const char*)&value, sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(T& value)
+    {
+        m_file_in.read((char*)&value, sizeof(T));
+        return m_file_in.gcount() == sizeof(T);
+    }
+
+    /**
+     * @brief 对若干浮点数的二进制表示做FNV-1a哈希
+     */
+    template <typename... Args>
+    static uint64_t hashValue(Args... values)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (double value : { (double)values... }) {
+            unsigned char bytes[sizeof(double)];
+            memcpy(bytes, &value, sizeof(double));
+            for (unsigned char byte : bytes)
+                hash = (hash ^ byte) * 1099511628211ull;
+        }
+        return hash;
+    }
+};
\ No newline at end of file
@@ -1,11 +1,22 @@
 ﻿#pragma once
 
 #include "manager.hpp"
+#include "../util/resource_pack.hpp"
 
 #include <SDL_image.h>
 #include <SDL_mixer.h>
 #include <SDL_ttf.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 /**
  * @enum ResID
@@ -27,11 +38,6 @@ enum class ResID
 	Tex_Skeleton,
 	Tex_Goblin,
 	Tex_GoblinPriest,
-	Tex_SlimeSketch,
-	Tex_KingSlimeSketch,
-	Tex_SkeletonSketch,
-	Tex_GoblinSketch,
-	Tex_GoblinPriestSketch,
 
 	Tex_BulletArrow,
 	Tex_BulletAxe,
@@ -92,137 +98,356 @@ enum class ResID
 
 	Music_BGM,
 
-	Font_Main
+	Font_Main,
+
+	Count
 };
 
 /**
- * @brief 游戏资源管理器，负责加载和管理所有游戏资源
+ * @brief 资源句柄，持有对一个资源的一次引用
+ * @tparam T 资源类型
  *
- * 使用单例模式实现，管理游戏中的纹理、音效、音乐和字体资源
+ * 复制时增加引用计数，析构时减少；引用计数为0的资源在超出内存预算时可被卸载。
+ * 可隐式转换为资源指针，空句柄或加载失败时为nullptr
+ */
+template <typename T>
+class ResHandle
+{
+	friend class ResourceManager;
+
+public:
+	ResHandle() = default;
+	~ResHandle() { release(); }
+
+	ResHandle(const ResHandle &other) : id(other.id), resource(other.resource) { addRef(); }
+	ResHandle(ResHandle &&other) noexcept : id(other.id), resource(other.resource)
+	{
+		other.id = ResID::Count;
+		other.resource = nullptr;
+	}
+
+	ResHandle &operator=(const ResHandle &other)
+	{
+		if (this != &other)
+		{
+			release();
+			id = other.id;
+			resource = other.resource;
+			addRef();
+		}
+		return *this;
+	}
+
+	ResHandle &operator=(ResHandle &&other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			id = other.id;
+			resource = other.resource;
+			other.id = ResID::Count;
+			other.resource = nullptr;
+		}
+		return *this;
+	}
+
+	operator T *() const { return resource; }
+	T *get() const { return resource; }
+	ResID getID() const { return id; }
+
+private:
+	ResID id = ResID::Count; // 资源ID，空句柄为Count
+	T *resource = nullptr;	 // 资源指针
+
+private:
+	ResHandle(ResID id, T *resource) : id(id), resource(resource) {}
+
+	void addRef();
+	void release();
+};
+
+using TextureHandle = ResHandle<SDL_Texture>;
+using SoundHandle = ResHandle<Mix_Chunk>;
+using MusicHandle = ResHandle<Mix_Music>;
+using FontHandle = ResHandle<TTF_Font>;
+
+/**
+ * @brief 游戏资源管理器，按资源ID在首次使用时加载资源并维护引用计数
+ *
+ * 使用单例模式实现，管理游戏中的纹理、音效、音乐和字体资源。
+ * 通过acquire系列函数取得资源句柄，资源在第一次被取得时才加载，加载耗时计入首次使用停顿；
+ * preload()可在启动时提前加载关卡会用到的资源。
+ * 所有句柄都释放后资源仍然驻留，直到纹理与音效的总大小超出预算时，
+ * 由trim()按最久未使用的顺序卸载。
+ * 纹理只能在主线程加载与卸载，逻辑线程中使用的纹理需要预加载或在主线程中先行取得。
+ * 打开资源包后优先从资源包加载：纹理直接上传预解码的像素，音效直接引用解码后的PCM，
+ * 其余文件从映射的内存中读取；资源包中没有的文件回退到res目录下的松散文件
  */
 class ResourceManager : public Manager<ResourceManager>
 {
 	friend class Manager<ResourceManager>;
-
-	template <typename ResourceType>
-	using ResourcePool = std::unordered_map<ResID, ResourceType *>;
+	template <typename T>
+	friend class ResHandle;
 
 public:
-	using TexturePool = ResourcePool<SDL_Texture>;
-	using SoundPool = ResourcePool<Mix_Chunk>;
-	using MusicPool = ResourcePool<Mix_Music>;
-	using FontPool = ResourcePool<TTF_Font>;
+	/**
+	 * @brief 资源统计
+	 */
+	struct Stats
+	{
+		size_t num_resident = 0;	   // 驻留的资源数
+		size_t size_resident = 0;	   // 驻留的纹理与音效大小(字节)
+		size_t size_peak = 0;		   // 驻留大小的峰值(字节)
+		size_t num_load = 0;		   // 加载次数
+		size_t num_lazy_load = 0;	   // 首次使用时才加载的次数
+		size_t num_unload = 0;		   // 卸载次数
+		double time_stall_total = 0;   // 首次使用加载的总耗时(毫秒)
+		double time_stall_max = 0;	   // 首次使用加载的最长耗时(毫秒)
+		ResID id_stall_max = ResID::Count; // 耗时最长的资源
+	};
 
 public:
-	const TexturePool &getTexturePool() const { return m_texturePool; }
-	const SoundPool &getSoundPool() const { return m_soundPool; }
-	const MusicPool &getMusicPool() const { return m_musicPool; }
-	const FontPool &getFontPool() const { return m_fontPool; }
-
-	/**
-	 * @brief 从文件加载所有游戏资源
-	 * @param renderer SDL渲染器指针
-	 * @return 加载是否成功
-	 */
-	bool loadFromFile(SDL_Renderer *renderer)
-	{
-		m_texturePool[ResID::Tex_StartMenu] = IMG_LoadTexture(renderer, "res/image/start_menu.png");
-
-		m_texturePool[ResID::Tex_TileSet] = IMG_LoadTexture(renderer, "res/image/tileset.png");
-
-		m_texturePool[ResID::Tex_Player] = IMG_LoadTexture(renderer, "res/image/player.png");
-		m_texturePool[ResID::Tex_Archer] = IMG_LoadTexture(renderer, "res/image/tower_archer.png");
-		m_texturePool[ResID::Tex_Axeman] = IMG_LoadTexture(renderer, "res/image/tower_axeman.png");
-		m_texturePool[ResID::Tex_Gunner] = IMG_LoadTexture(renderer, "res/image/tower_gunner.png");
-
-		m_texturePool[ResID::Tex_Slime] = IMG_LoadTexture(renderer, "res/image/enemy_slime.png");
-		m_texturePool[ResID::Tex_KingSlime] = IMG_LoadTexture(renderer, "res/image/enemy_king_slime.png");
-		m_texturePool[ResID::Tex_Skeleton] = IMG_LoadTexture(renderer, "res/image/enemy_skeleton.png");
-		m_texturePool[ResID::Tex_Goblin] = IMG_LoadTexture(renderer, "res/image/enemy_goblin.png");
-		m_texturePool[ResID::Tex_GoblinPriest] = IMG_LoadTexture(renderer, "res/image/enemy_goblin_priest.png");
-		m_texturePool[ResID::Tex_SlimeSketch] = IMG_LoadTexture(renderer, "res/image/enemy_slime_sketch.png");
-		m_texturePool[ResID::Tex_KingSlimeSketch] = IMG_LoadTexture(renderer, "res/image/enemy_king_slime_sketch.png");
-		m_texturePool[ResID::Tex_SkeletonSketch] = IMG_LoadTexture(renderer, "res/image/enemy_skeleton_sketch.png");
-		m_texturePool[ResID::Tex_GoblinSketch] = IMG_LoadTexture(renderer, "res/image/enemy_goblin_sketch.png");
-		m_texturePool[ResID::Tex_GoblinPriestSketch] = IMG_LoadTexture(renderer, "res/image/enemy_goblin_priest_sketch.png");
-
-		m_texturePool[ResID::Tex_BulletArrow] = IMG_LoadTexture(renderer, "res/image/bullet_arrow.png");
-		m_texturePool[ResID::Tex_BulletAxe] = IMG_LoadTexture(renderer, "res/image/bullet_axe.png");
-		m_texturePool[ResID::Tex_BulletShell] = IMG_LoadTexture(renderer, "res/image/bullet_shell.png");
-
-		m_texturePool[ResID::Tex_Coin] = IMG_LoadTexture(renderer, "res/image/coin.png");
-		m_texturePool[ResID::Tex_Home] = IMG_LoadTexture(renderer, "res/image/home.png");
-
-		m_texturePool[ResID::Tex_EffectFlash_Up] = IMG_LoadTexture(renderer, "res/image/effect_flash_up.png");
-		m_texturePool[ResID::Tex_EffectFlash_Down] = IMG_LoadTexture(renderer, "res/image/effect_flash_down.png");
-		m_texturePool[ResID::Tex_EffectFlash_Left] = IMG_LoadTexture(renderer, "res/image/effect_flash_left.png");
-		m_texturePool[ResID::Tex_EffectFlash_Right] = IMG_LoadTexture(renderer, "res/image/effect_flash_right.png");
-		m_texturePool[ResID::Tex_EffectImpact_Up] = IMG_LoadTexture(renderer, "res/image/effect_impact_up.png");
-		m_texturePool[ResID::Tex_EffectImpact_Down] = IMG_LoadTexture(renderer, "res/image/effect_impact_down.png");
-		m_texturePool[ResID::Tex_EffectImpact_Left] = IMG_LoadTexture(renderer, "res/image/effect_impact_left.png");
-		m_texturePool[ResID::Tex_EffectImpact_Right] = IMG_LoadTexture(renderer, "res/image/effect_impact_right.png");
-		m_texturePool[ResID::Tex_EffectExplode] = IMG_LoadTexture(renderer, "res/image/effect_explode.png");
-
-		m_texturePool[ResID::Tex_UISelectCursor] = IMG_LoadTexture(renderer, "res/image/ui_select_cursor.png");
-		m_texturePool[ResID::Tex_UIPlaceIdle] = IMG_LoadTexture(renderer, "res/image/ui_place_idle.png");
-		m_texturePool[ResID::Tex_UIPlaceHoveredTop] = IMG_LoadTexture(renderer, "res/image/ui_place_hovered_top.png");
-		m_texturePool[ResID::Tex_UIPlaceHoveredLeft] = IMG_LoadTexture(renderer, "res/image/ui_place_hovered_left.png");
-		m_texturePool[ResID::Tex_UIPlaceHoveredRight] = IMG_LoadTexture(renderer, "res/image/ui_place_hovered_right.png");
-		m_texturePool[ResID::Tex_UIUpgradeIdle] = IMG_LoadTexture(renderer, "res/image/ui_upgrade_idle.png");
-		m_texturePool[ResID::Tex_UIUpgradeHoveredTop] = IMG_LoadTexture(renderer, "res/image/ui_upgrade_hovered_top.png");
-		m_texturePool[ResID::Tex_UIUpgradeHoveredLeft] = IMG_LoadTexture(renderer, "res/image/ui_upgrade_hovered_left.png");
-		m_texturePool[ResID::Tex_UIUpgradeHoveredRight] = IMG_LoadTexture(renderer, "res/image/ui_upgrade_hovered_right.png");
-		m_texturePool[ResID::Tex_UIHomeAvatar] = IMG_LoadTexture(renderer, "res/image/ui_home_avatar.png");
-		m_texturePool[ResID::Tex_UIPlayerAvatar] = IMG_LoadTexture(renderer, "res/image/ui_player_avatar.png");
-		m_texturePool[ResID::Tex_UIHeart] = IMG_LoadTexture(renderer, "res/image/ui_heart.png");
-		m_texturePool[ResID::Tex_UICoin] = IMG_LoadTexture(renderer, "res/image/ui_coin.png");
-		m_texturePool[ResID::Tex_UIGameOverBar] = IMG_LoadTexture(renderer, "res/image/ui_game_over_bar.png");
-		m_texturePool[ResID::Tex_UIWinText] = IMG_LoadTexture(renderer, "res/image/ui_win_text.png");
-		m_texturePool[ResID::Tex_UILossText] = IMG_LoadTexture(renderer, "res/image/ui_loss_text.png");
-
-		for (const auto &pair : m_texturePool)
-			if (!pair.second)
-				return false;
-
-		m_soundPool[ResID::Sound_ArrowFire_1] = Mix_LoadWAV("res/music/sound_arrow_fire_1.mp3");
-		m_soundPool[ResID::Sound_ArrowFire_2] = Mix_LoadWAV("res/music/sound_arrow_fire_2.mp3");
-		m_soundPool[ResID::Sound_AxeFire] = Mix_LoadWAV("res/music/sound_axe_fire.wav");
-		m_soundPool[ResID::Sound_ShellFire] = Mix_LoadWAV("res/music/sound_shell_fire.wav");
-		m_soundPool[ResID::Sound_ArrowHit_1] = Mix_LoadWAV("res/music/sound_arrow_hit_1.mp3");
-		m_soundPool[ResID::Sound_ArrowHit_2] = Mix_LoadWAV("res/music/sound_arrow_hit_2.mp3");
-		m_soundPool[ResID::Sound_ArrowHit_3] = Mix_LoadWAV("res/music/sound_arrow_hit_3.mp3");
-		m_soundPool[ResID::Sound_AxeHit_1] = Mix_LoadWAV("res/music/sound_axe_hit_1.mp3");
-		m_soundPool[ResID::Sound_AxeHit_2] = Mix_LoadWAV("res/music/sound_axe_hit_2.mp3");
-		m_soundPool[ResID::Sound_AxeHit_3] = Mix_LoadWAV("res/music/sound_axe_hit_3.mp3");
-		m_soundPool[ResID::Sound_ShellHit] = Mix_LoadWAV("res/music/sound_shell_hit.mp3");
-
-		m_soundPool[ResID::Sound_Flash] = Mix_LoadWAV("res/music/sound_flash.wav");
-		m_soundPool[ResID::Sound_Impact] = Mix_LoadWAV("res/music/sound_impact.wav");
-
-		m_soundPool[ResID::Sound_Coin] = Mix_LoadWAV("res/music/sound_coin.mp3");
-		m_soundPool[ResID::Sound_HomeHurt] = Mix_LoadWAV("res/music/sound_home_hurt.wav");
-		m_soundPool[ResID::Sound_PlaceTower] = Mix_LoadWAV("res/music/sound_place_tower.mp3");
-		m_soundPool[ResID::Sound_TowerLevelUp] = Mix_LoadWAV("res/music/sound_tower_level_up.mp3");
-
-		m_soundPool[ResID::Sound_Win] = Mix_LoadWAV("res/music/sound_win.wav");
-		m_soundPool[ResID::Sound_Loss] = Mix_LoadWAV("res/music/sound_loss.mp3");
-
-		for (const auto &pair : m_soundPool)
-			if (!pair.second)
-				return false;
-
-		m_musicPool[ResID::Music_BGM] = Mix_LoadMUS("res/music/music_bgm.mp3");
-
-		for (const auto &pair : m_musicPool)
-			if (!pair.second)
-				return false;
-
-		m_fontPool[ResID::Font_Main] = TTF_OpenFont("res/font/ipix.ttf", 25);
-
-		for (const auto &pair : m_fontPool)
-			if (!pair.second)
-				return false;
+	/**
+	 * @brief 根据资源名查找资源ID
+	 * @param name 资源名，与ResID枚举项同名(如"Tex_Slime")
+	 * @param id 输出参数，查找到的资源ID
+	 * @return 查找成功返回true，失败返回false
+	 * @details 供配置文件按名称引用资源使用
+	 */
+	static bool findResID(const std::string &name, ResID &id)
+	{
+		static const std::unordered_map<std::string, ResID> res_id_map = []()
+		{
+			std::unordered_map<std::string, ResID> map;
+			for (size_t i = 0; i < (size_t)ResID::Count; i++)
+				map[getInfo((ResID)i).name] = (ResID)i;
+			return map;
+		}();
+
+		auto it = res_id_map.find(name);
+		if (it == res_id_map.end())
+			return false;
+
+		id = it->second;
+		return true;
+	}
+
+	/**
+	 * @brief 获取资源名
+	 * @param id 资源ID
+	 * @return 与ResID枚举项同名的资源名
+	 */
+	static const char *getName(ResID id) { return id < ResID::Count ? getInfo(id).name : "none"; }
+
+	/**
+	 * @brief 初始化资源管理器
+	 * @param renderer 用于创建纹理的SDL渲染器指针
+	 * @param size_budget 纹理与音效的驻留大小预算(字节)，超出时卸载无引用的资源
+	 * @details 需在主线程中、打开资源包与音频设备之后调用，调用线程即为加载纹理的线程
+	 */
+	void init(SDL_Renderer *renderer, size_t size_budget)
+	{
+		m_renderer = renderer;
+		m_size_budget = size_budget;
+		m_thread_main = SDL_ThreadID();
+
+		// 音效PCM的格式与当前混音器输出格式一致时才能直接引用
+		int frequency = 0, channels = 0;
+		Uint16 format = 0;
+		Mix_QuerySpec(&frequency, &format, &channels);
+		m_is_pack_audio_matched = m_pack.isOpen() && m_pack.getHeader().audio_frequency == (uint32_t)frequency
+			&& m_pack.getHeader().audio_format == format && m_pack.getHeader().audio_channels == (uint32_t)channels;
+	}
+
+	/**
+	 * @brief 预加载资源并保持引用，预加载的资源不计入首次使用停顿
+	 * @param id_list 资源ID列表，可以重复
+	 * @return 全部加载成功返回true，否则返回false
+	 */
+	bool preload(const std::vector<ResID> &id_list)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		bool is_success = true;
+		for (ResID id : id_list)
+		{
+			Entry &entry = m_entry_list[(size_t)id];
+			if (entry.is_preloaded)
+				continue;
+
+			if (!entry.resource && !load(id, entry, false))
+			{
+				is_success = false;
+				continue;
+			}
+
+			entry.is_preloaded = true;
+			entry.ref_count++;
+		}
+
+		return is_success;
+	}
 
+	TextureHandle acquireTexture(ResID id) { return acquire<SDL_Texture>(id, ResKind::Texture); }
+	SoundHandle acquireSound(ResID id) { return acquire<Mix_Chunk>(id, ResKind::Sound); }
+	MusicHandle acquireMusic(ResID id) { return acquire<Mix_Music>(id, ResKind::Music); }
+	FontHandle acquireFont(ResID id) { return acquire<TTF_Font>(id, ResKind::Font); }
+
+	/**
+	 * @brief 按资源名取得纹理
+	 * @param name 纹理资源名
+	 * @return 纹理句柄，资源名无效或加载失败时为空句柄
+	 */
+	TextureHandle acquireTexture(const std::string &name)
+	{
+		ResID id;
+		return findResID(name, id) ? acquireTexture(id) : TextureHandle();
+	}
+
+	/**
+	 * @brief 按资源名取得音效
+	 * @param name 音效资源名
+	 * @return 音效句柄，资源名无效或加载失败时为空句柄
+	 */
+	SoundHandle acquireSound(const std::string &name)
+	{
+		ResID id;
+		return findResID(name, id) ? acquireSound(id) : SoundHandle();
+	}
+
+	/**
+	 * @brief 按资源ID列表取得一组音效
+	 * @param id_list 音效资源ID列表
+	 * @return 与列表一一对应的音效句柄
+	 */
+	template <size_t N>
+	std::array<SoundHandle, N> acquireSound(const std::array<ResID, N> &id_list)
+	{
+		std::array<SoundHandle, N> sound_list;
+		for (size_t i = 0; i < N; i++)
+			sound_list[i] = acquireSound(id_list[i]);
+		return sound_list;
+	}
+
+	/**
+	 * @brief 卸载超出预算的资源
+	 * @details 按释放时间从早到晚卸载引用计数为0的纹理与音效，直到驻留大小不超过预算。
+	 *          至少两次调用前就已释放的资源才会被卸载，保证已提交但尚未呈现的渲染命令中的纹理仍然有效；
+	 *          正在播放的音效不会被卸载。需在主线程中、逻辑线程空闲时每帧调用一次
+	 */
+	void trim()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_tick++;
+		while (m_stats.size_resident > m_size_budget)
+		{
+			Entry *entry_evict = nullptr;
+			for (size_t i = 0; i < (size_t)ResID::Count; i++)
+			{
+				Entry &entry = m_entry_list[i];
+				if (!entry.resource || entry.ref_count > 0 || entry.size == 0 || entry.tick_release + 2 > m_tick)
+					continue;
+
+				if (getKind((ResID)i) == ResKind::Sound && isPlaying((Mix_Chunk *)entry.resource))
+					continue;
+
+				if (!entry_evict || entry.tick_release < entry_evict->tick_release)
+					entry_evict = &entry;
+			}
+
+			if (!entry_evict)
+				break;
+
+			unload((ResID)(entry_evict - m_entry_list), *entry_evict);
+		}
+	}
+
+	const Stats &getStats() const { return m_stats; }
+	size_t getBudget() const { return m_size_budget; }
+
+	/**
+	 * @brief 打开资源包
+	 * @param path 资源包路径
+	 * @return 打开成功返回true，资源包不存在或格式不匹配时返回false，之后全部使用松散文件
+	 */
+	bool openPack(const std::string &path)
+	{
+		std::error_code error;
+		m_time_pack = std::filesystem::last_write_time(path, error);
+		if (error || !m_pack.open(path))
+			return false;
+
+		SDL_Log("resource pack %s: %zu entries", path.c_str(), m_pack.getEntryCount());
+		return true;
+	}
+
+	/**
+	 * @brief 判断松散文件是否在资源包生成之后被修改过
+	 * @param path 松散文件路径
+	 * @return 松散文件存在且比资源包新时返回true
+	 * @details 地图编辑器保存或热重载时编辑过的文件比资源包新，此时以松散文件为准，
+	 *          避免下次启动时被资源包中的旧数据覆盖
+	 */
+	bool isLooseFileNewer(const std::string &path) const
+	{
+		std::error_code error;
+		const auto time_loose = std::filesystem::last_write_time(path, error);
+		return !error && time_loose > m_time_pack;
+	}
+
+	/**
+	 * @brief 读取文件的全部内容
+	 * @param path 松散文件路径
+	 * @param content 输出参数，文件内容
+	 * @return 读取成功返回true，失败返回false
+	 * @details 资源包中有该文件且松散文件不比资源包新时直接从映射的内存复制，否则读取松散文件
+	 */
+	bool readFile(const std::string &path, std::string &content) const
+	{
+		if (const PackEntry *entry = findPackEntry(path, PackEntryType::Raw))
+		{
+			content.assign((const char *)m_pack.getData(*entry), (size_t)entry->size);
+			return true;
+		}
+
+		return readLooseFile(path, content);
+	}
+
+	/**
+	 * @brief 查找资源包中的原始文件，不复制数据
+	 * @param path 松散文件路径
+	 * @param data 输出参数，映射的文件内容，在资源管理器销毁前有效
+	 * @param size 输出参数，文件大小
+	 * @return 资源包中有该文件且松散文件不比资源包新时返回true
+	 */
+	bool findPackFile(const std::string &path, const uint8_t *&data, size_t &size) const
+	{
+		const PackEntry *entry = findPackEntry(path, PackEntryType::Raw);
+		if (!entry)
+			return false;
+
+		data = m_pack.getData(*entry);
+		size = (size_t)entry->size;
+		return true;
+	}
+
+	/**
+	 * @brief 跳过资源包，直接读取松散文件的全部内容
+	 * @param path 松散文件路径
+	 * @param content 输出参数，文件内容
+	 * @return 读取成功返回true，失败返回false
+	 * @details 不访问资源管理器的状态，可在任意线程中调用
+	 */
+	static bool readLooseFile(const std::string &path, std::string &content)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		std::stringstream buffer;
+		buffer << file.rdbuf();
+		content = buffer.str();
 		return true;
 	}
 
@@ -231,8 +456,390 @@ protected:
 	~ResourceManager() = default;
 
 private:
-	TexturePool m_texturePool; // 纹理资源池
-	SoundPool m_soundPool;	   // 音效资源池
-	MusicPool m_musicPool;	   // 音乐资源池
-	FontPool m_fontPool;	   // 字体资源池
+	/**
+	 * @brief 资源种类，由ResID所在的区间决定
+	 */
+	enum class ResKind
+	{
+		Texture,
+		Sound,
+		Music,
+		Font
+	};
+
+	/**
+	 * @brief 资源的名称与松散文件路径
+	 */
+	struct ResInfo
+	{
+		const char *name; // 资源名
+		const char *path; // 松散文件路径，也是资源包中的条目名
+	};
+
+	/**
+	 * @brief 资源表项
+	 */
+	struct Entry
+	{
+		void *resource = nullptr;  // 资源指针，未加载时为nullptr
+		uint32_t ref_count = 0;	   // 引用计数
+		size_t size = 0;		   // 计入预算的大小(字节)，音乐与字体为0
+		uint64_t tick_release = 0; // 引用计数最近一次降为0时的trim()调用次数
+		bool is_preloaded = false; // 是否已预加载，预加载持有一次引用
+	};
+
+	static constexpr int FONT_SIZE = 25; // 字体字号
+
+	Entry m_entry_list[(size_t)ResID::Count]; // 资源表，下标即ResID
+	std::mutex m_mutex;						  // 保护资源表，句柄可能在逻辑线程中复制与析构
+	Stats m_stats;							  // 资源统计
+	uint64_t m_tick = 0;					  // trim()的调用次数
+	size_t m_size_budget = 0;				  // 纹理与音效的驻留大小预算(字节)
+	SDL_Renderer *m_renderer = nullptr;		  // 创建纹理的渲染器
+	SDL_threadID m_thread_main = 0;			  // 主线程ID，只有主线程可以加载纹理
+
+	ResourcePack m_pack;				  // 资源包，未打开时全部使用松散文件
+	std::filesystem::file_time_type m_time_pack; // 资源包的修改时间，比它新的松散文件优先
+	bool m_is_pack_audio_matched = false; // 资源包中的PCM格式是否与混音器一致
+
+private:
+	/**
+	 * @brief 获取资源的名称与路径
+	 */
+	static const ResInfo &getInfo(ResID id)
+	{
+		static const ResInfo info_list[] = {
+			{"Tex_StartMenu", "res/image/start_menu.png"},
+
+			{"Tex_TileSet", "res/image/tileset.png"},
+
+			{"Tex_Player", "res/image/player.png"},
+			{"Tex_Archer", "res/image/tower_archer.png"},
+			{"Tex_Axeman", "res/image/tower_axeman.png"},
+			{"Tex_Gunner", "res/image/tower_gunner.png"},
+
+			{"Tex_Slime", "res/image/enemy_slime.png"},
+			{"Tex_KingSlime", "res/image/enemy_king_slime.png"},
+			{"Tex_Skeleton", "res/image/enemy_skeleton.png"},
+			{"Tex_Goblin", "res/image/enemy_goblin.png"},
+			{"Tex_GoblinPriest", "res/image/enemy_goblin_priest.png"},
+
+			{"Tex_BulletArrow", "res/image/bullet_arrow.png"},
+			{"Tex_BulletAxe", "res/image/bullet_axe.png"},
+			{"Tex_BulletShell", "res/image/bullet_shell.png"},
+
+			{"Tex_Coin", "res/image/coin.png"},
+			{"Tex_Home", "res/image/home.png"},
+
+			{"Tex_EffectFlash_Up", "res/image/effect_flash_up.png"},
+			{"Tex_EffectFlash_Down", "res/image/effect_flash_down.png"},
+			{"Tex_EffectFlash_Left", "res/image/effect_flash_left.png"},
+			{"Tex_EffectFlash_Right", "res/image/effect_flash_right.png"},
+			{"Tex_EffectImpact_Up", "res/image/effect_impact_up.png"},
+			{"Tex_EffectImpact_Down", "res/image/effect_impact_down.png"},
+			{"Tex_EffectImpact_Left", "res/image/effect_impact_left.png"},
+			{"Tex_EffectImpact_Right", "res/image/effect_impact_right.png"},
+			{"Tex_EffectExplode", "res/image/effect_explode.png"},
+
+			{"Tex_UISelectCursor", "res/image/ui_select_cursor.png"},
+			{"Tex_UIPlaceIdle", "res/image/ui_place_idle.png"},
+			{"Tex_UIPlaceHoveredTop", "res/image/ui_place_hovered_top.png"},
+			{"Tex_UIPlaceHoveredLeft", "res/image/ui_place_hovered_left.png"},
+			{"Tex_UIPlaceHoveredRight", "res/image/ui_place_hovered_right.png"},
+			{"Tex_UIUpgradeIdle", "res/image/ui_upgrade_idle.png"},
+			{"Tex_UIUpgradeHoveredTop", "res/image/ui_upgrade_hovered_top.png"},
+			{"Tex_UIUpgradeHoveredLeft", "res/image/ui_upgrade_hovered_left.png"},
+			{"Tex_UIUpgradeHoveredRight", "res/image/ui_upgrade_hovered_right.png"},
+			{"Tex_UIHomeAvatar", "res/image/ui_home_avatar.png"},
+			{"Tex_UIPlayerAvatar", "res/image/ui_player_avatar.png"},
+			{"Tex_UIHeart", "res/image/ui_heart.png"},
+			{"Tex_UICoin", "res/image/ui_coin.png"},
+			{"Tex_UIGameOverBar", "res/image/ui_game_over_bar.png"},
+			{"Tex_UIWinText", "res/image/ui_win_text.png"},
+			{"Tex_UILossText", "res/image/ui_loss_text.png"},
+
+			{"Sound_ArrowFire_1", "res/music/sound_arrow_fire_1.mp3"},
+			{"Sound_ArrowFire_2", "res/music/sound_arrow_fire_2.mp3"},
+			{"Sound_AxeFire", "res/music/sound_axe_fire.wav"},
+			{"Sound_ShellFire", "res/music/sound_shell_fire.wav"},
+			{"Sound_ArrowHit_1", "res/music/sound_arrow_hit_1.mp3"},
+			{"Sound_ArrowHit_2", "res/music/sound_arrow_hit_2.mp3"},
+			{"Sound_ArrowHit_3", "res/music/sound_arrow_hit_3.mp3"},
+			{"Sound_AxeHit_1", "res/music/sound_axe_hit_1.mp3"},
+			{"Sound_AxeHit_2", "res/music/sound_axe_hit_2.mp3"},
+			{"Sound_AxeHit_3", "res/music/sound_axe_hit_3.mp3"},
+			{"Sound_ShellHit", "res/music/sound_shell_hit.mp3"},
+
+			{"Sound_Flash", "res/music/sound_flash.wav"},
+			{"Sound_Impact", "res/music/sound_impact.wav"},
+
+			{"Sound_Coin", "res/music/sound_coin.mp3"},
+			{"Sound_HomeHurt", "res/music/sound_home_hurt.wav"},
+			{"Sound_PlaceTower", "res/music/sound_place_tower.mp3"},
+			{"Sound_TowerLevelUp", "res/music/sound_tower_level_up.mp3"},
+
+			{"Sound_Win", "res/music/sound_win.wav"},
+			{"Sound_Loss", "res/music/sound_loss.mp3"},
+
+			{"Music_BGM", "res/music/music_bgm.mp3"},
+
+			{"Font_Main", "res/font/ipix.ttf"}};
+
+		static_assert(sizeof(info_list) / sizeof(info_list[0]) == (size_t)ResID::Count, "resource table out of sync with ResID");
+
+		return info_list[(size_t)id];
+	}
+
+	static ResKind getKind(ResID id)
+	{
+		if (id < ResID::Sound_ArrowFire_1)
+			return ResKind::Texture;
+		if (id < ResID::Music_BGM)
+			return ResKind::Sound;
+		if (id == ResID::Music_BGM)
+			return ResKind::Music;
+		return ResKind::Font;
+	}
+
+	/**
+	 * @brief 取得资源句柄，资源未加载时立即加载
+	 * @details 在逻辑线程中首次取得纹理时无法加载，返回空句柄并输出错误
+	 */
+	template <typename T>
+	ResHandle<T> acquire(ResID id, ResKind kind)
+	{
+		if (id >= ResID::Count || getKind(id) != kind)
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "resource %d is not of the requested kind", (int)id);
+			return ResHandle<T>();
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		Entry &entry = m_entry_list[(size_t)id];
+		if (!entry.resource && !load(id, entry, true))
+			return ResHandle<T>();
+
+		entry.ref_count++;
+		return ResHandle<T>(id, (T *)entry.resource);
+	}
+
+	void addRef(ResID id)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_entry_list[(size_t)id].ref_count++;
+	}
+
+	void release(ResID id)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		Entry &entry = m_entry_list[(size_t)id];
+		if (--entry.ref_count == 0)
+			entry.tick_release = m_tick;
+	}
+
+	/**
+	 * @brief 加载资源并记录大小与耗时
+	 * @param is_lazy 是否为首次使用时的加载，耗时计入停顿统计
+	 */
+	bool load(ResID id, Entry &entry, bool is_lazy)
+	{
+		const ResInfo &info = getInfo(id);
+		const ResKind kind = getKind(id);
+
+		if (kind == ResKind::Texture && SDL_ThreadID() != m_thread_main)
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "texture %s used off the main thread before being loaded", info.name);
+			return false;
+		}
+
+		const auto time_begin = std::chrono::steady_clock::now();
+
+		switch (kind)
+		{
+		case ResKind::Texture:
+		{
+			SDL_Texture *texture = loadTexture(info.path);
+			int width = 0, height = 0;
+			if (texture)
+				SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+			entry.resource = texture;
+			entry.size = (size_t)width * height * 4;
+			break;
+		}
+		case ResKind::Sound:
+		{
+			Mix_Chunk *chunk = loadSound(info.path);
+			entry.resource = chunk;
+			entry.size = chunk ? chunk->alen : 0;
+			break;
+		}
+		case ResKind::Music:
+			entry.resource = loadMusic(info.path);
+			entry.size = 0;
+			break;
+		case ResKind::Font:
+			entry.resource = loadFont(info.path, FONT_SIZE);
+			entry.size = 0;
+			break;
+		}
+
+		if (!entry.resource)
+		{
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to load %s from %s: %s", info.name, info.path, SDL_GetError());
+			return false;
+		}
+
+		const double time_load = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_begin).count();
+
+		m_stats.num_resident++;
+		m_stats.size_resident += entry.size;
+		m_stats.size_peak = std::max(m_stats.size_peak, m_stats.size_resident);
+		m_stats.num_load++;
+		if (is_lazy)
+		{
+			m_stats.num_lazy_load++;
+			m_stats.time_stall_total += time_load;
+			if (time_load > m_stats.time_stall_max)
+			{
+				m_stats.time_stall_max = time_load;
+				m_stats.id_stall_max = id;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief 卸载资源
+	 */
+	void unload(ResID id, Entry &entry)
+	{
+		switch (getKind(id))
+		{
+		case ResKind::Texture:
+			SDL_DestroyTexture((SDL_Texture *)entry.resource);
+			break;
+		case ResKind::Sound:
+			Mix_FreeChunk((Mix_Chunk *)entry.resource);
+			break;
+		case ResKind::Music:
+			Mix_FreeMusic((Mix_Music *)entry.resource);
+			break;
+		case ResKind::Font:
+			TTF_CloseFont((TTF_Font *)entry.resource);
+			break;
+		}
+
+		m_stats.num_resident--;
+		m_stats.size_resident -= entry.size;
+		m_stats.num_unload++;
+
+		entry.resource = nullptr;
+		entry.size = 0;
+	}
+
+	/**
+	 * @brief 音效是否正在某个通道中播放
+	 */
+	static bool isPlaying(const Mix_Chunk *chunk)
+	{
+		const int num_channel = Mix_AllocateChannels(-1);
+		for (int i = 0; i < num_channel; i++)
+			if (Mix_Playing(i) && Mix_GetChunk(i) == chunk)
+				return true;
+
+		return false;
+	}
+
+	/**
+	 * @brief 在资源包中查找指定类型的条目
+	 * @return 条目，资源包未打开、没有该类型的条目或松散文件比资源包新时返回nullptr
+	 */
+	const PackEntry *findPackEntry(const std::string &path, PackEntryType type) const
+	{
+		if (!m_pack.isOpen())
+			return nullptr;
+
+		const PackEntry *entry = m_pack.find(path);
+		if (!entry || entry->type != type || isLooseFileNewer(path))
+			return nullptr;
+
+		return entry;
+	}
+
+	/**
+	 * @brief 加载纹理，资源包中的像素直接上传，无需解码
+	 */
+	SDL_Texture *loadTexture(const std::string &path)
+	{
+		const PackEntry *entry = findPackEntry(path, PackEntryType::Image);
+		if (!entry)
+			return IMG_LoadTexture(m_renderer, path.c_str());
+
+		SDL_Texture *texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+												 (int)entry->width, (int)entry->height);
+		if (!texture)
+			return nullptr;
+
+		SDL_UpdateTexture(texture, nullptr, m_pack.getData(*entry), (int)entry->pitch);
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+		return texture;
+	}
+
+	/**
+	 * @brief 加载音效，资源包中的PCM格式匹配时直接引用映射的内存
+	 */
+	Mix_Chunk *loadSound(const std::string &path)
+	{
+		const PackEntry *entry = m_is_pack_audio_matched ? findPackEntry(path, PackEntryType::Sound) : nullptr;
+		if (!entry)
+			return Mix_LoadWAV(path.c_str());
+
+		// 混音器只读取音效数据，不会写入
+		return Mix_QuickLoad_RAW((Uint8 *)m_pack.getData(*entry), (Uint32)entry->size);
+	}
+
+	/**
+	 * @brief 加载音乐，资源包中的数据在播放时流式解码
+	 */
+	Mix_Music *loadMusic(const std::string &path)
+	{
+		const PackEntry *entry = findPackEntry(path, PackEntryType::Raw);
+		if (!entry)
+			return Mix_LoadMUS(path.c_str());
+
+		return Mix_LoadMUS_RW(SDL_RWFromConstMem(m_pack.getData(*entry), (int)entry->size), 1);
+	}
+
+	/**
+	 * @brief 加载字体
+	 */
+	TTF_Font *loadFont(const std::string &path, int size)
+	{
+		const PackEntry *entry = findPackEntry(path, PackEntryType::Raw);
+		if (!entry)
+			return TTF_OpenFont(path.c_str(), size);
+
+		return TTF_OpenFontRW(SDL_RWFromConstMem(m_pack.getData(*entry), (int)entry->size), 1, size);
+	}
 };
+
+template <typename T>
+void ResHandle<T>::addRef()
+{
+	if (id != ResID::Count)
+		ResourceManager::instance()->addRef(id);
+}
+
+template <typename T>
+void ResHandle<T>::release()
+{
+	if (id != ResID::Count)
+		ResourceManager::instance()->release(id);
+
+	id = ResID::Count;
+	resource = nullptr;
+}
@@ -5,12 +5,10 @@
 #include "resource_manager.hpp"
 #include "../tower/tower.hpp"
 #include "../tower/tower_type.hpp"
-#include "../tower/archer_tower.hpp"
-#include "../tower/axeman_tower.hpp"
-#include "../tower/gunner_tower.hpp"
+#include "../tower/tower_prototype.hpp"
+#include "../util/object_pool.hpp"
 
 #include <vector>
-#include <memory>
 
 /**
  * @brief 塔管理器
@@ -36,15 +34,59 @@ public:
 	
 	/**
 	 * @brief 渲染所有塔
-	 * @param renderer SDL 渲染器
+	 * @param render_list 渲染命令列表
 	 */
-	void onRender(SDL_Renderer* renderer)
+	void onRender(RenderList& render_list)
 	{
 		for (auto* tower : m_tower_list) {
-			tower->onRender(renderer);
+			tower->onRender(render_list);
 		}
 	}
 
+	/**
+	 * @brief 根据配置中的防御塔模板烘焙所有防御塔原型
+	 * @return 所有原型烘焙成功返回true，否则返回false
+	 *
+	 * 需在游戏配置与资源加载完成后调用
+	 */
+	bool loadPrototypes()
+	{
+		static auto* config = ConfigManager::instance();
+
+		for (size_t i = 0; i < TOWER_TYPE_COUNT; i++) {
+			if (!TowerPrototype::bake((TowerType)i, config->getTowerTemplate((TowerType)i), m_prototype_list[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief 配置热重载后重新烘焙防御塔原型，并刷新已放置的塔
+	 * @return 烘焙成功返回true；失败时保留原有原型
+	 *
+	 * 原型先烘焙到临时列表，全部成功后才替换，塔持有的原型地址不变。
+	 * 需在主线程中、逻辑线程空闲时调用
+	 */
+	bool reloadPrototypes()
+	{
+		static auto* config = ConfigManager::instance();
+
+		TowerPrototype prototype_list[TOWER_TYPE_COUNT];
+		for (size_t i = 0; i < TOWER_TYPE_COUNT; i++) {
+			if (!TowerPrototype::bake((TowerType)i, config->getTowerTemplate((TowerType)i), prototype_list[i]))
+				return false;
+		}
+
+		for (size_t i = 0; i < TOWER_TYPE_COUNT; i++)
+			m_prototype_list[i] = std::move(prototype_list[i]);
+
+		for (auto* tower : m_tower_list)
+			tower->refreshPrototype();
+
+		return true;
+	}
+
 	/**
 	 * @brief 获取放置塔的费用
 	 * @param type 塔的类型
@@ -54,46 +96,20 @@ public:
 	{
 		static auto* config = ConfigManager::instance();
 
-		switch (type) {
-		case TowerType::Archer:
-			return config->archer_template.cost[config->level_archer];
-			break;
-		case TowerType::Axeman:
-			return config->axeman_template.cost[config->level_axeman];
-			break;
-		case TowerType::Gunner:
-			return config->gunner_template.cost[config->level_gunner];
-			break;
-		}
-
-		return 0;
+		return config->getTowerTemplate(type).cost[config->getTowerLevel(type)];
 	}
 
 	/**
 	 * @brief 获取升级塔的费用
 	 * @param type 塔的类型
-	 * @return 升级塔的费用
+	 * @return 升级塔的费用，已满级时返回-1
 	 */
 	double getUpgradeTowerCost(TowerType type) const
 	{
 		static auto* config = ConfigManager::instance();
 
-		switch (type) {
-		case TowerType::Archer:
-			return config->level_archer == 9 ? -1 : 
-				config->archer_template.upgrade_cost[config->level_archer];
-			break;
-		case TowerType::Axeman:
-			return config->level_axeman == 9 ? -1 :
-				config->axeman_template.upgrade_cost[config->level_axeman];
-			break;
-		case TowerType::Gunner:
-			return config->level_gunner == 9 ? -1 :
-				config->gunner_template.upgrade_cost[config->level_gunner];
-			break;
-		}
-
-		return 0;
+		const int level = config->getTowerLevel(type);
+		return level == 9 ? -1 : config->getTowerTemplate(type).upgrade_cost[level];
 	}
 
 	/**
@@ -105,44 +121,20 @@ public:
 	{
 		static auto* config = ConfigManager::instance();
 
-		switch (type) {
-		case TowerType::Archer:
-			return config->archer_template.view_range[config->level_archer];
-			break;
-		case TowerType::Axeman:
-			return config->axeman_template.view_range[config->level_axeman];
-			break;
-		case TowerType::Gunner:
-			return config->gunner_template.view_range[config->level_gunner];
-			break;
-		}
-
-		return 0;	
+		return config->getTowerTemplate(type).view_range[config->getTowerLevel(type)];
 	}
 
 	/**
 	 * @brief 放置塔
 	 * @param type 塔的类型
 	 * @param index 塔的位置
+	 *
+	 * 从对象池取出塔实例并复制对应原型的外观与属性
 	 */
 	void placeTower(TowerType type, const SDL_Point& index)
 	{
-		std::unique_ptr<Tower> tower = nullptr;
-
-		switch (type) {
-		case TowerType::Archer:
-			tower = std::make_unique<ArcherTower>();
-			break;
-		case TowerType::Axeman:
-			tower = std::make_unique<AxemanTower>();
-			break;
-		case TowerType::Gunner:
-			tower = std::make_unique<GunnerTower>();
-			break;
-		default:
-			tower = std::make_unique<ArcherTower>();
-			break;
-		}
+		Tower* tower = m_tower_pool.acquire();
+		tower->applyPrototype(m_prototype_list[(size_t)type]);
 
 		static Vector2 position;
 		static const auto& rect = ConfigManager::instance()->rect_tile_map;
@@ -151,12 +143,12 @@ public:
 		position.y = rect.y + index.y * TILE_SIZE + TILE_SIZE / 2;
 		tower->setPosition(position);
 
-		m_tower_list.push_back(tower.release());
+		m_tower_list.push_back(tower);
 		ConfigManager::instance()->map.placeTower(index);
 
-		static const auto& sound_pool = ResourceManager::instance()->getSoundPool();
+		static const SoundHandle sound_place = ResourceManager::instance()->acquireSound(ResID::Sound_PlaceTower);
 
-		Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_PlaceTower)->second, 0);
+		Mix_PlayChannel(-1, sound_place, 0);
 	}
 
 	/**
@@ -167,21 +159,12 @@ public:
 	{
 		static auto* config = ConfigManager::instance();
 
-		switch (type) {
-		case TowerType::Archer:
-			config->level_archer = config->level_archer < 9 ? config->level_archer + 1 : 9;
-			break;
-		case TowerType::Axeman:
-			config->level_axeman = config->level_axeman < 9 ? config->level_axeman + 1 : 9;
-			break;
-		case TowerType::Gunner:
-			config->level_gunner = config->level_gunner < 9 ? config->level_gunner + 1 : 9;
-			break;
-		}
+		int& level = config->getTowerLevel(type);
+		level = level < 9 ? level + 1 : 9;
 
-		static const auto& sound_pool = ResourceManager::instance()->getSoundPool();
+		static const SoundHandle sound_level_up = ResourceManager::instance()->acquireSound(ResID::Sound_TowerLevelUp);
 
-		Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_TowerLevelUp)->second, 0);
+		Mix_PlayChannel(-1, sound_level_up, 0);
 	}
 
 protected:
@@ -189,6 +172,8 @@ protected:
 	~TowerManager() = default;
 
 private:
-	TowerList m_tower_list;  // 存储所有塔的列表
+	TowerList m_tower_list;						// 存储所有塔的列表
+	ObjectPool<Tower> m_tower_pool;				// 塔对象池，持有所有塔的所有权
+	TowerPrototype m_prototype_list[TOWER_TYPE_COUNT];	// 各类型塔的原型，下标即TowerType
 };
 
@@ -4,8 +4,10 @@
 #include "config_manager.hpp"
 #include "enemy_manager.hpp"
 #include "coin_manager.hpp"
-#include "../basic/wave.hpp"
 #include "../util/timer.hpp"
+#include "../util/wave_timeline.hpp"
+
+#include <algorithm>
 
 /**
  * @brief 游戏波次管理器，负责控制敌人波次的刷新和进程
@@ -33,79 +35,140 @@ public:
         static auto* config = ConfigManager::instance();
         if (config->is_game_over) return;
 
-        if (!is_wave_started)
+        if (!is_wave_started) {
+            // 波次在本帧中途开始时，开始之后的时间已计入time_wave
             timer_start_wave.onUpdate(delta_time);
-        else
-            timer_spawn_event.onUpdate(delta_time);
+            if (is_wave_started)
+                spawnDueEvents(delta_time);
+        }
+        else if (!is_spawned_last_event) {
+            time_wave += delta_time;
+            spawnDueEvents(delta_time);
+        }
 
         if (is_spawned_last_event && EnemyManager::instance()->checkCleared()) {
-            CoinManager::instance()->increaseCoin(config->wave_list[index_wave].rewards);
-            index_wave++;
+            CoinManager::instance()->increaseCoin(reader.getWave().rewards);
 
-            if (index_wave >= config->wave_list.size()) {
+            if (!reader.nextWave()) {
                 config->is_game_win = true;
                 config->is_game_over = true;
                 return;
             }
-            else {
-                is_wave_started = false;
-                is_spawned_last_event = false;
-                index_spawn_event = 0;
 
-                timer_start_wave.setWaitTime(config->wave_list[index_wave].interval);
-                timer_start_wave.restart();
-            }
+            is_wave_started = false;
+            is_spawned_last_event = false;
+
+            // 波次间隔从最后一个敌人被移除的时刻算起
+            timer_start_wave.setWaitTime(reader.getWave().interval);
+            timer_start_wave.restart(EnemyManager::instance()->getTimeSinceLastRemoval());
+
+            prewarmWave();
+        }
+    }
+
+    /**
+     * @brief 关卡配置热重载后调整波次进度
+     *
+     * 在新时间线中定位到相同的波次与生成事件索引继续：
+     * 当前波次超出新时间线时视为最后一波已生成完毕，清场后即胜利；
+     * 当前波次的生成事件超出新时间线时视为本波已生成完毕，
+     * 本波已生成完毕而新时间线在其后追加了事件时继续生成。
+     * 距上一个事件已经过的时间保持不变，之后的事件按新时间线的时刻生成；
+     * 处于波次间歇期时，已等待的时间保持不变，按新的波次间隔等待
+     */
+    void onLevelReloaded()
+    {
+        static auto* config = ConfigManager::instance();
+        const auto& wave_timeline = config->wave_timeline;
+
+        const uint32_t index_wave = reader.getWaveIndex();
+        const uint32_t index_event = reader.getEventIndex();
+        const double time_since_last = time_wave - reader.getLastEventTime();
+
+        reader.open(wave_timeline);
+        if (!reader.seek(index_wave, index_event)) {
+            reader.seek(wave_timeline.getWaveCount() - 1, UINT32_MAX);
+            is_wave_started = true;
+            is_spawned_last_event = true;
+            return;
         }
+
+        time_wave = reader.getLastEventTime() + time_since_last;
+        is_spawned_last_event = is_wave_started && !reader.peek();
+
+        if (!is_wave_started)
+            timer_start_wave.setWaitTime(reader.getWave().interval);
+
+        prewarmWave();
     }
 
 protected:
     /**
      * @brief 构造函数，初始化波次管理器
      *
-     * 设置两个计时器：
-     * 1. timer_start_wave: 控制波次开始的间隔
-     * 2. timer_spawn_event: 控制敌人生成的间隔
+     * 从第一波开始读取波次时间线，设置控制波次开始间隔的计时器，
+     * 并为第一波预热对象池
      */
     WaveManager()
     {
-        static const auto& wave_list = ConfigManager::instance()->wave_list;
+        reader.open(ConfigManager::instance()->wave_timeline);
+
+        prewarmWave();
 
         timer_start_wave.setOneShot(true);
-        timer_start_wave.setWaitTime(wave_list[0].interval);
+        timer_start_wave.setWaitTime(reader.getWave().interval);
         timer_start_wave.setOnTimeOut(
             [&]() {
                 is_wave_started = true;
-                timer_spawn_event.setWaitTime(wave_list[index_wave].spawn_event_list[0].interval);
-                timer_spawn_event.restart();
-            });
-
-        timer_spawn_event.setOneShot(true);
-        timer_spawn_event.setOnTimeOut(
-            [&]() {
-                const auto& spawn_event_list = wave_list[index_wave].spawn_event_list;
-                const auto& spawn_event = spawn_event_list[index_spawn_event];
-
-                EnemyManager::instance()->spawnEnemy(spawn_event.enemy_type, spawn_event.spawn_point);
-
-                index_spawn_event++;
-                if (index_spawn_event >= spawn_event_list.size()) {
-                    is_spawned_last_event = true;
-                    return;
-                }
-
-                timer_spawn_event.setWaitTime(spawn_event_list[index_spawn_event].interval);
-                timer_spawn_event.restart();
+                time_wave = timer_start_wave.getOverflow();
             });
     }
     ~WaveManager() = default;
 
 private:
-    int index_wave = 0;          // 当前波次索引
-    int index_spawn_event = 0;    // 当前生成事件索引
+    static constexpr uint32_t PREWARM_LIMIT = 256;   // 每波最多预热的对象数，更多的在生成时按需分配
 
+    WaveTimelineReader reader;    // 波次时间线的读取器，保存当前波次与前瞻窗口
     Timer timer_start_wave;       // 控制波次开始的计时器
-    Timer timer_spawn_event;      // 控制敌人生成的计时器
+    double time_wave = 0;         // 当前波次开始后经过的时间
 
     bool is_wave_started = false;         // 当前波次是否已开始
     bool is_spawned_last_event = false;   // 是否已生成当前波次的最后一个敌人
+
+private:
+    /**
+     * @brief 生成所有已到生成时刻的敌人
+     * @param delta_time 时间增量
+     *
+     * 生成时刻相对波次开始，不随逐个事件的计时累积误差；
+     * 同一帧内到时的多个事件一并生成，各自只移动生成时刻之后的时间
+     */
+    void spawnDueEvents(double delta_time)
+    {
+        static const auto& wave_timeline = ConfigManager::instance()->wave_timeline;
+
+        while (const SpawnRecord* event = reader.peek()) {
+            if (event->time > time_wave)
+                return;
+
+            const double delay = std::clamp(delta_time - (time_wave - event->time), 0.0, delta_time);
+            EnemyManager::instance()->spawnEnemy(wave_timeline.getType(event->type), event->spawn_point, delay);
+            reader.pop();
+        }
+
+        is_spawned_last_event = true;
+    }
+
+    /**
+     * @brief 在波次间歇期(timer_start_wave计时期间)预热对象池
+     *
+     * 按即将开始的波次的生成事件数预热，每个敌人最多掉落一枚金币；
+     * 超长的波次只预热PREWARM_LIMIT个，避免对象池随关卡规模一次性膨胀
+     */
+    void prewarmWave()
+    {
+        const size_t count = std::min(reader.getWave().num_event, PREWARM_LIMIT);
+        EnemyManager::instance()->prewarm(count);
+        CoinManager::instance()->prewarm(count);
+    }
 };
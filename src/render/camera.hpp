@@ -0,0 +1,155 @@
+﻿#pragma once
+
+#include "../util/vector2.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief 摄像机，负责世界坐标与屏幕坐标之间的变换
+ * @details position为视口左上角对应的世界坐标，屏幕坐标 = (世界坐标 - position) * zoom。
+ *          视口不会移出地图范围；某一方向上地图小于视口时，地图在该方向上居中
+ */
+class Camera
+{
+public:
+    Camera() = default;
+    ~Camera() = default;
+
+    /**
+     * @brief 设置视口尺寸
+     * @param width 视口宽度(像素)
+     * @param height 视口高度(像素)
+     */
+    void setViewport(int width, int height)
+    {
+        size_viewport = { width, height };
+        clampPosition();
+    }
+
+    /**
+     * @brief 设置摄像机可移动的世界范围
+     * @param rect 世界范围，通常为地图区域
+     */
+    void setBounds(const SDL_Rect& rect)
+    {
+        rect_bounds = rect;
+        clampPosition();
+    }
+
+    /**
+     * @brief 使视口中心对准世界坐标中的一点
+     * @param position_world 世界坐标
+     */
+    void lookAt(const Vector2& position_world)
+    {
+        position = position_world - Vector2(size_viewport.x, size_viewport.y) * (0.5 / zoom);
+        clampPosition();
+    }
+
+    /**
+     * @brief 平移视口
+     * @param delta_screen 画面移动的屏幕距离，与拖拽方向一致
+     */
+    void pan(const Vector2& delta_screen)
+    {
+        position -= delta_screen * (1 / zoom);
+        clampPosition();
+    }
+
+    /**
+     * @brief 以屏幕上的一点为中心缩放，该点下的世界坐标保持不变
+     * @param position_screen 缩放中心的屏幕坐标
+     * @param factor 缩放倍数
+     */
+    void zoomAt(const Vector2& position_screen, double factor)
+    {
+        const Vector2 position_world = screenToWorld(position_screen);
+        zoom = std::clamp(zoom * factor, MIN_ZOOM, MAX_ZOOM);
+        position = position_world - position_screen * (1 / zoom);
+        clampPosition();
+    }
+
+    /**
+     * @brief 世界坐标转换为屏幕坐标
+     */
+    Vector2 worldToScreen(const Vector2& position_world) const
+    {
+        return (position_world - position) * zoom;
+    }
+
+    /**
+     * @brief 屏幕坐标转换为世界坐标
+     */
+    Vector2 screenToWorld(const Vector2& position_screen) const
+    {
+        return position + position_screen * (1 / zoom);
+    }
+
+    /**
+     * @brief 世界矩形转换为屏幕矩形
+     * @details 分别变换两条边再取差，相邻的矩形变换后仍然无缝拼接
+     */
+    SDL_Rect worldToScreen(const SDL_Rect& rect_world) const
+    {
+        const int x_min = (int)std::lround((rect_world.x - position.x) * zoom);
+        const int y_min = (int)std::lround((rect_world.y - position.y) * zoom);
+        const int x_max = (int)std::lround((rect_world.x + rect_world.w - position.x) * zoom);
+        const int y_max = (int)std::lround((rect_world.y + rect_world.h - position.y) * zoom);
+
+        return { x_min, y_min, x_max - x_min, y_max - y_min };
+    }
+
+    /**
+     * @brief 获取视口可见的世界区域
+     */
+    SDL_Rect getViewRect() const
+    {
+        return {
+            (int)std::floor(position.x),
+            (int)std::floor(position.y),
+            (int)std::ceil(size_viewport.x / zoom) + 1,
+            (int)std::ceil(size_viewport.y / zoom) + 1 };
+    }
+
+    /**
+     * @brief 屏幕矩形是否与视口相交
+     */
+    bool isVisible(const SDL_Rect& rect_screen) const
+    {
+        return rect_screen.x < size_viewport.x && rect_screen.x + rect_screen.w > 0
+            && rect_screen.y < size_viewport.y && rect_screen.y + rect_screen.h > 0;
+    }
+
+    double getZoom() const { return zoom; }
+
+private:
+    static constexpr double MIN_ZOOM = 0.25;    // 最小缩放倍数
+    static constexpr double MAX_ZOOM = 4.0;     // 最大缩放倍数
+
+    Vector2 position;                           // 视口左上角的世界坐标
+    double zoom = 1.0;                          // 缩放倍数
+    SDL_Point size_viewport = { 0, 0 };         // 视口尺寸
+    SDL_Rect rect_bounds = { 0, 0, 0, 0 };      // 可移动的世界范围
+
+private:
+    /**
+     * @brief 将视口限制在世界范围内，范围小于视口的方向上居中
+     */
+    void clampPosition()
+    {
+        const double width_view = size_viewport.x / zoom;
+        const double height_view = size_viewport.y / zoom;
+
+        if (width_view >= rect_bounds.w)
+            position.x = rect_bounds.x - (width_view - rect_bounds.w) / 2;
+        else
+            position.x = std::clamp(position.x, (double)rect_bounds.x, rect_bounds.x + rect_bounds.w - width_view);
+
+        if (height_view >= rect_bounds.h)
+            position.y = rect_bounds.y - (height_view - rect_bounds.h) / 2;
+        else
+            position.y = std::clamp(position.y, (double)rect_bounds.y, rect_bounds.y + rect_bounds.h - height_view);
+    }
+};
@@ -0,0 +1,176 @@
+﻿#pragma once
+
+#include "render_command.hpp"
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 字形图集
+ * @details 构建时把字体的可打印ASCII字符以白色渲染到一张纹理中，
+ *          绘制文本时每个字符生成一个四边形，颜色写入顶点颜色，
+ *          因此前景与阴影等不同颜色共用同一张图集，
+ *          文本内容变化时不再创建表面或纹理。图集之外的字符按空格处理
+ */
+class GlyphAtlas
+{
+public:
+    GlyphAtlas() = default;
+    ~GlyphAtlas() = default;
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    /**
+     * @brief 构建图集
+     * @param renderer SDL渲染器
+     * @param font 字体
+     * @return 构建成功返回true
+     */
+    bool build(SDL_Renderer* renderer, TTF_Font* font)
+    {
+        static const SDL_Color color_white = { 255, 255, 255, 255 };
+
+        std::vector<std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)>> surface_glyph_list;
+        surface_glyph_list.reserve(NUM_GLYPH);
+
+        // 按行排布字形，计算图集尺寸
+        int x = 0, y = 0, height_line = 0;
+        for (int i = 0; i < NUM_GLYPH; i++) {
+            const char str_glyph[2] = { (char)(FIRST_CHAR + i), '\0' };
+            Glyph& glyph = glyph_list[i];
+
+            int advance = 0;
+            TTF_GlyphMetrics(font, (Uint16)str_glyph[0], nullptr, nullptr, nullptr, nullptr, &advance);
+            glyph.advance = advance;
+
+            surface_glyph_list.emplace_back(TTF_RenderText_Blended(font, str_glyph, color_white), SDL_FreeSurface);
+            SDL_Surface* surface = surface_glyph_list.back().get();
+            if (!surface)
+                continue;
+
+            if (x + surface->w + PADDING > ATLAS_WIDTH) {
+                x = 0;
+                y += height_line + PADDING;
+                height_line = 0;
+            }
+
+            glyph.rect = { x, y, surface->w, surface->h };
+            x += surface->w + PADDING;
+            height_line = std::max(height_line, surface->h);
+        }
+
+        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface_atlas(
+            SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, y + height_line, 32, SDL_PIXELFORMAT_ARGB8888), SDL_FreeSurface);
+        if (!surface_atlas) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"创建字形图集表面失败: %s", SDL_GetError());
+            return false;
+        }
+        SDL_FillRect(surface_atlas.get(), nullptr, 0);
+
+        // 直接复制字形的透明度，不与图集背景混合
+        for (int i = 0; i < NUM_GLYPH; i++) {
+            SDL_Surface* surface = surface_glyph_list[i].get();
+            if (!surface)
+                continue;
+
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surface, nullptr, surface_atlas.get(), &glyph_list[i].rect);
+        }
+
+        texture.reset(SDL_CreateTextureFromSurface(renderer, surface_atlas.get()));
+        if (!texture) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"创建字形图集纹理失败: %s", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+
+        size_atlas = { ATLAS_WIDTH, y + height_line };
+        return true;
+    }
+
+    /**
+     * @brief 计算文本宽度
+     * @param text 文本内容
+     */
+    int measure(const char* text) const
+    {
+        int width = 0;
+        for (const char* c = text; *c != '\0'; c++)
+            width += getGlyph(*c).advance;
+
+        return width;
+    }
+
+    /**
+     * @brief 将文本的四边形追加到顶点与索引列表
+     * @param text 文本内容
+     * @param color 颜色
+     * @param position 对齐点x与文本上边界y
+     * @param align 水平对齐方式
+     * @param vertex_list 顶点列表
+     * @param index_list 索引列表
+     */
+    void appendText(const char* text, const SDL_Color& color, const SDL_Point& position, TextAlign align,
+        std::vector<SDL_Vertex>& vertex_list, std::vector<int>& index_list) const
+    {
+        int x = position.x;
+        if (align == TextAlign::Center)
+            x -= measure(text) / 2;
+
+        const float u_scale = 1.0f / size_atlas.x, v_scale = 1.0f / size_atlas.y;
+        for (const char* c = text; *c != '\0'; c++) {
+            const Glyph& glyph = getGlyph(*c);
+            if (glyph.rect.w > 0 && *c != ' ') {
+                const float x_min = (float)x, x_max = (float)(x + glyph.rect.w);
+                const float y_min = (float)position.y, y_max = (float)(position.y + glyph.rect.h);
+                const float u_min = glyph.rect.x * u_scale, u_max = (glyph.rect.x + glyph.rect.w) * u_scale;
+                const float v_min = glyph.rect.y * v_scale, v_max = (glyph.rect.y + glyph.rect.h) * v_scale;
+
+                const int index_base = (int)vertex_list.size();
+                vertex_list.push_back({ { x_min, y_min }, color, { u_min, v_min } });
+                vertex_list.push_back({ { x_max, y_min }, color, { u_max, v_min } });
+                vertex_list.push_back({ { x_max, y_max }, color, { u_max, v_max } });
+                vertex_list.push_back({ { x_min, y_max }, color, { u_min, v_max } });
+
+                for (int offset : { 0, 1, 2, 0, 2, 3 })
+                    index_list.push_back(index_base + offset);
+            }
+
+            x += glyph.advance;
+        }
+    }
+
+    SDL_Texture* getTexture() const { return texture.get(); }  // 图集纹理
+
+private:
+    /**
+     * @brief 字形在图集中的位置与排版信息
+     */
+    struct Glyph
+    {
+        SDL_Rect rect = { 0, 0, 0, 0 }; // 在图集中的矩形
+        int advance = 0;                // 水平步进
+    };
+
+    static constexpr char FIRST_CHAR = ' ';                 // 图集中的第一个字符
+    static constexpr int NUM_GLYPH = '~' - ' ' + 1;         // 图集中的字符数
+    static constexpr int ATLAS_WIDTH = 512;                 // 图集宽度
+    static constexpr int PADDING = 1;                       // 字形之间的间隔
+
+    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture{ nullptr, SDL_DestroyTexture };
+    SDL_Point size_atlas = { 1, 1 };                        // 图集尺寸
+    Glyph glyph_list[NUM_GLYPH];                            // 所有字形
+
+private:
+    const Glyph& getGlyph(char c) const
+    {
+        if (c < FIRST_CHAR || c >= FIRST_CHAR + NUM_GLYPH)
+            c = ' ';
+
+        return glyph_list[c - FIRST_CHAR];
+    }
+};
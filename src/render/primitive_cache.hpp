@@ -0,0 +1,236 @@
+﻿#pragma once
+
+#include <SDL.h>
+#include <SDL2_gfxPrimitives.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @brief 可缓存的图元形状
+ */
+enum class PrimitiveShape : uint8_t
+{
+    FillCircle,     // 填充圆形
+    DrawCircle,     // 抗锯齿圆形边框
+    FillRoundedBox  // 填充圆角矩形
+};
+
+/**
+ * @brief 预光栅化图元缓存
+ * @details 图元第一次使用时用软件渲染器以白色光栅化到表面，再创建为纹理，
+ *          之后以一次纹理复制绘制，颜色与透明度通过纹理的颜色调制实现，
+ *          因此缓存键只包含形状与尺寸。尺寸由调用者按quantize()量化后请求，
+ *          绘制时把纹理缩放到实际区域，连续变化的尺寸只落入有限个缓存项。
+ *          新纹理放不进预算时先按最近最少使用的顺序释放，本帧用到的纹理不会被释放，
+ *          仍然放不下时拒绝缓存，由调用者直接绘制。光栅化不切换渲染目标，可以在一帧中的任意时刻进行
+ */
+class PrimitiveCache
+{
+public:
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats
+    {
+        size_t num_resident = 0;    // 常驻纹理数
+        size_t size_resident = 0;   // 常驻纹理大小(字节)
+        size_t num_hit = 0;         // 累计命中次数
+        size_t num_miss = 0;        // 累计光栅化次数
+        size_t num_evict = 0;       // 累计释放次数
+    };
+
+public:
+    PrimitiveCache() = default;
+    ~PrimitiveCache() = default;
+
+    PrimitiveCache(const PrimitiveCache&) = delete;
+    PrimitiveCache& operator=(const PrimitiveCache&) = delete;
+
+    /**
+     * @brief 设置渲染器并清空缓存
+     * @param renderer SDL渲染器
+     */
+    void setRenderer(SDL_Renderer* renderer)
+    {
+        this->renderer = renderer;
+        entry_pool.clear();
+        lru_list.clear();
+        stats.num_resident = 0;
+        stats.size_resident = 0;
+    }
+
+    /**
+     * @brief 设置纹理大小预算
+     * @param size_budget 纹理大小预算(字节)
+     */
+    void setBudget(size_t size_budget) { this->size_budget = size_budget; }
+
+    /**
+     * @brief 把尺寸量化到缓存桶
+     * @param size 尺寸(像素)
+     * @return 不小于size的桶尺寸，16像素以内不量化，之后每翻一倍步长翻一倍，
+     *         缩放误差不超过1/16
+     */
+    static int quantize(int size)
+    {
+        int step = 1;
+        while (size > 16 * step)
+            step *= 2;
+
+        return (size + step - 1) / step * step;
+    }
+
+    /**
+     * @brief 获取图元纹理，未缓存时立即光栅化
+     * @param shape 形状
+     * @param width 宽度，圆形的圆心位于纹理中心
+     * @param height 高度
+     * @param radius 圆形半径或圆角半径
+     * @return 白色的图元纹理，失败或纹理大小超出预算时返回nullptr
+     */
+    SDL_Texture* acquire(PrimitiveShape shape, int width, int height, int radius)
+    {
+        if (width <= 0 || height <= 0 || width > MAX_SIZE || height > MAX_SIZE)
+            return nullptr;
+
+        const uint64_t key = ((uint64_t)shape << 48) | ((uint64_t)width << 32) | ((uint64_t)height << 16) | (uint16_t)radius;
+
+        auto itor = entry_pool.find(key);
+        if (itor != entry_pool.end()) {
+            Entry& entry = itor->second;
+            lru_list.splice(lru_list.begin(), lru_list, entry.it_lru);
+            entry.frame_used = index_frame;
+            stats.num_hit++;
+            return entry.texture.get();
+        }
+
+        const size_t size = (size_t)width * height * 4;
+        if (!reserve(size))
+            return nullptr;
+
+        SDL_Texture* texture = rasterize(shape, width, height, radius);
+        if (!texture)
+            return nullptr;
+
+        Entry& entry = entry_pool[key];
+        entry.texture.reset(texture);
+        entry.size = size;
+        entry.frame_used = index_frame;
+        lru_list.push_front(key);
+        entry.it_lru = lru_list.begin();
+
+        stats.num_resident++;
+        stats.size_resident += entry.size;
+        stats.num_miss++;
+
+        return texture;
+    }
+
+    /**
+     * @brief 结束一帧，释放超出预算的纹理(预算在运行中被调小时)
+     */
+    void endFrame()
+    {
+        reserve(0);
+        index_frame++;
+    }
+
+    const Stats& getStats() const { return stats; }     // 缓存统计
+
+private:
+    /**
+     * @brief 缓存的图元纹理
+     */
+    struct Entry
+    {
+        std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture{ nullptr, SDL_DestroyTexture };
+        size_t size = 0;                            // 纹理大小(字节)
+        uint64_t frame_used = 0;                    // 最近一次使用的帧序号
+        std::list<uint64_t>::iterator it_lru;       // 在LRU链表中的位置
+    };
+
+    static constexpr int MAX_SIZE = 4096;           // 可缓存图元的最大边长
+
+    SDL_Renderer* renderer = nullptr;               // 创建纹理的渲染器
+    size_t size_budget = 16 * 1024 * 1024;          // 纹理大小预算(字节)
+    std::unordered_map<uint64_t, Entry> entry_pool; // 所有缓存的纹理
+    std::list<uint64_t> lru_list;                   // 缓存键，链表头为最近使用
+    uint64_t index_frame = 0;                       // 当前帧序号
+    Stats stats;                                    // 缓存统计
+
+private:
+    /**
+     * @brief 按最近最少使用的顺序释放纹理，为新纹理腾出预算
+     * @param size 新纹理的大小(字节)
+     * @return 腾出足够空间返回true；新纹理超出预算，或需要释放本帧用到的纹理时返回false
+     */
+    bool reserve(size_t size)
+    {
+        if (size > size_budget)
+            return false;
+
+        while (stats.size_resident + size > size_budget && !lru_list.empty()) {
+            auto itor = entry_pool.find(lru_list.back());
+            if (itor->second.frame_used == index_frame)
+                return false;
+
+            stats.size_resident -= itor->second.size;
+            stats.num_resident--;
+            stats.num_evict++;
+            entry_pool.erase(itor);
+            lru_list.pop_back();
+        }
+
+        return stats.size_resident + size <= size_budget;
+    }
+
+    /**
+     * @brief 用软件渲染器光栅化白色图元并创建纹理
+     * @details 抗锯齿边缘以透明度表示覆盖率，光栅化后把所有像素的颜色统一为白色，
+     *          避免混合到透明背景上得到的预乘颜色使边缘变暗
+     */
+    SDL_Texture* rasterize(PrimitiveShape shape, int width, int height, int radius)
+    {
+        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface(
+            SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888), SDL_FreeSurface);
+        if (!surface)
+            return nullptr;
+        SDL_FillRect(surface.get(), nullptr, 0);
+
+        std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> renderer_software(
+            SDL_CreateSoftwareRenderer(surface.get()), SDL_DestroyRenderer);
+        if (!renderer_software)
+            return nullptr;
+
+        switch (shape) {
+        case PrimitiveShape::FillCircle:
+            filledCircleRGBA(renderer_software.get(), width / 2, height / 2, radius, 255, 255, 255, 255);
+            break;
+        case PrimitiveShape::DrawCircle:
+            aacircleRGBA(renderer_software.get(), width / 2, height / 2, radius, 255, 255, 255, 255);
+            break;
+        case PrimitiveShape::FillRoundedBox:
+            roundedBoxRGBA(renderer_software.get(), 0, 0, width - 1, height - 1, radius, 255, 255, 255, 255);
+            break;
+        }
+        SDL_RenderPresent(renderer_software.get());
+
+        SDL_LockSurface(surface.get());
+        for (int y = 0; y < height; y++) {
+            Uint32* pixel_list = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+            for (int x = 0; x < width; x++)
+                pixel_list[x] |= 0x00FFFFFF;
+        }
+        SDL_UnlockSurface(surface.get());
+
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface.get());
+        if (texture) {
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+        }
+
+        return texture;
+    }
+};
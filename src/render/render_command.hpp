@@ -0,0 +1,98 @@
+﻿#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <cstdint>
+
+/**
+ * @brief 渲染命令类型
+ */
+enum class RenderCommandType : uint8_t
+{
+    Texture,        // 绘制纹理(可旋转)
+    FillRect,       // 填充矩形
+    DrawRect,       // 矩形边框
+    FillCircle,     // 填充圆形
+    DrawCircle,     // 抗锯齿圆形边框
+    FillRoundedBox, // 填充圆角矩形
+    Text,           // 文本
+    TileChunk,      // 瓦片地图区块
+    Sprites,        // 使用同一纹理的一批方形精灵
+    Retained        // 保留层：缓存在目标纹理中的一组命令
+};
+
+/**
+ * @brief 渲染层，按从下到上的顺序排列
+ * @details Actor与Air层内按脚底y坐标从小到大绘制，y相同时按纹理分组；
+ *          其余层保持命令的追加顺序
+ */
+enum class RenderLayer : uint8_t
+{
+    Map,        // 地图
+    Actor,      // 地面上的对象：敌人、防御塔、金币与玩家
+    Air,        // 空中的对象：子弹与技能特效
+    Overlay,    // 对象上方的信息：血条与选择面板
+    UI          // 屏幕坐标的界面
+};
+
+/**
+ * @brief 保留层ID，每个缓存在目标纹理中的界面部件对应一个
+ */
+enum class RetainedID : uint32_t
+{
+    StatusBar   // 状态栏
+};
+
+/**
+ * @brief 文本水平对齐方式
+ */
+enum class TextAlign : uint8_t
+{
+    Left,   // 以给定位置为左边界
+    Center  // 以给定位置为水平中心
+};
+
+/**
+ * @brief 渲染命令
+ * @details 只保存绘制所需的纯数据，由逻辑线程生成、渲染端执行，
+ *          执行时不再访问任何游戏对象。
+ *          各类型对字段的使用：
+ *          - Texture：texture、rect_src(has_rect_src为false时使用整张纹理)、rect_dst、angle，
+ *                     is_flash为true时在原图上以叠加混合再绘制，提亮不透明部分作为受击闪白
+ *          - FillRect/DrawRect：rect_dst、color
+ *          - FillCircle/DrawCircle：rect_dst.x/y为圆心，radius为半径，color
+ *          - FillRoundedBox：rect_dst、radius为圆角半径，color
+ *          - Text：font、offset_text为文本在字符串缓冲区中的偏移，
+ *                  rect_dst.x/y为对齐点与上边界，align，color
+ *          - TileChunk：index_chunk为区块索引，rect_dst；纹理由渲染端的区块缓存提供
+ *          - Sprites：texture，offset_vertex与num_vertex为顶点缓冲区中的一段，每个精灵4个顶点
+ *          - Retained：id_retained为保留层ID，version_retained为内容版本，
+ *                      num_retained为紧随其后的内容命令数，rect_dst为保留层在屏幕上的区域
+ */
+struct RenderCommand
+{
+    RenderCommandType type = RenderCommandType::Texture;   // 命令类型
+    TextAlign align = TextAlign::Left;                      // 文本对齐方式
+    bool has_rect_src = false;                              // 是否指定源矩形
+    bool is_retained = false;                               // 是否为保留层的内容，只在重绘保留层时执行
+    bool is_flash = false;                                  // 纹理是否叠加受击闪白
+    SDL_Color color = { 0, 0, 0, 0 };                       // 颜色
+    int radius = 0;                                         // 圆形半径或圆角半径
+    uint32_t offset_text = 0;                               // 文本偏移
+    SDL_Rect rect_src = { 0, 0, 0, 0 };                     // 源矩形
+    SDL_Rect rect_dst = { 0, 0, 0, 0 };                     // 目标矩形
+    double angle = 0;                                       // 旋转角度
+    uint64_t key = 0;                                       // 排序键：层(8位)|y(24位)|纹理(32位)
+    uint32_t version_retained = 0;                          // 保留层内容版本
+    uint32_t num_retained = 0;                              // 保留层内容命令数
+    uint32_t offset_vertex = 0;                             // 精灵批次在顶点缓冲区中的偏移
+    uint32_t num_vertex = 0;                                // 精灵批次的顶点数
+
+    union
+    {
+        SDL_Texture* texture = nullptr;                     // 纹理
+        TTF_Font* font;                                     // 字体
+        uint32_t index_chunk;                               // 瓦片地图区块索引
+        uint32_t id_retained;                               // 保留层ID
+    };
+};
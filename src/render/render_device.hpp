@@ -0,0 +1,356 @@
+﻿#pragma once
+
+#include "glyph_atlas.hpp"
+#include "primitive_cache.hpp"
+#include "render_list.hpp"
+#include "tile_chunk_cache.hpp"
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <SDL2_gfxPrimitives.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 渲染设备，在SDL渲染器上执行渲染命令列表
+ * @details 只能在创建渲染器的线程中使用。
+ *          文本由各字体的字形图集绘制，连续的同字体文本命令合并为一次几何绘制；
+ *          圆形与圆角矩形由预光栅化图元缓存以一次纹理复制绘制
+ */
+class RenderDevice
+{
+public:
+    RenderDevice() = default;
+    ~RenderDevice() = default;
+
+    RenderDevice(const RenderDevice&) = delete;
+    RenderDevice& operator=(const RenderDevice&) = delete;
+
+    /**
+     * @brief 设置目标渲染器
+     * @param renderer SDL渲染器
+     */
+    void setRenderer(SDL_Renderer* renderer)
+    {
+        this->renderer = renderer;
+        glyph_atlas_pool.clear();
+        primitive_cache.setRenderer(renderer);
+    }
+
+    /**
+     * @brief 设置提供瓦片地图区块纹理的缓存
+     * @param tile_chunk_cache 区块缓存
+     */
+    void setTileChunkCache(TileChunkCache* tile_chunk_cache)
+    {
+        this->tile_chunk_cache = tile_chunk_cache;
+    }
+
+    /**
+     * @brief 准备执行列表所需的资源：烘焙本帧可见但尚未缓存的区块，重绘版本变化的保留层
+     * @param render_list 渲染命令列表
+     * @details 两者都需要切换渲染目标，应在清屏之前调用
+     */
+    void prepare(const RenderList& render_list)
+    {
+        const auto& command_list = render_list.getCommandList();
+
+        for (size_t i = 0; i < command_list.size(); i++) {
+            const RenderCommand& command = command_list[i];
+
+            if (command.type == RenderCommandType::TileChunk && tile_chunk_cache)
+                tile_chunk_cache->acquire(command.index_chunk);
+            else if (command.type == RenderCommandType::Retained) {
+                redrawRetained(command, render_list, i + 1);
+                i += command.num_retained;
+            }
+        }
+    }
+
+    /**
+     * @brief 执行列表中的所有命令
+     * @param render_list 渲染命令列表
+     * @details 列表已排序时按排序结果执行，否则按追加顺序执行；
+     *          保留层以一次纹理复制绘制，其内容命令在此跳过
+     */
+    void execute(const RenderList& render_list)
+    {
+        const auto& command_list = render_list.getCommandList();
+        const bool is_sorted = render_list.isSorted();
+
+        for (size_t i = 0; i < command_list.size(); i++) {
+            const RenderCommand& command = is_sorted ? render_list.getSortedCommand(i) : command_list[i];
+            if (!command.is_retained)
+                executeCommand(command, render_list);
+        }
+
+        flushText();
+
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        if (tile_chunk_cache)
+            tile_chunk_cache->endFrame();
+        primitive_cache.endFrame();
+    }
+
+    /**
+     * @brief 获取保留层累计的重绘次数
+     * @param id 保留层ID
+     */
+    size_t getRetainedRedrawCount(RetainedID id) const
+    {
+        auto itor = retained_pool.find((uint32_t)id);
+        return itor == retained_pool.end() ? 0 : itor->second.num_redraw;
+    }
+
+    const PrimitiveCache::Stats& getPrimitiveCacheStats() const { return primitive_cache.getStats(); }   // 图元缓存统计
+
+private:
+    /**
+     * @brief 缓存的保留层
+     */
+    struct RetainedLayer
+    {
+        std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture{ nullptr, SDL_DestroyTexture };
+        uint32_t version = 0;       // 纹理内容对应的版本
+        size_t num_redraw = 0;      // 累计重绘次数
+    };
+
+    SDL_Renderer* renderer = nullptr;                       // 目标渲染器
+    TileChunkCache* tile_chunk_cache = nullptr;             // 瓦片地图区块缓存
+    std::unordered_map<TTF_Font*, std::unique_ptr<GlyphAtlas>> glyph_atlas_pool; // 各字体的字形图集，构建失败时为nullptr
+    TTF_Font* font_batch = nullptr;                         // 当前文本批次的字体
+    std::vector<SDL_Vertex> vertex_list;                    // 当前文本批次的顶点
+    std::vector<int> index_list;                            // 当前文本批次的索引
+    std::unordered_map<uint32_t, RetainedLayer> retained_pool; // 各保留层的缓存
+    PrimitiveCache primitive_cache;                         // 预光栅化图元缓存
+    std::vector<int> index_quad_list;                       // 精灵批次共用的四边形索引
+
+private:
+    /**
+     * @brief 执行一条命令
+     */
+    void executeCommand(const RenderCommand& command, const RenderList& render_list)
+    {
+        const SDL_Rect& rect = command.rect_dst;
+        const SDL_Color& color = command.color;
+
+        // 文本批次遇到其他命令或其他字体时提交
+        if (command.type != RenderCommandType::Text || command.font != font_batch)
+            flushText();
+
+        switch (command.type) {
+        case RenderCommandType::Texture:
+            SDL_RenderCopyEx(renderer, command.texture, command.has_rect_src ? &command.rect_src : nullptr,
+                &rect, command.angle, nullptr, SDL_RendererFlip::SDL_FLIP_NONE);
+            if (command.is_flash)
+                drawFlash(command);
+            break;
+        case RenderCommandType::FillRect:
+            setDrawColor(color);
+            SDL_RenderFillRect(renderer, &rect);
+            break;
+        case RenderCommandType::DrawRect:
+            setDrawColor(color);
+            SDL_RenderDrawRect(renderer, &rect);
+            break;
+        case RenderCommandType::FillCircle:
+            if (!drawPrimitive(PrimitiveShape::FillCircle, { rect.x - command.radius - 1, rect.y - command.radius - 1,
+                command.radius * 2 + 3, command.radius * 2 + 3 }, command.radius, color))
+                filledCircleRGBA(renderer, rect.x, rect.y, command.radius, color.r, color.g, color.b, color.a);
+            break;
+        case RenderCommandType::DrawCircle:
+            if (!drawPrimitive(PrimitiveShape::DrawCircle, { rect.x - command.radius - 1, rect.y - command.radius - 1,
+                command.radius * 2 + 3, command.radius * 2 + 3 }, command.radius, color))
+                aacircleRGBA(renderer, rect.x, rect.y, command.radius, color.r, color.g, color.b, color.a);
+            break;
+        case RenderCommandType::FillRoundedBox:
+            if (!drawPrimitive(PrimitiveShape::FillRoundedBox, { rect.x, rect.y, rect.w + 1, rect.h + 1 }, command.radius, color))
+                roundedBoxRGBA(renderer, rect.x, rect.y, rect.x + rect.w, rect.y + rect.h, command.radius, color.r, color.g, color.b, color.a);
+            break;
+        case RenderCommandType::Text:
+            appendText(command, render_list.getText(command));
+            break;
+        case RenderCommandType::Sprites:
+            drawSprites(command, render_list);
+            break;
+        case RenderCommandType::TileChunk:
+            if (SDL_Texture* texture = tile_chunk_cache ? tile_chunk_cache->acquire(command.index_chunk) : nullptr)
+                SDL_RenderCopy(renderer, texture, nullptr, &rect);
+            break;
+        case RenderCommandType::Retained:
+        {
+            auto itor = retained_pool.find(command.id_retained);
+            if (itor != retained_pool.end() && itor->second.texture)
+                SDL_RenderCopy(renderer, itor->second.texture.get(), nullptr, &rect);
+        }
+            break;
+        }
+    }
+
+    /**
+     * @brief 版本变化时把保留层的内容重绘到其目标纹理
+     * @param command 保留层命令
+     * @param render_list 渲染命令列表
+     * @param index_begin 第一条内容命令的下标
+     * @details 内容先以普通混合绘制到透明纹理上，得到预乘透明度的颜色，
+     *          因此复制到屏幕时使用预乘透明度的混合方式
+     */
+    void redrawRetained(const RenderCommand& command, const RenderList& render_list, size_t index_begin)
+    {
+        static const SDL_BlendMode BLEND_PREMULTIPLIED = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+        RetainedLayer& layer = retained_pool[command.id_retained];
+
+        int width = 0, height = 0;
+        if (layer.texture)
+            SDL_QueryTexture(layer.texture.get(), nullptr, nullptr, &width, &height);
+
+        if (layer.texture && layer.version == command.version_retained && width == command.rect_dst.w && height == command.rect_dst.h)
+            return;
+
+        if (!layer.texture || width != command.rect_dst.w || height != command.rect_dst.h) {
+            layer.texture.reset(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                command.rect_dst.w, command.rect_dst.h));
+            if (!layer.texture) {
+                SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"创建保留层纹理失败: %s", SDL_GetError());
+                return;
+            }
+
+            if (SDL_SetTextureBlendMode(layer.texture.get(), BLEND_PREMULTIPLIED) < 0)
+                SDL_SetTextureBlendMode(layer.texture.get(), SDL_BLENDMODE_BLEND);
+        }
+
+        SDL_Texture* target_last = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, layer.texture.get());
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+
+        const auto& command_list = render_list.getCommandList();
+        for (size_t i = index_begin; i < index_begin + command.num_retained && i < command_list.size(); i++)
+            executeCommand(command_list[i], render_list);
+        flushText();
+
+        SDL_SetRenderTarget(renderer, target_last);
+
+        layer.version = command.version_retained;
+        layer.num_redraw++;
+    }
+
+    /**
+     * @brief 在纹理原图上叠加受击闪白
+     * @details 以叠加混合把同一纹理再绘制数次，不透明部分的颜色按自身颜色成倍提亮(在255处截断)，
+     *          透明部分不变。这只是提亮而不是纯白剪影：亮色像素接近白色，暗色像素仍保留原有色调
+     */
+    void drawFlash(const RenderCommand& command)
+    {
+        static const int NUM_FLASH_PASS = 2;
+
+        SDL_SetTextureBlendMode(command.texture, SDL_BLENDMODE_ADD);
+        for (int i = 0; i < NUM_FLASH_PASS; i++)
+            SDL_RenderCopyEx(renderer, command.texture, command.has_rect_src ? &command.rect_src : nullptr,
+                &command.rect_dst, command.angle, nullptr, SDL_RendererFlip::SDL_FLIP_NONE);
+        SDL_SetTextureBlendMode(command.texture, SDL_BLENDMODE_BLEND);
+    }
+
+    /**
+     * @brief 以一次几何绘制提交精灵批次
+     * @details 所有批次共用同一份四边形索引，只在精灵数超过已有索引时扩充
+     */
+    void drawSprites(const RenderCommand& command, const RenderList& render_list)
+    {
+        const size_t num_sprite = command.num_vertex / 4;
+        for (int i = (int)(index_quad_list.size() / 6); i < (int)num_sprite; i++) {
+            const int base = i * 4;
+            index_quad_list.insert(index_quad_list.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+
+        SDL_RenderGeometry(renderer, command.texture, render_list.getVertex(command), (int)command.num_vertex,
+            index_quad_list.data(), (int)(num_sprite * 6));
+    }
+
+    /**
+     * @brief 以缓存的白色图元纹理绘制图元，颜色通过纹理的颜色调制实现
+     * @param shape 形状
+     * @param rect 纹理在屏幕上的区域，圆形的纹理四周各留出1像素的抗锯齿边缘
+     * @param radius 圆形半径或圆角半径
+     * @param color 颜色
+     * @return 纹理不可用或超出缓存预算时返回false，由调用者直接绘制
+     * @details 圆形按量化后的半径、圆角矩形按量化后的宽高光栅化，再缩放到实际区域
+     */
+    bool drawPrimitive(PrimitiveShape shape, const SDL_Rect& rect, int radius, const SDL_Color& color)
+    {
+        if (rect.w <= 1 || rect.h <= 1 || radius < 0)
+            return true;
+
+        SDL_Texture* texture = nullptr;
+        if (shape == PrimitiveShape::FillRoundedBox) {
+            texture = primitive_cache.acquire(shape, PrimitiveCache::quantize(rect.w), PrimitiveCache::quantize(rect.h), radius);
+        }
+        else {
+            const int radius_bucket = PrimitiveCache::quantize(radius);
+            texture = primitive_cache.acquire(shape, radius_bucket * 2 + 3, radius_bucket * 2 + 3, radius_bucket);
+        }
+        if (!texture)
+            return false;
+
+        SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+        SDL_SetTextureAlphaMod(texture, color.a);
+        SDL_RenderCopy(renderer, texture, nullptr, &rect);
+
+        return true;
+    }
+
+    void setDrawColor(const SDL_Color& color)
+    {
+        SDL_SetRenderDrawBlendMode(renderer, color.a < 255 ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    }
+
+    /**
+     * @brief 获取字体的字形图集，第一次使用时构建
+     */
+    GlyphAtlas* getGlyphAtlas(TTF_Font* font)
+    {
+        auto itor = glyph_atlas_pool.find(font);
+        if (itor != glyph_atlas_pool.end())
+            return itor->second.get();
+
+        auto glyph_atlas = std::make_unique<GlyphAtlas>();
+        if (!glyph_atlas->build(renderer, font))
+            glyph_atlas.reset();
+
+        return glyph_atlas_pool.emplace(font, std::move(glyph_atlas)).first->second.get();
+    }
+
+    /**
+     * @brief 将文本加入当前批次
+     */
+    void appendText(const RenderCommand& command, const char* text)
+    {
+        const GlyphAtlas* glyph_atlas = command.font ? getGlyphAtlas(command.font) : nullptr;
+        if (!glyph_atlas)
+            return;
+
+        font_batch = command.font;
+        glyph_atlas->appendText(text, command.color, { command.rect_dst.x, command.rect_dst.y },
+            command.align, vertex_list, index_list);
+    }
+
+    /**
+     * @brief 以一次几何绘制提交当前文本批次
+     */
+    void flushText()
+    {
+        if (!index_list.empty())
+            SDL_RenderGeometry(renderer, getGlyphAtlas(font_batch)->getTexture(), vertex_list.data(), (int)vertex_list.size(),
+                index_list.data(), (int)index_list.size());
+
+        font_batch = nullptr;
+        vertex_list.clear();
+        index_list.clear();
+    }
+};
@@ -0,0 +1,440 @@
+﻿#pragma once
+
+#include "render_command.hpp"
+#include "camera.hpp"
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 渲染命令列表
+ * @details 游戏对象的onRender()向列表追加命令而不是直接调用SDL，
+ *          每条命令带有由当前渲染层、排序y坐标与纹理打包成的64位排序键，
+ *          sort()以基数排序按键稳定排序，执行时先绘制键小的命令。
+ *          UI以外的层使用世界坐标，追加时经摄像机变换到屏幕坐标，
+ *          完全位于视口之外的命令直接丢弃，不产生绘制调用。
+ *          界面部件可以把命令放在beginRetained()与endRetained()之间组成保留层，
+ *          渲染端把它们缓存在目标纹理中，只在版本变化时重绘。
+ *          文本统一存放在一段字符串缓冲区中，精灵批次的顶点存放在顶点缓冲区中，命令只记录偏移，
+ *          清空后容量保留，稳定运行时不再产生堆分配
+ */
+class RenderList
+{
+public:
+    RenderList() = default;
+    ~RenderList() = default;
+
+    /**
+     * @brief 清空所有命令，保留已分配的容量
+     */
+    void clear()
+    {
+        command_list.clear();
+        text_buffer.clear();
+        vertex_buffer.clear();
+        sort_list.clear();
+        is_sorted = false;
+        index_retained = NO_RETAINED;
+        setLayer(RenderLayer::UI);
+    }
+
+    /**
+     * @brief 设置世界坐标层使用的摄像机
+     * @param camera 摄像机，列表保存其副本
+     */
+    void setCamera(const Camera& camera)
+    {
+        this->camera = camera;
+    }
+
+    /**
+     * @brief 设置之后追加的命令所在的渲染层
+     * @param layer 渲染层
+     * @param y 排序用的y坐标，通常为对象的脚底位置；只在按y排序的层中生效
+     */
+    void setLayer(RenderLayer layer, int y = 0)
+    {
+        is_y_sorted = (layer == RenderLayer::Actor || layer == RenderLayer::Air);
+        is_world = (layer != RenderLayer::UI);
+
+        key_current = (uint64_t)layer << 56;
+        if (is_y_sorted) {
+            y = std::clamp(y, -Y_BIAS, Y_BIAS - 1);
+            key_current |= (uint64_t)(y + Y_BIAS) << 32;
+        }
+    }
+
+    /**
+     * @brief 开始记录保留层
+     * @param id 保留层ID
+     * @param version 内容版本，与渲染端缓存的版本不同时重绘
+     * @param rect 保留层在屏幕上的区域，内容命令使用屏幕坐标且不应超出该区域
+     * @details 只能在界面层中使用，保留层不能嵌套
+     */
+    void beginRetained(RetainedID id, uint32_t version, const SDL_Rect& rect)
+    {
+        RenderCommand& command = append(RenderCommandType::Retained);
+        command.id_retained = (uint32_t)id;
+        command.version_retained = version;
+        command.rect_dst = rect;
+
+        index_retained = command_list.size() - 1;
+        origin_retained = { rect.x, rect.y };
+    }
+
+    /**
+     * @brief 结束记录保留层
+     */
+    void endRetained()
+    {
+        if (index_retained == NO_RETAINED)
+            return;
+
+        command_list[index_retained].num_retained = (uint32_t)(command_list.size() - index_retained - 1);
+        index_retained = NO_RETAINED;
+    }
+
+    /**
+     * @brief 按排序键对命令稳定排序
+     * @details 8位一趟的LSD基数排序，一次遍历统计所有趟的直方图，
+     *          所有键在某一字节上都相同时跳过该趟。
+     *          排序的是(键, 下标)对，命令本身不移动
+     */
+    void sort()
+    {
+        const size_t num = command_list.size();
+        sort_list.resize(num);
+        sort_buffer.resize(num);
+
+        for (size_t i = 0; i < num; i++)
+            sort_list[i] = { command_list[i].key, (uint32_t)i };
+
+        size_t count_list[8][256] = {};
+        for (const SortEntry& entry : sort_list) {
+            for (int pass = 0; pass < 8; pass++)
+                count_list[pass][(entry.key >> (pass * 8)) & 0xFF]++;
+        }
+
+        for (int pass = 0; pass < 8; pass++) {
+            size_t* count = count_list[pass];
+            const int shift = pass * 8;
+
+            if (num == 0 || count[(sort_list[0].key >> shift) & 0xFF] == num)
+                continue;
+
+            size_t offset = 0;
+            for (int i = 0; i < 256; i++) {
+                const size_t num_bucket = count[i];
+                count[i] = offset;
+                offset += num_bucket;
+            }
+
+            for (const SortEntry& entry : sort_list)
+                sort_buffer[count[(entry.key >> shift) & 0xFF]++] = entry;
+
+            sort_list.swap(sort_buffer);
+        }
+
+        is_sorted = true;
+    }
+
+    /**
+     * @brief 绘制纹理
+     * @param texture 纹理
+     * @param rect_src 源矩形，为nullptr时使用整张纹理
+     * @param rect_dst 目标矩形
+     * @param angle 顺时针旋转角度(默认为0)
+     * @param is_flash 是否叠加受击闪白(默认为false)
+     */
+    void drawTexture(SDL_Texture* texture, const SDL_Rect* rect_src, const SDL_Rect& rect_dst, double angle = 0, bool is_flash = false)
+    {
+        SDL_Rect rect = rect_dst;
+        if (!toScreen(rect, angle != 0))
+            return;
+
+        RenderCommand& command = append(RenderCommandType::Texture);
+        command.texture = texture;
+        command.has_rect_src = (rect_src != nullptr);
+        if (rect_src)
+            command.rect_src = *rect_src;
+        command.rect_dst = rect;
+        command.angle = angle;
+        command.is_flash = is_flash;
+
+        // 同一y坐标上使用相同纹理的命令相邻，便于渲染器合批
+        if (is_y_sorted)
+            command.key |= (uint32_t)((uintptr_t)texture >> 4);
+    }
+
+    /**
+     * @brief 开始一批使用同一纹理的方形精灵
+     * @param texture 纹理，每个精灵使用整张纹理
+     * @details 在endSprites()之前只能调用appendSprite()，整批精灵以一次几何绘制提交
+     */
+    void beginSprites(SDL_Texture* texture)
+    {
+        RenderCommand& command = append(RenderCommandType::Sprites);
+        command.texture = texture;
+        command.offset_vertex = (uint32_t)vertex_buffer.size();
+
+        index_sprites = command_list.size() - 1;
+    }
+
+    /**
+     * @brief 向当前批次追加一个精灵
+     * @param x 中心x坐标
+     * @param y 中心y坐标
+     * @param size 边长
+     * @param color 颜色，与纹理相乘
+     */
+    void appendSprite(float x, float y, float size, const SDL_Color& color)
+    {
+        float half = size / 2;
+        if (is_world) {
+            const Vector2 point = camera.worldToScreen(Vector2(x, y));
+            x = (float)point.x, y = (float)point.y;
+            half *= (float)camera.getZoom();
+
+            const SDL_Rect rect_bound = { (int)(x - half) - 1, (int)(y - half) - 1, (int)(half * 2) + 2, (int)(half * 2) + 2 };
+            if (!camera.isVisible(rect_bound))
+                return;
+        }
+        else if (index_retained != NO_RETAINED) {
+            x -= origin_retained.x;
+            y -= origin_retained.y;
+        }
+
+        vertex_buffer.push_back({ { x - half, y - half }, color, { 0, 0 } });
+        vertex_buffer.push_back({ { x + half, y - half }, color, { 1, 0 } });
+        vertex_buffer.push_back({ { x + half, y + half }, color, { 1, 1 } });
+        vertex_buffer.push_back({ { x - half, y + half }, color, { 0, 1 } });
+        command_list[index_sprites].num_vertex += 4;
+    }
+
+    /**
+     * @brief 结束当前精灵批次，没有可见精灵时丢弃该批次
+     */
+    void endSprites()
+    {
+        if (command_list[index_sprites].num_vertex == 0)
+            command_list.pop_back();
+    }
+
+    /**
+     * @brief 绘制瓦片地图区块
+     * @param index_chunk 区块索引
+     * @param rect_dst 目标矩形
+     * @details 区块纹理在执行时才由渲染端烘焙或从缓存中取得
+     */
+    void drawTileChunk(uint32_t index_chunk, const SDL_Rect& rect_dst)
+    {
+        SDL_Rect rect = rect_dst;
+        if (!toScreen(rect))
+            return;
+
+        RenderCommand& command = append(RenderCommandType::TileChunk);
+        command.index_chunk = index_chunk;
+        command.rect_dst = rect;
+    }
+
+    /**
+     * @brief 填充矩形
+     * @param rect 矩形
+     * @param color 颜色，透明度小于255时混合绘制
+     */
+    void fillRect(const SDL_Rect& rect, const SDL_Color& color)
+    {
+        SDL_Rect rect_screen = rect;
+        if (!toScreen(rect_screen))
+            return;
+
+        RenderCommand& command = append(RenderCommandType::FillRect);
+        command.rect_dst = rect_screen;
+        command.color = color;
+    }
+
+    /**
+     * @brief 绘制矩形边框
+     * @param rect 矩形
+     * @param color 颜色，透明度小于255时混合绘制
+     */
+    void drawRect(const SDL_Rect& rect, const SDL_Color& color)
+    {
+        SDL_Rect rect_screen = rect;
+        if (!toScreen(rect_screen))
+            return;
+
+        RenderCommand& command = append(RenderCommandType::DrawRect);
+        command.rect_dst = rect_screen;
+        command.color = color;
+    }
+
+    /**
+     * @brief 填充圆形
+     * @param center 圆心
+     * @param radius 半径
+     * @param color 颜色
+     */
+    void fillCircle(const SDL_Point& center, int radius, const SDL_Color& color)
+    {
+        SDL_Rect rect = { center.x - radius, center.y - radius, radius * 2, radius * 2 };
+        if (!toScreen(rect))
+            return;
+
+        RenderCommand& command = append(RenderCommandType::FillCircle);
+        command.rect_dst = { rect.x + rect.w / 2, rect.y + rect.h / 2, 0, 0 };
+        command.radius = rect.w / 2;
+        command.color = color;
+    }
+
+    /**
+     * @brief 绘制抗锯齿圆形边框
+     * @param center 圆心
+     * @param radius 半径
+     * @param color 颜色
+     */
+    void drawCircle(const SDL_Point& center, int radius, const SDL_Color& color)
+    {
+        SDL_Rect rect = { center.x - radius, center.y - radius, radius * 2, radius * 2 };
+        if (!toScreen(rect))
+            return;
+
+        RenderCommand& command = append(RenderCommandType::DrawCircle);
+        command.rect_dst = { rect.x + rect.w / 2, rect.y + rect.h / 2, 0, 0 };
+        command.radius = rect.w / 2;
+        command.color = color;
+    }
+
+    /**
+     * @brief 填充圆角矩形
+     * @param rect 矩形
+     * @param radius 圆角半径
+     * @param color 颜色
+     */
+    void fillRoundedBox(const SDL_Rect& rect, int radius, const SDL_Color& color)
+    {
+        SDL_Rect rect_screen = rect;
+        if (!toScreen(rect_screen))
+            return;
+
+        RenderCommand& command = append(RenderCommandType::FillRoundedBox);
+        command.rect_dst = rect_screen;
+        command.radius = is_world ? (int)std::lround(radius * camera.getZoom()) : radius;
+        command.color = color;
+    }
+
+    /**
+     * @brief 绘制文本
+     * @param font 字体
+     * @param text 文本内容
+     * @param color 颜色
+     * @param position 对齐点x与文本上边界y
+     * @param align 水平对齐方式
+     * @details 文本尺寸在执行时才确定，需要按高度排版时可使用TTF_FontHeight()；
+     *          世界坐标层中只变换位置，文本不随摄像机缩放，也不做剔除
+     */
+    void drawText(TTF_Font* font, const std::string& text, const SDL_Color& color, const SDL_Point& position, TextAlign align = TextAlign::Left)
+    {
+        SDL_Point position_screen = position;
+        if (is_world) {
+            const Vector2 point = camera.worldToScreen(Vector2(position.x, position.y));
+            position_screen = { (int)std::lround(point.x), (int)std::lround(point.y) };
+        }
+        else if (index_retained != NO_RETAINED) {
+            position_screen.x -= origin_retained.x;
+            position_screen.y -= origin_retained.y;
+        }
+
+        RenderCommand& command = append(RenderCommandType::Text);
+        command.font = font;
+        command.color = color;
+        command.rect_dst = { position_screen.x, position_screen.y, 0, 0 };
+        command.align = align;
+        command.offset_text = (uint32_t)text_buffer.size();
+
+        text_buffer.append(text);
+        text_buffer.push_back('\0');
+    }
+
+    const std::vector<RenderCommand>& getCommandList() const { return command_list; }   // 命令列表
+    const char* getText(const RenderCommand& command) const { return text_buffer.c_str() + command.offset_text; } // 文本命令的内容
+    const SDL_Vertex* getVertex(const RenderCommand& command) const { return vertex_buffer.data() + command.offset_vertex; } // 精灵批次的顶点
+    bool empty() const { return command_list.empty(); }                                 // 是否没有命令
+    bool isSorted() const { return is_sorted; }                                         // 是否已经排序
+
+    /**
+     * @brief 获取排序后第index条命令
+     * @details 需要先调用sort()
+     */
+    const RenderCommand& getSortedCommand(size_t index) const { return command_list[sort_list[index].index]; }
+
+private:
+    /**
+     * @brief 排序项
+     */
+    struct SortEntry
+    {
+        uint64_t key;       // 排序键
+        uint32_t index;     // 命令下标
+    };
+
+    static constexpr int Y_BIAS = 1 << 23;      // 24位y坐标的偏移量
+    static constexpr size_t NO_RETAINED = (size_t)-1; // 未在记录保留层
+
+    std::vector<RenderCommand> command_list;    // 命令列表
+    std::string text_buffer;                    // 文本缓冲区，各文本以'\0'分隔
+    std::vector<SDL_Vertex> vertex_buffer;      // 精灵批次的顶点缓冲区
+    size_t index_sprites = 0;                   // 正在记录的精灵批次命令的下标
+    std::vector<SortEntry> sort_list;           // 排序结果
+    std::vector<SortEntry> sort_buffer;         // 基数排序的临时缓冲区
+    uint64_t key_current = (uint64_t)RenderLayer::UI << 56; // 之后追加的命令使用的排序键
+    bool is_y_sorted = false;                   // 当前层是否按y排序
+    bool is_world = false;                      // 当前层是否使用世界坐标
+    Camera camera;                              // 世界坐标层使用的摄像机
+    size_t index_retained = NO_RETAINED;        // 正在记录的保留层命令的下标
+    SDL_Point origin_retained = { 0, 0 };       // 正在记录的保留层的左上角
+    bool is_sorted = false;                     // 是否已经排序
+
+private:
+    /**
+     * @brief 世界坐标层中将矩形变换到屏幕坐标并做视口剔除，
+     *        保留层中将矩形变换到保留层的局部坐标
+     * @param rect 输入输出参数，矩形
+     * @param is_rotated 是否旋转绘制，旋转时按外接圆剔除
+     * @return 矩形可见返回true
+     */
+    bool toScreen(SDL_Rect& rect, bool is_rotated = false) const
+    {
+        if (!is_world) {
+            if (index_retained != NO_RETAINED) {
+                rect.x -= origin_retained.x;
+                rect.y -= origin_retained.y;
+            }
+            return true;
+        }
+
+        rect = camera.worldToScreen(rect);
+
+        SDL_Rect rect_bound = rect;
+        if (is_rotated) {
+            const int margin = std::max(rect.w, rect.h) / 4 + 1;
+            rect_bound = { rect.x - margin, rect.y - margin, rect.w + margin * 2, rect.h + margin * 2 };
+        }
+
+        return camera.isVisible(rect_bound);
+    }
+
+    RenderCommand& append(RenderCommandType type)
+    {
+        command_list.emplace_back();
+        command_list.back().type = type;
+        command_list.back().key = key_current;
+        command_list.back().is_retained = (index_retained != NO_RETAINED);
+        is_sorted = false;
+        return command_list.back();
+    }
+};
@@ -0,0 +1,312 @@
+﻿#pragma once
+
+#include "../basic/map.hpp"
+#include "../basic/tile.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 瓦片地图区块缓存
+ * @details 地图按CHUNK_SIZE×CHUNK_SIZE个瓦片划分为区块，每个区块烘焙为一张独立的目标纹理。
+ *          区块在第一次被绘制时才烘焙，纹理总大小超过预算时按最近最少使用的顺序释放，
+ *          本帧用到的区块不会被释放。
+ *          地图修改后通过invalidateTile()标记脏瓦片，常驻区块在下次使用时只重绘脏瓦片，
+ *          未常驻的区块在烘焙时自然读取到最新数据。
+ *          区块的划分只取决于地图尺寸，可以在任意线程查询；
+ *          acquire()等需要渲染器的操作只能在创建渲染器的线程中调用
+ */
+class TileChunkCache
+{
+public:
+    static constexpr int CHUNK_SIZE = 16;   // 区块边长(瓦片)
+
+    /**
+     * @brief 缓存统计
+     */
+    struct Stats
+    {
+        size_t num_resident = 0;    // 常驻区块数
+        size_t size_resident = 0;   // 常驻纹理大小(字节)
+        size_t size_peak = 0;       // 常驻纹理大小的峰值(字节)
+        size_t num_bake = 0;        // 累计烘焙次数
+        size_t num_evict = 0;       // 累计释放次数
+        size_t num_rebake_tile = 0; // 累计重绘的脏瓦片数
+    };
+
+public:
+    TileChunkCache() = default;
+    ~TileChunkCache() = default;
+
+    TileChunkCache(const TileChunkCache&) = delete;
+    TileChunkCache& operator=(const TileChunkCache&) = delete;
+
+    /**
+     * @brief 初始化缓存，清空已有区块
+     * @param renderer SDL渲染器
+     * @param map 地图
+     * @param tex_tile_set 瓦片集纹理
+     * @param tex_home 房屋标记纹理
+     * @param size_budget 纹理大小预算(字节)
+     * @return 初始化成功返回true
+     */
+    bool init(SDL_Renderer* renderer, const Map* map, SDL_Texture* tex_tile_set, SDL_Texture* tex_home, size_t size_budget)
+    {
+        int tile_set_width = 0;
+        if (SDL_QueryTexture(tex_tile_set, nullptr, nullptr, &tile_set_width, nullptr) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"查询tile set尺寸: %s", SDL_GetError());
+            return false;
+        }
+
+        this->renderer = renderer;
+        this->map = map;
+        this->tex_tile_set = tex_tile_set;
+        this->tex_home = tex_home;
+        this->size_budget = size_budget;
+        num_tile_single_line = (tile_set_width + TILE_SIZE - 1) / TILE_SIZE;
+
+        num_chunk_x = ((int)map->getWidth() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        num_chunk_y = ((int)map->getHeight() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+        lru_list.clear();
+        chunk_list.clear();
+        chunk_list.resize((size_t)num_chunk_x * num_chunk_y);
+        stats = Stats();
+
+        return true;
+    }
+
+    /**
+     * @brief 标记瓦片已修改
+     * @param index_tile 瓦片坐标
+     */
+    void invalidateTile(const SDL_Point& index_tile)
+    {
+        const size_t index = (size_t)(index_tile.y / CHUNK_SIZE) * num_chunk_x + index_tile.x / CHUNK_SIZE;
+        if (index >= chunk_list.size())
+            return;
+
+        Chunk& chunk = chunk_list[index];
+        if (!chunk.texture)
+            return;
+
+        for (const SDL_Point& index_dirty : chunk.dirty_list) {
+            if (index_dirty.x == index_tile.x && index_dirty.y == index_tile.y)
+                return;
+        }
+        chunk.dirty_list.push_back(index_tile);
+    }
+
+    int getChunkCountX() const { return num_chunk_x; }  // 水平方向区块数
+    int getChunkCountY() const { return num_chunk_y; }  // 竖直方向区块数
+
+    /**
+     * @brief 获取区块在地图纹理空间中的矩形
+     * @param index_x 区块横向索引
+     * @param index_y 区块纵向索引
+     * @return 以地图左上角为原点的像素矩形，地图边缘的区块可能小于完整区块
+     */
+    SDL_Rect getChunkRect(int index_x, int index_y) const
+    {
+        const int index_tile_x = index_x * CHUNK_SIZE;
+        const int index_tile_y = index_y * CHUNK_SIZE;
+        const int num_tile_x = std::min(CHUNK_SIZE, (int)map->getWidth() - index_tile_x);
+        const int num_tile_y = std::min(CHUNK_SIZE, (int)map->getHeight() - index_tile_y);
+
+        return { index_tile_x * TILE_SIZE, index_tile_y * TILE_SIZE, num_tile_x * TILE_SIZE, num_tile_y * TILE_SIZE };
+    }
+
+    /**
+     * @brief 获取区块纹理，未烘焙时立即烘焙
+     * @param index 区块索引(index_y * 水平区块数 + index_x)
+     * @return 区块纹理，烘焙失败返回nullptr
+     */
+    SDL_Texture* acquire(uint32_t index)
+    {
+        if (index >= chunk_list.size())
+            return nullptr;
+
+        Chunk& chunk = chunk_list[index];
+        if (!chunk.texture) {
+            if (!bake(index, chunk))
+                return nullptr;
+
+            lru_list.push_front(index);
+            chunk.it_lru = lru_list.begin();
+        }
+        else {
+            lru_list.splice(lru_list.begin(), lru_list, chunk.it_lru);
+
+            if (!chunk.dirty_list.empty())
+                rebakeDirty(index, chunk);
+        }
+
+        chunk.frame_used = index_frame;
+        return chunk.texture.get();
+    }
+
+    /**
+     * @brief 结束一帧，释放超出预算的区块
+     */
+    void endFrame()
+    {
+        while (stats.size_resident > size_budget && !lru_list.empty()) {
+            const uint32_t index = lru_list.back();
+            Chunk& chunk = chunk_list[index];
+            if (chunk.frame_used == index_frame)
+                break;
+
+            lru_list.pop_back();
+            chunk.texture.reset();
+            chunk.dirty_list.clear();
+            stats.size_resident -= chunk.size;
+            stats.num_resident--;
+            stats.num_evict++;
+        }
+
+        index_frame++;
+    }
+
+    const Stats& getStats() const { return stats; }     // 缓存统计
+    size_t getBudget() const { return size_budget; }    // 纹理大小预算(字节)
+
+private:
+    /**
+     * @brief 缓存的区块
+     */
+    struct Chunk
+    {
+        std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture{ nullptr, SDL_DestroyTexture };
+        size_t size = 0;                            // 纹理大小(字节)
+        uint64_t frame_used = 0;                    // 最近一次使用的帧序号
+        std::list<uint32_t>::iterator it_lru;       // 在LRU链表中的位置
+        std::vector<SDL_Point> dirty_list;          // 待重绘的瓦片坐标
+    };
+
+    SDL_Renderer* renderer = nullptr;       // 渲染器
+    const Map* map = nullptr;               // 地图
+    SDL_Texture* tex_tile_set = nullptr;    // 瓦片集纹理
+    SDL_Texture* tex_home = nullptr;        // 房屋标记纹理
+    int num_tile_single_line = 1;           // 瓦片集每行的瓦片数
+    int num_chunk_x = 0;                    // 水平方向区块数
+    int num_chunk_y = 0;                    // 竖直方向区块数
+    size_t size_budget = 0;                 // 纹理大小预算(字节)
+
+    std::vector<Chunk> chunk_list;          // 所有区块
+    std::list<uint32_t> lru_list;           // 常驻区块，链表头为最近使用
+    uint64_t index_frame = 0;               // 当前帧序号
+    Stats stats;                            // 缓存统计
+
+private:
+    /**
+     * @brief 烘焙区块纹理：地形、装饰与房屋标记
+     */
+    bool bake(uint32_t index, Chunk& chunk)
+    {
+        const int index_x = (int)index % num_chunk_x;
+        const int index_y = (int)index / num_chunk_x;
+        const SDL_Rect rect_chunk = getChunkRect(index_x, index_y);
+
+        chunk.texture.reset(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_TARGET, rect_chunk.w, rect_chunk.h));
+        if (!chunk.texture) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"创建区块纹理: %s", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureBlendMode(chunk.texture.get(), SDL_BLENDMODE_BLEND);
+
+        SDL_Texture* target_last = SDL_GetRenderTarget(renderer);
+        if (SDL_SetRenderTarget(renderer, chunk.texture.get()) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"设置渲染目标失败: %s", SDL_GetError());
+            chunk.texture.reset();
+            return false;
+        }
+
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+
+        const int index_tile_x_begin = rect_chunk.x / TILE_SIZE;
+        const int index_tile_y_begin = rect_chunk.y / TILE_SIZE;
+        const int index_tile_x_end = index_tile_x_begin + rect_chunk.w / TILE_SIZE;
+        const int index_tile_y_end = index_tile_y_begin + rect_chunk.h / TILE_SIZE;
+
+        for (int y = index_tile_y_begin; y < index_tile_y_end; y++) {
+            for (int x = index_tile_x_begin; x < index_tile_x_end; x++)
+                renderTile({ x, y }, rect_chunk);
+        }
+
+        SDL_SetRenderTarget(renderer, target_last);
+
+        chunk.size = (size_t)rect_chunk.w * rect_chunk.h * 4;
+        stats.num_resident++;
+        stats.size_resident += chunk.size;
+        stats.size_peak = std::max(stats.size_peak, stats.size_resident);
+        stats.num_bake++;
+
+        return true;
+    }
+
+    /**
+     * @brief 只重绘区块中的脏瓦片
+     */
+    void rebakeDirty(uint32_t index, Chunk& chunk)
+    {
+        const SDL_Rect rect_chunk = getChunkRect((int)index % num_chunk_x, (int)index / num_chunk_x);
+
+        SDL_Texture* target_last = SDL_GetRenderTarget(renderer);
+        if (SDL_SetRenderTarget(renderer, chunk.texture.get()) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, u8"设置渲染目标失败: %s", SDL_GetError());
+            return;
+        }
+
+        // 先将瓦片区域清为透明，再按烘焙时的顺序重绘
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        for (const SDL_Point& index_tile : chunk.dirty_list) {
+            const SDL_Rect rect_dst = { index_tile.x * TILE_SIZE - rect_chunk.x, index_tile.y * TILE_SIZE - rect_chunk.y, TILE_SIZE, TILE_SIZE };
+            SDL_RenderFillRect(renderer, &rect_dst);
+            renderTile(index_tile, rect_chunk);
+        }
+
+        SDL_SetRenderTarget(renderer, target_last);
+
+        stats.num_rebake_tile += chunk.dirty_list.size();
+        chunk.dirty_list.clear();
+    }
+
+    /**
+     * @brief 将一个瓦片的地形、装饰与房屋标记绘制到当前渲染目标
+     * @param index_tile 瓦片坐标
+     * @param rect_chunk 瓦片所在区块的矩形
+     */
+    void renderTile(const SDL_Point& index_tile, const SDL_Rect& rect_chunk)
+    {
+        const Tile& tile = map->getTileMap()[index_tile.y][index_tile.x];
+        const SDL_Rect rect_dst = { index_tile.x * TILE_SIZE - rect_chunk.x, index_tile.y * TILE_SIZE - rect_chunk.y, TILE_SIZE, TILE_SIZE };
+
+        SDL_Rect rect_src = getTileSetRect(tile.terrian);
+        SDL_RenderCopy(renderer, tex_tile_set, &rect_src, &rect_dst);
+
+        if (tile.decoration >= 0) {
+            rect_src = getTileSetRect(tile.decoration);
+            SDL_RenderCopy(renderer, tex_tile_set, &rect_src, &rect_dst);
+        }
+
+        const SDL_Point& index_home = map->getIndexHome();
+        if (index_home.x == index_tile.x && index_home.y == index_tile.y)
+            SDL_RenderCopy(renderer, tex_home, nullptr, &rect_dst);
+    }
+
+    /**
+     * @brief 瓦片集中指定编号瓦片的源矩形
+     */
+    SDL_Rect getTileSetRect(int index) const
+    {
+        return { (index % num_tile_single_line) * TILE_SIZE, (index / num_tile_single_line) * TILE_SIZE, TILE_SIZE, TILE_SIZE };
+    }
+};
@@ -0,0 +1,216 @@
+﻿#define SDL_MAIN_HANDLED
+
+#include "../util/resource_pack.hpp"
+#include "../util/wave_timeline.hpp"
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_mixer.h>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * 资源烘焙工具：把res目录编译为一个资源包
+ *
+ * 用法：cook <res目录> <输出路径>
+ * - image下的PNG解码为ARGB8888像素
+ * - music下的sound_*音效按游戏的混音器格式解码为PCM，其余音乐保持原始数据以便流式播放
+ * - font与file下的文件保持原始数据，其中顶层为数组的JSON(关卡配置)另外编译为同名的.wave波次时间线
+ *
+ * 用法：cook --level <关卡配置> <输出路径>
+ * - 只把关卡配置编译为波次时间线文件，放在关卡配置旁边时游戏优先使用
+ * 条目路径与游戏加载松散文件时使用的路径相同，如"res/image/tileset.png"
+ */
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief 读取整个文件
+ */
+static bool readFile(const fs::path& path, std::vector<uint8_t>& data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/**
+ * @brief 按文件名排序列出目录中的文件，保证输出稳定
+ */
+static std::vector<fs::path> listFiles(const fs::path& dir)
+{
+    std::vector<fs::path> path_list;
+    if (fs::is_directory(dir)) {
+        for (const auto& item : fs::directory_iterator(dir))
+            if (item.is_regular_file())
+                path_list.push_back(item.path());
+    }
+
+    std::sort(path_list.begin(), path_list.end());
+    return path_list;
+}
+
+static bool cookImage(ResourcePackWriter& writer, const std::string& name, const fs::path& path)
+{
+    SDL_Surface* surface = IMG_Load(path.string().c_str());
+    if (!surface)
+        return false;
+
+    SDL_Surface* surface_argb = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(surface);
+    if (!surface_argb)
+        return false;
+
+    bool is_ok = writer.add(name, PackEntryType::Image, surface_argb->pixels, (size_t)surface_argb->pitch * surface_argb->h,
+        (uint32_t)surface_argb->w, (uint32_t)surface_argb->h, (uint32_t)surface_argb->pitch);
+    SDL_FreeSurface(surface_argb);
+    return is_ok;
+}
+
+static bool cookSound(ResourcePackWriter& writer, const std::string& name, const fs::path& path)
+{
+    Mix_Chunk* chunk = Mix_LoadWAV(path.string().c_str());
+    if (!chunk)
+        return false;
+
+    bool is_ok = writer.add(name, PackEntryType::Sound, chunk->abuf, chunk->alen);
+    Mix_FreeChunk(chunk);
+    return is_ok;
+}
+
+static bool cookRaw(ResourcePackWriter& writer, const std::string& name, const fs::path& path)
+{
+    std::vector<uint8_t> data;
+    return readFile(path, data) && writer.add(name, PackEntryType::Raw, data.data(), data.size());
+}
+
+/**
+ * @brief 判断JSON文本的顶层是否为数组
+ */
+static bool isJsonArray(const std::vector<uint8_t>& data)
+{
+    auto itor = std::find_if(data.begin(), data.end(), [](uint8_t c) { return !std::isspace(c); });
+    return itor != data.end() && *itor == '[';
+}
+
+/**
+ * @brief 把关卡配置编译为波次时间线
+ * @param data 关卡配置的JSON文本
+ * @param timeline 输出参数，编译出的时间线
+ */
+static bool compileLevel(std::vector<uint8_t> data, std::vector<uint8_t>& timeline)
+{
+    data.push_back('\0');
+    return WaveTimelineCompiler::compile((const char*)data.data(), timeline);
+}
+
+static bool cookLevel(ResourcePackWriter& writer, const std::string& name, const fs::path& path)
+{
+    std::vector<uint8_t> data, timeline;
+    if (!readFile(path, data) || !isJsonArray(data))
+        return true;
+
+    const std::string name_compiled = fs::path(name).replace_extension(".wave").generic_string();
+    return compileLevel(std::move(data), timeline)
+        && writer.add(name_compiled, PackEntryType::Raw, timeline.data(), timeline.size());
+}
+
+/**
+ * @brief 只编译一个关卡配置，输出波次时间线文件
+ */
+static int cookLevelFile(const fs::path& path, const fs::path& path_output)
+{
+    std::vector<uint8_t> data, timeline;
+    if (!readFile(path, data) || !compileLevel(std::move(data), timeline)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to compile %s", path.string().c_str());
+        return 1;
+    }
+
+    std::ofstream file(path_output, std::ios::binary | std::ios::trunc);
+    file.write((const char*)timeline.data(), (std::streamsize)timeline.size());
+    if (!file.good()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to write %s", path_output.string().c_str());
+        return 1;
+    }
+
+    const WaveTimelineHeader* header = (const WaveTimelineHeader*)timeline.data();
+    SDL_Log("compiled %s: %u wave(s), %u spawn event(s), %zu bytes", path_output.string().c_str(),
+        header->num_wave, header->num_event, timeline.size());
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 4 && std::string(argv[1]) == "--level")
+        return cookLevelFile(argv[2], argv[3]);
+
+    if (argc != 3) {
+        SDL_Log("usage: cook <res dir> <output pack>");
+        SDL_Log("       cook --level <level json> <output timeline>");
+        return 1;
+    }
+
+    const fs::path dir_res = argv[1];
+    const fs::path path_output = argv[2];
+
+    // 只用于解码，不输出声音
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_AUDIO) != 0 || !IMG_Init(IMG_INIT_PNG) || !Mix_Init(MIX_INIT_MP3)
+        || Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+
+    ResourcePackWriter writer;
+    size_t num_failed = 0;
+
+    for (const char* sub_dir : { "image", "music", "font", "file" }) {
+        for (const fs::path& path : listFiles(dir_res / sub_dir)) {
+            const std::string name = std::string("res/") + sub_dir + "/" + path.filename().string();
+            const std::string stem = path.stem().string();
+
+            bool is_ok = false;
+            if (std::string(sub_dir) == "image" && path.extension() == ".png")
+                is_ok = cookImage(writer, name, path);
+            else if (std::string(sub_dir) == "music" && stem.rfind("sound_", 0) == 0)
+                is_ok = cookSound(writer, name, path);
+            else if (std::string(sub_dir) == "file" && path.extension() == ".json")
+                is_ok = cookRaw(writer, name, path) && cookLevel(writer, name, path);
+            else
+                is_ok = cookRaw(writer, name, path);
+
+            if (!is_ok) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to cook %s: %s", name.c_str(), SDL_GetError());
+                num_failed++;
+            }
+        }
+    }
+
+    if (path_output.has_parent_path())
+        fs::create_directories(path_output.parent_path());
+
+    const bool is_written = writer.write(path_output.string(), (uint32_t)frequency, format, (uint32_t)channels);
+    if (!is_written)
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to write %s", path_output.string().c_str());
+    else
+        SDL_Log("cooked %s, %zu file(s) failed", path_output.string().c_str(), num_failed);
+
+    Mix_CloseAudio();
+    Mix_Quit();
+    IMG_Quit();
+    SDL_Quit();
+
+    return (is_written && num_failed == 0) ? 0 : 1;
+}
@@ -4,38 +4,86 @@
 #include "../util/animation.hpp"
 #include "../util/timer.hpp"
 #include "../tower/tower_type.hpp"
+#include "../tower/tower_prototype.hpp"
 #include "../basic/facing.hpp"
 #include "../manager/bullet_manager.hpp"
 #include "../manager/enemy_manager.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 
 /**
  * @class Tower
- * @brief 游戏中的防御塔基类，实现了防御塔的基本功能
+ * @brief 游戏中的防御塔类，实现了防御塔的基本功能
  *
  * 包含以下主要功能：
  * - 防御塔的位置管理和渲染
  * - 多方向的静止和攻击动画
  * - 自动搜索和攻击范围内的敌人
- * - 不同类型防御塔的属性配置
+ * - 不同类型防御塔的外观与属性均来自对应的原型(TowerPrototype)
  */
 class Tower
 {
 public:
 	/**
-	 * @brief 构造函数，初始化防御塔的基本属性和动画
+	 * @brief 构造函数，初始化开火定时器和动画回调
 	 *
-	 * 设置开火定时器和各个方向的动画属性
+	 * 冷却结束时在冷却结束的时刻立即开火，射击节奏不受更新步长影响；
+	 * 开火动画均为单次播放，播放结束后切换回对应朝向的静止动画
 	 */
 	Tower()
 	{
 		timer_fire.setOneShot(true);
-		timer_fire.setOnTimeOut([&] { can_fire = true; });
+		timer_fire.setOnTimeOut([&]
+			{
+				can_fire = true;
+				onFire(timer_fire.getOverflow());
+			});
+
+		for (Animation* anim : { &anim_fire_up, &anim_fire_down, &anim_fire_left, &anim_fire_right }) {
+			anim->setLoop(false);
+			anim->setOnFinished([&] { updateIdleAnimation(); });
+		}
 	}
 
 	~Tower() = default;
 
+	/**
+	 * @brief 从原型复制外观与属性，并恢复到朝右待机、可开火的初始状态
+	 * @param prototype 防御塔原型
+	 */
+	void applyPrototype(const TowerPrototype& prototype)
+	{
+		this->prototype = &prototype;
+
+		tower_type = prototype.type;
+		size = prototype.size;
+		fire_speed = prototype.fire_speed;
+		bullet_type = prototype.bullet_type;
+		applyClips();
+
+		can_fire = true;
+		facing = Facing::RIGHT;
+		updateIdleAnimation();
+	}
+
+	/**
+	 * @brief 配置热重载后从重新烘焙的原型刷新外观与属性
+	 *
+	 * 原型在原地重新烘焙，塔仍指向同一原型；保留朝向与开火冷却，
+	 * 正在播放的开火动画直接切回静止动画
+	 */
+	void refreshPrototype()
+	{
+		size = prototype->size;
+		fire_speed = prototype->fire_speed;
+		bullet_type = prototype->bullet_type;
+		applyClips();
+
+		updateIdleAnimation();
+	}
+
 	/**
 	 * @brief 设置防御塔的位置
 	 * @param position 新的位置坐标
@@ -67,7 +115,8 @@ public:
 	 * @brief 更新防御塔的状态
 	 * @param delta_time 时间增量
 	 *
-	 * 更新开火定时器和当前动画，检查是否可以开火
+	 * 更新开火定时器和当前动画，检查是否可以开火；
+	 * 冷却早已结束时，开火时刻最早可以是本次更新步长的开始
 	 */
 	void onUpdate(double delta_time)
 	{
@@ -75,19 +124,20 @@ public:
 		anim_current->onUpdate(delta_time);
 
 		if (can_fire)
-			onFire();
+			onFire(delta_time);
 	}
 
 	/**
 	* @brief 渲染防御塔
-	* @param renderer SDL渲染器指针
+	* @param render_list 渲染命令列表
 	*/
-	void onRender(SDL_Renderer* renderer)
+	void onRender(RenderList& render_list) const
 	{
-		static SDL_Point point;
+		SDL_Point point;
 		point.x = (int)(position.x - size.x / 2);
 		point.y = (int)(position.y - size.y / 2);
-		anim_current->onRender(renderer, point);
+		render_list.setLayer(RenderLayer::Actor, (int)(position.y + size.y / 2));
+		anim_current->onRender(render_list, point);
 	}
 
 protected:
@@ -113,28 +163,6 @@ protected:
 			break;
 		}
 	}
-
-	/**
-	 * @brief 设置动画
-	 * @param anim 动画对象
-	 * @param texture 动画纹理
-	 * @param loop 是否循环播放
-	 * @param num_h 动画横向帧数
-	 * @param num_v 动画纵向帧数
-	 * @param index_list 动画帧索引列表
-	 * @param interval 帧间隔
-	 * @param call_back 动画结束回调函数
-	 *
-	 * 设置动画的贴图、帧索引列表等属性
-	 */
-	void setAnimation(Animation& anim, SDL_Texture* texture, bool loop, int num_h, int num_v, const std::vector<int>& index_list, double interval, std::function<void()> call_back = nullptr)
-	{
-		anim.setLoop(loop);
-		anim.setInterval(interval);
-		anim.setFrameData(texture, num_h, num_v, index_list);
-		if (call_back)
-			anim.setOnFinished(call_back);
-	}
 	
 protected:
 	Vector2 size;								 // 防御塔的大小
@@ -149,18 +177,37 @@ protected:
 	Animation anim_fire_left;					 // 向左开火动画
 	Animation anim_fire_right;					 // 向右开火动画
 
-	TowerType tower_type;						 // 防御塔类型
-	double fire_speed;							 // 射击速度
-	BulletType bullet_type;						 // 子弹类型
+	TowerType tower_type = TowerType::Archer;	 // 防御塔类型
+	double fire_speed = 0;						 // 射击速度
+	BulletType bullet_type = BulletType::Arrow;	 // 子弹类型
 
 private:
+	const TowerPrototype* prototype = nullptr;	 // 所属原型(共享音效等只读数据)
 	Timer timer_fire;							 // 开火计时器
 	Vector2 position;							 // 防御塔位置
-	bool can_fire;								 // 是否可以开火
-	Facing facing;								 // 朝向
+	bool can_fire = true;						 // 是否可以开火
+	Facing facing = Facing::RIGHT;				 // 朝向
 	Animation* anim_current = &anim_idle_right;  // 当前播放的动画
 
 private:
+	/**
+	 * @brief 从原型设置各朝向动画的帧数据与帧间隔，并从头播放
+	 */
+	void applyClips()
+	{
+		Animation* anim_idle_list[4] = { &anim_idle_up, &anim_idle_down, &anim_idle_left, &anim_idle_right };
+		Animation* anim_fire_list[4] = { &anim_fire_up, &anim_fire_down, &anim_fire_left, &anim_fire_right };
+		for (int i = 0; i < 4; i++) {
+			anim_idle_list[i]->setInterval(prototype->interval_idle);
+			anim_idle_list[i]->setClip(prototype->clip_idle_list[i]);
+			anim_idle_list[i]->reset();
+
+			anim_fire_list[i]->setInterval(prototype->interval_fire);
+			anim_fire_list[i]->setClip(prototype->clip_fire_list[i]);
+			anim_fire_list[i]->reset();
+		}
+	}
+
 	/**
 	 * @brief 更新开火状态的动画
 	 * 根据当前朝向更新对应的开火动画
@@ -193,22 +240,10 @@ private:
 	Enemy* findTargetEnemy() const
 	{
 		double process = -1.0;
-		double view_range = 0.0;
 		Enemy* target_enemy = nullptr;
 
 		static auto* config = ConfigManager::instance();
-
-		switch (tower_type) {
-		case TowerType::Archer:
-			view_range = config->archer_template.view_range[config->level_archer];
-			break;
-		case TowerType::Axeman:
-			view_range = config->axeman_template.view_range[config->level_axeman];
-			break;
-		case TowerType::Gunner:
-			view_range = config->gunner_template.view_range[config->level_gunner];
-			break;
-		}
+		const double view_range = config->getTowerTemplate(tower_type).view_range[config->getTowerLevel(tower_type)];
 
 		auto& enemy_list = EnemyManager::instance()->getEnemyList();
 
@@ -225,8 +260,38 @@ private:
 		return target_enemy;
 	}
 
+	/**
+	 * @brief 计算敌人在本次更新步长内已处于视野范围中的时间
+	 * @param enemy 当前位于视野范围内的敌人
+	 * @param time_max 回溯的时间上限(秒)
+	 * @return 敌人进入视野范围的时刻距当前模拟时间的时间(秒)，不超过time_max
+	 *
+	 * 按敌人当前的速度回推其轨迹，求与视野圆的交点
+	 */
+	double computeTimeInView(const Enemy* enemy, double time_max) const
+	{
+		static auto* config = ConfigManager::instance();
+		const double view_range = config->getTowerTemplate(tower_type).view_range[config->getTowerLevel(tower_type)] * TILE_SIZE;
+
+		// |p - v * t| = r 的较大根即为回推到视野边界的时间
+		const Vector2 p = enemy->getPosition() - position;
+		const Vector2& v = enemy->getVelocity();
+		const double a = v.x * v.x + v.y * v.y;
+		if (a <= 0) return time_max;
+
+		const double pv = p.x * v.x + p.y * v.y;
+		const double c = p.x * p.x + p.y * p.y - view_range * view_range;
+		const double time_in_view = (pv + std::sqrt(std::max(pv * pv - a * c, 0.0))) / a;
+
+		return std::clamp(time_in_view, 0.0, time_max);
+	}
+
 	/**
 	 * @brief 处理开火逻辑
+	 * @param time_ready 冷却结束的时刻距当前模拟时间的时间(秒)
+	 *
+	 * 开火时刻取冷却结束与目标进入视野两者中较晚的一个，
+	 * 子弹从该时刻开始运动，射击结果不受更新步长影响
 	 *
 	 * 包含以下步骤：
 	 * 1. 寻找目标敌人
@@ -235,49 +300,33 @@ private:
 	 * 4. 发射子弹
 	 * 5. 更新动画状态
 	 */
-	void onFire()
+	void onFire(double time_ready)
 	{
 		auto target_enemy = findTargetEnemy();
 		if (!target_enemy) return;
 
+		const double time_elapsed = computeTimeInView(target_enemy, time_ready);
+
 		can_fire = false;
 		static auto* config = ConfigManager::instance();
-		static const auto& sound_pool = ResourceManager::instance()->getSoundPool();
-
-		double interval = 0.0, damage = 0.0;
-
-		switch (tower_type) {
-		case TowerType::Archer:
-			interval = config->archer_template.interval[config->level_archer];
-			damage = config->archer_template.damage[config->level_archer];
-
-			switch (rand() % 2) {
-			case 0:
-				Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_ArrowFire_1)->second, 0);
-				break;
-			case 1:
-				Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_ArrowFire_2)->second, 0);
-				break;
-			}
 
-			break;
-		case TowerType::Axeman:
-			interval = config->axeman_template.interval[config->level_axeman];
-			damage = config->axeman_template.damage[config->level_axeman];
-			Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_AxeFire)->second, 0);
-			break;
-		case TowerType::Gunner:
-			interval = config->gunner_template.interval[config->level_gunner];
-			damage = config->gunner_template.damage[config->level_gunner];
-			Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_ShellFire)->second, 0);
-			break;
-		}
+		const auto& tower_template = config->getTowerTemplate(tower_type);
+		const int level = config->getTowerLevel(tower_type);
+		double interval = tower_template.interval[level];
+		double damage = tower_template.damage[level];
+
+		const auto& sound_fire_list = prototype->sound_fire_list;
+		if (sound_fire_list.size() == 1)
+			Mix_PlayChannel(-1, sound_fire_list[0], 0);
+		else if (sound_fire_list.size() > 1)
+			Mix_PlayChannel(-1, sound_fire_list[rand() % sound_fire_list.size()], 0);
 
 		timer_fire.setWaitTime(interval);
-		timer_fire.restart();
+		timer_fire.restart(time_elapsed);
 
-		Vector2 direction = target_enemy->getPosition() - position;
-		BulletManager::instance()->fireBullet(bullet_type, position, direction.normalize() * fire_speed * TILE_SIZE, damage);
+		// 瞄准敌人在开火时刻的位置
+		Vector2 direction = target_enemy->getPosition() - target_enemy->getVelocity() * time_elapsed - position;
+		BulletManager::instance()->fireBullet(bullet_type, position, direction.normalize() * fire_speed * TILE_SIZE, damage, time_elapsed);
 
 		bool is_show_x_anim = abs(direction.x) >= abs(direction.y);
 		if (is_show_x_anim) 
@@ -0,0 +1,86 @@
+﻿#pragma once
+
+#include "tower_type.hpp"
+#include "../util/vector2.hpp"
+#include "../util/animation.hpp"
+#include "../bullet/bullet_type.hpp"
+#include "../manager/config_manager.hpp"
+#include "../manager/resource_manager.hpp"
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 防御塔原型，由配置中的防御塔模板烘焙而成
+ *
+ * 原型创建后不再修改，帧数据与音效由同一类型的所有防御塔共享；
+ * 攻击间隔、伤害等随等级变化的数值仍在开火时从配置模板读取
+ */
+struct TowerPrototype
+{
+	TowerType type = TowerType::Archer;					  // 防御塔类型
+	Vector2 size;										  // 防御塔尺寸
+	double fire_speed = 0;								  // 子弹飞行速度
+	BulletType bullet_type = BulletType::Arrow;			  // 子弹类型
+
+	double interval_idle = 0.2;							  // 静止动画帧间隔
+	double interval_fire = 0.2;							  // 开火动画帧间隔
+	TextureHandle texture_idle;							  // 静止动画精灵图，原型持有引用使其不被卸载
+	TextureHandle texture_fire;							  // 开火动画精灵图
+	std::shared_ptr<const AnimationClip> clip_idle_list[4];  // 各朝向静止动画，按Facing顺序存放
+	std::shared_ptr<const AnimationClip> clip_fire_list[4];  // 各朝向开火动画，按Facing顺序存放
+
+	std::vector<SoundHandle> sound_fire_list;			  // 开火音效列表
+
+	/**
+	 * @brief 根据配置模板烘焙原型
+	 * @param type 防御塔类型
+	 * @param tmpl 防御塔配置模板
+	 * @param prototype 输出参数，烘焙后的原型
+	 * @return 纹理与音效资源全部有效返回true，否则返回false
+	 *
+	 * 需在主线程中调用，纹理与音效在此时加载
+	 */
+	static bool bake(TowerType type, const ConfigManager::TowerTemplate& tmpl, TowerPrototype& prototype)
+	{
+		static auto* resource = ResourceManager::instance();
+
+		TextureHandle texture_idle = resource->acquireTexture(tmpl.anim_idle.texture);
+		TextureHandle texture_fire = resource->acquireTexture(tmpl.anim_fire.texture);
+		if (!texture_idle || !texture_fire) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "tower archetype %s: texture not found", TOWER_TYPE_KEY_LIST[(size_t)type]);
+			return false;
+		}
+
+		const auto& anim_idle = tmpl.anim_idle;
+		const auto& anim_fire = tmpl.anim_fire;
+		for (int i = 0; i < 4; i++) {
+			prototype.clip_idle_list[i] = AnimationClip::create(texture_idle, anim_idle.num_h, anim_idle.num_v, anim_idle.index_list[i]);
+			prototype.clip_fire_list[i] = AnimationClip::create(texture_fire, anim_fire.num_h, anim_fire.num_v, anim_fire.index_list[i]);
+		}
+
+		prototype.sound_fire_list.clear();
+		for (const auto& name : tmpl.fire_sound_list) {
+			SoundHandle sound = resource->acquireSound(name);
+			if (!sound) {
+				SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "tower archetype %s: sound %s not found", TOWER_TYPE_KEY_LIST[(size_t)type], name.c_str());
+				return false;
+			}
+			prototype.sound_fire_list.push_back(std::move(sound));
+		}
+
+		prototype.texture_idle = std::move(texture_idle);
+		prototype.texture_fire = std::move(texture_fire);
+		prototype.type = type;
+		prototype.size = { tmpl.size[0], tmpl.size[1] };
+		prototype.fire_speed = tmpl.fire_speed;
+		prototype.bullet_type = tmpl.bullet_type;
+		prototype.interval_idle = anim_idle.interval;
+		prototype.interval_fire = anim_fire.interval;
+
+		return true;
+	}
+};
\ No newline at end of file
@@ -1,11 +1,23 @@
 ﻿#pragma once
 
+#include <cstddef>
+
 /**
  * @brief 塔防游戏中的防御塔类型枚举
+ * @details 新增防御塔只需在Count之前添加枚举项，并在TOWER_TYPE_KEY_LIST与config.json的"tower"节点中添加同名配置
  */
 enum class TowerType
 {
     Archer,     // 弓箭手塔
     Axeman,     // 斧头兵塔
-    Gunner      // 枪手塔
+    Gunner,     // 枪手塔
+    Count
 };
+
+constexpr size_t TOWER_TYPE_COUNT = (size_t)TowerType::Count;   // 防御塔类型数量
+
+/**
+ * @brief 各类型防御塔在config.json的"tower"节点下的键名，下标即TowerType
+ */
+constexpr const char* TOWER_TYPE_KEY_LIST[] = { "archer", "axeman", "gunner" };
+static_assert(sizeof(TOWER_TYPE_KEY_LIST) / sizeof(TOWER_TYPE_KEY_LIST[0]) == TOWER_TYPE_COUNT, "every tower type needs a config key");
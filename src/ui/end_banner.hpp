@@ -4,6 +4,7 @@
 #include "../util/timer.hpp"
 #include "../manager/config_manager.hpp"
 #include "../manager/resource_manager.hpp"
+#include "../render/render_list.hpp"
 
 #include <SDL.h>
 #include <memory>
@@ -21,6 +22,12 @@ public:
 		size_foreground = { 646, 215 };
 		size_background = { 1282, 209 };
 
+		// 结束画面在逻辑线程中显示，纹理需在构造时于主线程取得
+		auto* resource = ResourceManager::instance();
+		tex_win = resource->acquireTexture(ResID::Tex_UIWinText);
+		tex_loss = resource->acquireTexture(ResID::Tex_UILossText);
+		tex_background = resource->acquireTexture(ResID::Tex_UIGameOverBar);
+
 		timer_display.setOneShot(true);
 		timer_display.setWaitTime(5.0);
 		timer_display.setOnTimeOut(
@@ -48,34 +55,31 @@ public:
 	{
 		timer_display.onUpdate(delta_time);
 
-		const auto& tex_pool = ResourceManager::instance()->getTexturePool();
 		const auto* config = ConfigManager::instance();
 
-		tex_foreground =
-			tex_pool.find(config->is_game_win ? ResID::Tex_UIWinText : ResID::Tex_UILossText)->second;
-		tex_background = tex_pool.find(ResID::Tex_UIGameOverBar)->second;
+		tex_foreground = config->is_game_win ? tex_win : tex_loss;
 	}
 	
 	/**
 	 * @brief 渲染
-	 * @param renderer 渲染器
+	 * @param render_list 渲染命令列表
 	 */
-	void onRender(SDL_Renderer* renderer)
+	void onRender(RenderList& render_list) const
 	{
-		static SDL_Rect rect_dst;
+		SDL_Rect rect_dst;
 		rect_dst.x = (int)(pos_center.x - size_background.x / 2);
 		rect_dst.y = (int)(pos_center.y - size_background.y / 2);
 		rect_dst.w = (int)size_background.x;
 		rect_dst.h = (int)size_background.y;
 
-		SDL_RenderCopy(renderer, tex_background, nullptr, &rect_dst);
+		render_list.drawTexture(tex_background, nullptr, rect_dst);
 
 		rect_dst.x = (int)(pos_center.x - size_foreground.x / 2);
 		rect_dst.y = (int)(pos_center.y - size_foreground.y / 2);
 		rect_dst.w = (int)size_foreground.x;
 		rect_dst.h = (int)size_foreground.y;
 
-		SDL_RenderCopy(renderer, tex_foreground, nullptr, &rect_dst);
+		render_list.drawTexture(tex_foreground, nullptr, rect_dst);
 	}
 
 	/**
@@ -90,7 +94,9 @@ private:
 	Vector2 size_background;													 // 背景图像的尺寸
 
 	SDL_Texture* tex_foreground{ nullptr };										 // 前景纹理
-	SDL_Texture* tex_background{ nullptr };										 // 背景纹理
+	TextureHandle tex_win;														 // 胜利文字纹理
+	TextureHandle tex_loss;														 // 失败文字纹理
+	TextureHandle tex_background;												 // 背景纹理
 
 	Timer timer_display;														 // 定时器
 	bool is_end_display = false;												 // 是否结束显示的标志
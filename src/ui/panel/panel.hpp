@@ -2,6 +2,7 @@
 
 #include "../../manager/resource_manager.hpp"
 #include "../../basic/tile.hpp"
+#include "../../render/render_list.hpp"
 
 #include <SDL.h>
 #include <memory>
@@ -16,7 +17,7 @@ class Panel
 public:
 	Panel()
 	{
-		tex_select_cursor = std::shared_ptr<SDL_Texture>(ResourceManager::instance()->getTexturePool().find(ResID::Tex_UISelectCursor)->second, SDL_DestroyTexture);
+		tex_select_cursor = ResourceManager::instance()->acquireTexture(ResID::Tex_UISelectCursor);
 	} 
 	~Panel() = default;
 
@@ -118,13 +119,10 @@ public:
 
 	/**
 	 * @brief 更新面板状态
-	 * @param renderer SDL渲染器指针
 	 * @details 更新面板状态，包括更新文本内容
 	 */
-	virtual void onUpdate(SDL_Renderer* renderer)
+	virtual void onUpdate()
 	{
-		static auto* font = ResourceManager::instance()->getFontPool().find(ResID::Font_Main)->second;
-
 		if (hovered_target == HoveredTarget::NONE) return;
 
 		int value = 0;
@@ -141,29 +139,18 @@ public:
 			break;
 		}
 
-		SDL_DestroyTexture(tex_text_background.release());
-		SDL_DestroyTexture(tex_text_foreground.release());
-
-		std::string str_value = value < 0 ? "MAX" : std::to_string(value);
-		std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface_text_background(TTF_RenderText_Blended(font, str_value.c_str(), color_text_background), SDL_FreeSurface);
-		std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface_text_foreground(TTF_RenderText_Blended(font, str_value.c_str(), color_text_foreground), SDL_FreeSurface);
-
-		width_text = surface_text_background->w, height_text = surface_text_background->h;
-
-		tex_text_background.reset(SDL_CreateTextureFromSurface(renderer, surface_text_background.get()));
-		tex_text_foreground.reset(SDL_CreateTextureFromSurface(renderer, surface_text_foreground.get()));
-
-		SDL_FreeSurface(surface_text_background.release());
-		SDL_FreeSurface(surface_text_foreground.release());
+		str_value = value < 0 ? "MAX" : std::to_string(value);
 	}
 
 	/**
 	 * @brief 渲染面板内容
-	 * @param renderer SDL渲染器指针
+	 * @param render_list 渲染命令列表
 	 * @details 渲染面板内容，包括渲染面板背景、渲染面板边框、渲染文本
 	 */
-	virtual void onRender(SDL_Renderer* renderer)
+	virtual void onRender(RenderList& render_list)
 	{
+		static const FontHandle font = ResourceManager::instance()->acquireFont(ResID::Font_Main);
+
 		if (!visible) return;
 
 		SDL_Rect rect_dst_cursor =
@@ -173,7 +160,7 @@ public:
 			TILE_SIZE,
 			TILE_SIZE
 		};
-		SDL_RenderCopy(renderer, tex_select_cursor.get(), nullptr, &rect_dst_cursor);
+		render_list.drawTexture(tex_select_cursor, nullptr, rect_dst_cursor);
 
 		SDL_Rect rect_dst_panel =
 		{
@@ -183,7 +170,7 @@ public:
 			height
 		};
 
-		std::shared_ptr<SDL_Texture> tex_panel{ nullptr, SDL_DestroyTexture };
+		SDL_Texture* tex_panel = nullptr;
 		switch (hovered_target)
 		{
 		case Panel::HoveredTarget::NONE:
@@ -200,20 +187,18 @@ public:
 			break;
 		}
 
-		SDL_RenderCopy(renderer, tex_panel.get(), nullptr, &rect_dst_panel);
+		render_list.drawTexture(tex_panel, nullptr, rect_dst_panel);
 
 		if (hovered_target == HoveredTarget::NONE) return;
 
-		SDL_Rect rect_dst_text;
+		SDL_Point position_text;
+		position_text.x = center_position.x + offset_shadow.x;
+		position_text.y = center_position.y + TTF_FontHeight(font) / 2 + offset_shadow.y;
+		render_list.drawText(font, str_value, color_text_background, position_text, TextAlign::Center);
 
-		rect_dst_text.x = center_position.x - width_text / 2 + offset_shadow.x;
-		rect_dst_text.y = center_position.y + height_text / 2 + offset_shadow.y;
-		rect_dst_text.w = width_text, rect_dst_text.h = height_text;
-		SDL_RenderCopy(renderer, tex_text_background.get(), nullptr, &rect_dst_text);
-
-		rect_dst_text.x -= offset_shadow.x;
-		rect_dst_text.y -= offset_shadow.y;
-		SDL_RenderCopy(renderer, tex_text_foreground.get(), nullptr, &rect_dst_text);
+		position_text.x -= offset_shadow.x;
+		position_text.y -= offset_shadow.y;
+		render_list.drawText(font, str_value, color_text_foreground, position_text, TextAlign::Center);
 	}
 
 protected:
@@ -234,11 +219,11 @@ protected:
 	SDL_Point index_tile_selected = { 0, 0 };  // 选中的瓦片索引
 	SDL_Point center_position = { 0, 0 };	   // 中心位置
 
-	std::shared_ptr<SDL_Texture> tex_idle{ nullptr, SDL_DestroyTexture };			// 空闲纹理
-	std::shared_ptr<SDL_Texture> tex_hovered_top{ nullptr, SDL_DestroyTexture };    // 悬停在顶部纹理
-	std::shared_ptr<SDL_Texture> tex_hovered_left{ nullptr, SDL_DestroyTexture };   // 悬停在左侧纹理
-	std::shared_ptr<SDL_Texture> tex_hovered_right{ nullptr, SDL_DestroyTexture };  // 悬停在右侧纹理
-	std::shared_ptr<SDL_Texture> tex_select_cursor{ nullptr, SDL_DestroyTexture };  // 选择光标纹理
+	TextureHandle tex_idle;            // 空闲纹理
+	TextureHandle tex_hovered_top;     // 悬停在顶部纹理
+	TextureHandle tex_hovered_left;    // 悬停在左侧纹理
+	TextureHandle tex_hovered_right;   // 悬停在右侧纹理
+	TextureHandle tex_select_cursor;   // 选择光标纹理
 
 
 	int value_top = 0, value_left = 0, value_right = 0;  // 各个方向的值
@@ -272,9 +257,5 @@ private:
 	const SDL_Color color_text_background = { 175, 175, 175, 255 };  // 文本背景颜色
 	const SDL_Color color_text_foreground = { 255, 255, 255, 255 };  // 文本前景颜色
 
-	int width_text = 0;   // 文本宽度
-	int height_text = 0;  // 文本高度
-
-	std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> tex_text_background{ nullptr, SDL_DestroyTexture };  // 文本背景纹理
-	std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> tex_text_foreground{ nullptr, SDL_DestroyTexture };  // 文本前景纹理
+	std::string str_value;  // 悬停按钮对应的数值文本
 };
\ No newline at end of file
@@ -5,8 +5,6 @@
 #include "../../manager/tower_manager.hpp"
 #include "../../manager/coin_manager.hpp"
 
-#include <SDL2_gfxPrimitives.h>
-
 /**
  * @class PlacePanel
  * @brief 处理放置塔的面板类，继承自Panel类。
@@ -16,21 +14,20 @@ class PlacePanel : public Panel
 public:
     PlacePanel()
     {
-        const auto& texture_pool = ResourceManager::instance()->getTexturePool();
+        auto* resource = ResourceManager::instance();
 
-        tex_idle = std::shared_ptr<SDL_Texture>(texture_pool.find(ResID::Tex_UIPlaceIdle)->second, SDL_DestroyTexture);
-        tex_hovered_top = std::shared_ptr<SDL_Texture>(texture_pool.find(ResID::Tex_UIPlaceHoveredTop)->second, SDL_DestroyTexture);
-        tex_hovered_left = std::shared_ptr<SDL_Texture>(texture_pool.find(ResID::Tex_UIPlaceHoveredLeft)->second, SDL_DestroyTexture);
-        tex_hovered_right = std::shared_ptr<SDL_Texture>(texture_pool.find(ResID::Tex_UIPlaceHoveredRight)->second, SDL_DestroyTexture);
+        tex_idle = resource->acquireTexture(ResID::Tex_UIPlaceIdle);
+        tex_hovered_top = resource->acquireTexture(ResID::Tex_UIPlaceHoveredTop);
+        tex_hovered_left = resource->acquireTexture(ResID::Tex_UIPlaceHoveredLeft);
+        tex_hovered_right = resource->acquireTexture(ResID::Tex_UIPlaceHoveredRight);
     }
 
     ~PlacePanel() = default;
 
     /**
      * @brief 更新面板状态。
-     * @param renderer SDL渲染器指针。
      */
-    void onUpdate(SDL_Renderer* renderer) override
+    void onUpdate() override
     {
         static auto* tower_manager = TowerManager::instance();
 
@@ -42,14 +39,14 @@ public:
         region_left = (int)tower_manager->getViewRange(TowerType::Archer) * TILE_SIZE;
         region_right = (int)tower_manager->getViewRange(TowerType::Gunner) * TILE_SIZE;
 
-        Panel::onUpdate(renderer);
+        Panel::onUpdate();
     }
 
     /**
      * @brief 渲染面板。
-     * @param renderer SDL渲染器指针。
+     * @param render_list 渲染命令列表。
      */
-    void onRender(SDL_Renderer* renderer) override
+    void onRender(RenderList& render_list) override
     {
         if(!visible) return;
 
@@ -68,11 +65,11 @@ public:
         }
 
         if (region > 0) {
-            filledCircleRGBA(renderer, center_position.x, center_position.y, region, color_region_content.r, color_region_content.g, color_region_content.b, color_region_content.a);
-            aacircleRGBA(renderer, center_position.x, center_position.y, region, color_region_frame.r, color_region_frame.g, color_region_frame.b, color_region_frame.a);
+            render_list.fillCircle(center_position, region, color_region_content);
+            render_list.drawCircle(center_position, region, color_region_frame);
         }
 
-        Panel::onRender(renderer);
+        Panel::onRender(render_list);
     }
 
 protected:
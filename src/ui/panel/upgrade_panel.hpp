@@ -13,21 +13,20 @@ class UpgradePanel : public Panel
 public:
 	UpgradePanel()
 	{
-		const auto& texture_pool = ResourceManager::instance()->getTexturePool();
+		auto* resource = ResourceManager::instance();
 
-		tex_idle = std::shared_ptr<SDL_Texture>(texture_pool.find(ResID::Tex_UIUpgradeIdle)->second, SDL_DestroyTexture);
-		tex_hovered_top = std::shared_ptr<SDL_Texture>(texture_pool.find(ResID::Tex_UIUpgradeHoveredTop)->second, SDL_DestroyTexture);
-		tex_hovered_left = std::shared_ptr<SDL_Texture>(texture_pool.find(ResID::Tex_UIUpgradeHoveredLeft)->second, SDL_DestroyTexture);
-		tex_hovered_right = std::shared_ptr<SDL_Texture>(texture_pool.find(ResID::Tex_UIUpgradeHoveredRight)->second, SDL_DestroyTexture);
+		tex_idle = resource->acquireTexture(ResID::Tex_UIUpgradeIdle);
+		tex_hovered_top = resource->acquireTexture(ResID::Tex_UIUpgradeHoveredTop);
+		tex_hovered_left = resource->acquireTexture(ResID::Tex_UIUpgradeHoveredLeft);
+		tex_hovered_right = resource->acquireTexture(ResID::Tex_UIUpgradeHoveredRight);
 	}
 
 	~UpgradePanel() = default;
 
 	/**
 	 * @brief 更新面板状态
-	 * @param renderer 渲染器
 	 */
-	void onUpdate(SDL_Renderer* renderer) override
+	void onUpdate() override
 	{
 		static auto* tower_manager = TowerManager::instance();
 
@@ -35,7 +34,7 @@ public:
 		value_left = (int)tower_manager->getUpgradeTowerCost(TowerType::Archer);
 		value_right = (int)tower_manager->getUpgradeTowerCost(TowerType::Gunner);
 
-		Panel::onUpdate(renderer);
+		Panel::onUpdate();
 	}
 
 protected:
@@ -4,15 +4,18 @@
 #include "../manager/coin_manager.hpp"
 #include "../manager/resource_manager.hpp"
 #include "../manager/player_manager.hpp"
+#include "../render/render_list.hpp"
 
 #include <SDL.h>
-#include <SDL2_gfxPrimitives.h>
-#include <memory>
+#include <algorithm>
+#include <cstdint>
 #include <string>
 
 /**
  * @brief 状态栏类
- * @details 显示玩家的生命值、金币数量、魔法值等信息，并渲染相关图标和文本
+ * @details 显示玩家的生命值、金币数量、魔法值等信息，并渲染相关图标和文本。
+ *          状态栏作为保留层缓存在目标纹理中，只在生命值、金币数量或
+ *          按MP_STEP量化后的魔法值变化时重绘
  */
 class StatusBar
 {
@@ -33,112 +36,113 @@ public:
 
     /**
      * @brief 更新状态栏显示内容
-     * @param renderer SDL渲染器指针
-     * @details 更新金币数量文本，并刷新相关纹理
+     * @details 检查各项输入，有变化时更新内容版本并记录失效原因
      */
-    void onUpdate(SDL_Renderer* renderer)
+    void onUpdate()
     {
-        static auto* font = ResourceManager::instance()->getFontPool().find(ResID::Font_Main)->second;
-
-        // 保存当前文本内容，用于检测是否发生变化
-        static std::string last_str_val;
-        std::string str_val = std::to_string((int)CoinManager::instance()->getCurrentCoinNum());
-
-        // 如果文本没有变化，则直接跳过更新
-        if (str_val == last_str_val)
-            return;
-
-        // 更新文本内容
-        last_str_val = str_val;
-
-        // 销毁旧的纹理
-        SDL_DestroyTexture(tex_text_background.get());
-        tex_text_background = nullptr;
-        SDL_DestroyTexture(tex_text_foreground.get());
-        tex_text_foreground = nullptr;
-
-        // 创建新的表面和纹理
-        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface_text_background(
-            TTF_RenderText_Blended(font, str_val.c_str(), color_text_background), SDL_FreeSurface);
-        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface_text_foreground(
-            TTF_RenderText_Blended(font, str_val.c_str(), color_text_foreground), SDL_FreeSurface);
-
-        // 设置文本的宽高
-        width_text = surface_text_background->w;
-        height_text = surface_text_background->h;
-
-        // 创建新的纹理
-        tex_text_background = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(
-            SDL_CreateTextureFromSurface(renderer, surface_text_background.get()), SDL_DestroyTexture);
-        tex_text_foreground = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(
-            SDL_CreateTextureFromSurface(renderer, surface_text_foreground.get()), SDL_DestroyTexture);
+        const int num_hp_current = (int)HomeManager::instance()->getCurrentHPNum();
+        const int num_coin_current = (int)CoinManager::instance()->getCurrentCoinNum();
+        const int step_mp_current = (int)(PlayerManager::instance()->getCurrentMP() / MP_STEP);
+
+        bool is_changed = false;
+        if (num_hp_current != num_hp) {
+            num_hp = num_hp_current;
+            num_invalidate_hp++;
+            is_changed = true;
+        }
+        if (num_coin_current != num_coin) {
+            num_coin = num_coin_current;
+            str_coin = std::to_string(num_coin);
+            num_invalidate_coin++;
+            is_changed = true;
+        }
+        if (step_mp_current != step_mp) {
+            step_mp = step_mp_current;
+            num_invalidate_mp++;
+            is_changed = true;
+        }
+
+        if (is_changed)
+            version++;
     }
 
     /**
      * @brief 渲染状态栏内容
-     * @param renderer SDL渲染器指针
+     * @param render_list 渲染命令列表
      * @details 渲染房屋头像、生命值、金币数量、魔法值条及玩家头像
      */
-    void onRender(SDL_Renderer* renderer)
+    void onRender(RenderList& render_list) const
     {
-        static SDL_Rect rect_dst;
-        static const auto& tex_pool = ResourceManager::instance()->getTexturePool();
-        static auto* tex_coin = tex_pool.find(ResID::Tex_UICoin)->second;
-        static auto* tex_heart = tex_pool.find(ResID::Tex_UIHeart)->second;
-        static auto* tex_home_avatar = tex_pool.find(ResID::Tex_UIHomeAvatar)->second;
-        static auto* tex_player_avatar = tex_pool.find(ResID::Tex_UIPlayerAvatar)->second;
+        SDL_Rect rect_dst;
+        static auto* resource = ResourceManager::instance();
+        static const TextureHandle tex_coin = resource->acquireTexture(ResID::Tex_UICoin);
+        static const TextureHandle tex_heart = resource->acquireTexture(ResID::Tex_UIHeart);
+        static const TextureHandle tex_home_avatar = resource->acquireTexture(ResID::Tex_UIHomeAvatar);
+        static const TextureHandle tex_player_avatar = resource->acquireTexture(ResID::Tex_UIPlayerAvatar);
+        static const FontHandle font = resource->acquireFont(ResID::Font_Main);
+
+        const int width = 78 + 15 + std::max(num_hp * (size_heart + 2), width_content_min);
+        render_list.beginRetained(RetainedID::StatusBar, version, { position.x, position.y, width, 78 + 5 + 65 });
 
         // 绘制房屋头像
         rect_dst.x = position.x, rect_dst.y = position.y;
         rect_dst.w = 78, rect_dst.h = 78;
-        SDL_RenderCopy(renderer, tex_home_avatar, nullptr, &rect_dst);
+        render_list.drawTexture(tex_home_avatar, nullptr, rect_dst);
 
         // 绘制生命值
-        for (int i = 0; i < (int)HomeManager::instance()->getCurrentHPNum(); i++) {
+        for (int i = 0; i < num_hp; i++) {
             rect_dst.x = position.x + 78 + 15 + i * (32 + 2);
             rect_dst.y = position.y;
             rect_dst.w = 32, rect_dst.h = 32;
-            SDL_RenderCopy(renderer, tex_heart, nullptr, &rect_dst);
+            render_list.drawTexture(tex_heart, nullptr, rect_dst);
         }
 
         // 绘制金币数量
         rect_dst.x = position.x + 78 + 15;
         rect_dst.y = position.y + 78 - 32;
         rect_dst.w = 32, rect_dst.h = 32;
-        SDL_RenderCopy(renderer, tex_coin, nullptr, &rect_dst);
+        render_list.drawTexture(tex_coin, nullptr, rect_dst);
 
         // 绘制文本背景
-        rect_dst.x += 32 + 10 + offset_shadow.x;
-        rect_dst.y = rect_dst.y + (32 - height_text) / 2 + offset_shadow.y;
-        rect_dst.w = width_text, rect_dst.h = height_text;
-        SDL_RenderCopy(renderer, tex_text_background.get(), nullptr, &rect_dst);
+        SDL_Point position_text;
+        position_text.x = rect_dst.x + 32 + 10 + offset_shadow.x;
+        position_text.y = rect_dst.y + (32 - TTF_FontHeight(font)) / 2 + offset_shadow.y;
+        render_list.drawText(font, str_coin, color_text_background, position_text);
 
         // 绘制文本前景
-        rect_dst.x -= offset_shadow.x;
-        rect_dst.y -= offset_shadow.y;
-        SDL_RenderCopy(renderer, tex_text_foreground.get(), nullptr, &rect_dst);
+        position_text.x -= offset_shadow.x;
+        position_text.y -= offset_shadow.y;
+        render_list.drawText(font, str_coin, color_text_foreground, position_text);
 
         // 绘制玩家头像
         rect_dst.x = position.x + (78 - 65) / 2;
         rect_dst.y = position.y + 78 + 5;
         rect_dst.w = 65, rect_dst.h = 65;
-        SDL_RenderCopy(renderer, tex_player_avatar, nullptr, &rect_dst);
+        render_list.drawTexture(tex_player_avatar, nullptr, rect_dst);
 
         // 绘制魔法值条背景
         rect_dst.x = position.x + 78 + 15;
         rect_dst.y += 10;
-        roundedBoxRGBA(renderer, rect_dst.x, rect_dst.y, rect_dst.x + width_mp_bar, rect_dst.y + height_mp_bar, 4, color_mp_bar_background.r, color_mp_bar_background.g, color_mp_bar_background.b, color_mp_bar_background.a);
+        render_list.fillRoundedBox({ rect_dst.x, rect_dst.y, width_mp_bar, height_mp_bar }, 4, color_mp_bar_background);
 
         // 绘制魔法值条前景
         rect_dst.x += width_border_mp_bar;
         rect_dst.y += width_border_mp_bar;
         rect_dst.w = width_mp_bar - 2 * width_border_mp_bar;
         rect_dst.h = height_mp_bar - 2 * width_border_mp_bar;
-        double process = PlayerManager::instance()->getCurrentMP() / 100.0;
-        roundedBoxRGBA(renderer, rect_dst.x, rect_dst.y, rect_dst.x + (int)(rect_dst.w * process), rect_dst.y + rect_dst.h, 2, color_mp_bar_foreground.r, color_mp_bar_foreground.g, color_mp_bar_foreground.b, color_mp_bar_foreground.a);
+        double process = std::clamp(step_mp * MP_STEP / 100.0, 0.0, 1.0);
+        render_list.fillRoundedBox({ rect_dst.x, rect_dst.y, (int)(rect_dst.w * process), rect_dst.h }, 2, color_mp_bar_foreground);
+
+        render_list.endRetained();
     }
 
+    size_t getInvalidateCountHP() const { return num_invalidate_hp; }       // 因生命值变化而失效的次数
+    size_t getInvalidateCountCoin() const { return num_invalidate_coin; }   // 因金币数量变化而失效的次数
+    size_t getInvalidateCountMP() const { return num_invalidate_mp; }       // 因魔法值变化而失效的次数
+
 private:
+    static constexpr double MP_STEP = 2.5;                                                                          // 魔法值条的量化步长
+    const int width_content_min = 300;                                                                              // 右侧内容的最小宽度(魔法值条与金币数量)
     const int size_heart = 32;                                                                                      // 生命值图标大小
     const int width_mp_bar = 200;                                                                                   // 魔法值条宽度
     const int height_mp_bar = 20;                                                                                   // 魔法值条高度
@@ -151,7 +155,12 @@ private:
 
 private:
     SDL_Point position = { 0, 0 };                                                                                  // 状态栏位置
-    int width_text = 0, height_text = 0;                                                                            // 文本宽高
-    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> tex_text_background{ nullptr, SDL_DestroyTexture }; // 文本背景纹理
-    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> tex_text_foreground{ nullptr, SDL_DestroyTexture }; // 文本前景纹理
+    std::string str_coin;                                                                                           // 金币数量文本
+    int num_hp = -1;                                                                                                // 显示的生命值
+    int num_coin = -1;                                                                                              // 显示的金币数量
+    int step_mp = -1;                                                                                               // 显示的魔法值量化步数
+    uint32_t version = 0;                                                                                           // 内容版本
+    size_t num_invalidate_hp = 0;                                                                                   // 因生命值变化而失效的次数
+    size_t num_invalidate_coin = 0;                                                                                 // 因金币数量变化而失效的次数
+    size_t num_invalidate_mp = 0;                                                                                   // 因魔法值变化而失效的次数
 };
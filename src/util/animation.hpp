@@ -1,16 +1,64 @@
 ﻿#pragma once
 
-#include "timer.hpp"
+#include "../render/render_list.hpp"
 
 #include <SDL.h>
 #include <functional>
+#include <memory>
 #include <vector>
 
+/**
+ * @brief 动画帧数据(精灵图纹理与各帧源矩形)
+ *
+ * 帧数据创建后不再修改，可由多个Animation实例共享，
+ * 同一原型的所有对象只需持有一份帧数据
+ */
+struct AnimationClip
+{
+    SDL_Texture* texture = nullptr;         // 精灵图纹理
+    std::vector<SDL_Rect> rect_src_list;    // 源矩形列表
+    int width_frame = 0;                    // 单帧宽度
+    int height_frame = 0;                   // 单帧高度
+
+    /**
+     * @brief 根据精灵图切分方式创建帧数据
+     *
+     * @param texture 精灵图纹理
+     * @param num_h 水平方向的帧数
+     * @param num_v 垂直方向的帧数
+     * @param index_list 动画帧序列索引列表
+     * @return 共享的只读帧数据
+     */
+    static std::shared_ptr<const AnimationClip> create(SDL_Texture* texture, int num_h, int num_v, const std::vector<int>& index_list)
+    {
+        int tex_width, tex_height;
+        auto clip = std::make_shared<AnimationClip>();
+
+        clip->texture = texture;
+        SDL_QueryTexture(texture, nullptr, nullptr, &tex_width, &tex_height);
+        clip->width_frame = tex_width / num_h, clip->height_frame = tex_height / num_v;
+
+        clip->rect_src_list.resize(index_list.size());
+        for (size_t i = 0; i < index_list.size(); i++) {
+            int index = index_list[i];
+            SDL_Rect& rect_src = clip->rect_src_list[i];
+
+            rect_src.x = (index % num_h) * clip->width_frame;
+            rect_src.y = (index / num_h) * clip->height_frame;
+            rect_src.w = clip->width_frame;
+            rect_src.h = clip->height_frame;
+        }
+
+        return clip;
+    }
+};
+
 /**
  * @brief 2D精灵动画控制类
  *
  * 用于管理和播放基于精灵图(Sprite Sheet)的2D动画
  * 支持循环/非循环播放、帧间隔控制、播放完成回调等功能
+ * 内部不持有指向自身的回调，可以安全地拷贝和移动，便于按值存放在连续数组中
  */
 class Animation
 {
@@ -19,36 +67,19 @@ public:
     using PlayCallback = std::function<void()>;
 
 public:
-    /**
-     * @brief 构造函数
-     *
-     * 初始化计时器并设置帧更新逻辑
-     */
-    Animation()
-    {
-        m_timer.setOneShot(false);
-        m_timer.setOnTimeOut(
-            [&]() {
-                index_frame++;
-                if (index_frame >= rect_src_list.size()) {
-                    index_frame = is_loop ? 0 : rect_src_list.size() - 1;
-                    if (!is_loop && on_finished) 
-                        on_finished();
-                }
-            });
-    }
-   
+    Animation() = default;
     ~Animation() = default;
 
     /**
      * @brief 重置动画状态
      *
-     * 重启计时器并将帧索引设置为0
+     * 清零帧计时并将帧索引设置为0
      */
     void reset()
     {
-        m_timer.restart();
+        pass_time = 0;
         index_frame = 0;
+        is_finished = false;
     }
 
     /**
@@ -61,22 +92,16 @@ public:
      */
     void setFrameData(SDL_Texture* texture, int num_h, int num_v, const std::vector<int>& index_list)
     {
-        int tex_width, tex_height;
-
-        this->texture = texture;
-        SDL_QueryTexture(texture, nullptr, nullptr, &tex_width, &tex_height);
-        width_frame = tex_width / num_h, height_frame = tex_height / num_v;
-
-        rect_src_list.resize(index_list.size());
-        for (size_t i = 0; i < index_list.size(); i++) {
-            int index = index_list[i];
-            SDL_Rect& rect_src = rect_src_list[i];
+        clip = AnimationClip::create(texture, num_h, num_v, index_list);
+    }
 
-            rect_src.x = (index % num_h) * width_frame;
-            rect_src.y = (index / num_h) * height_frame;
-            rect_src.w = width_frame;
-            rect_src.h = height_frame;
-        }
+    /**
+     * @brief 设置共享的动画帧数据
+     * @param clip 帧数据，通常来自对象原型
+     */
+    void setClip(const std::shared_ptr<const AnimationClip>& clip)
+    {
+        this->clip = clip;
     }
 
     /**
@@ -94,7 +119,7 @@ public:
      */
     void setInterval(double interval)
     {
-        m_timer.setWaitTime(interval);
+        this->interval = interval;
     }
 
     /**
@@ -106,41 +131,67 @@ public:
         this->on_finished = callback;
     }
 
+    /**
+     * @brief 检查非循环动画是否已播放完成
+     * @return 播放到最后一帧之后返回true，重置后恢复为false
+     *
+     * 可代替播放完成回调，供按值存放、不便绑定回调的对象轮询
+     */
+    bool isFinished() const
+    {
+        return is_finished;
+    }
+
     /**
      * @brief 更新动画状态
      * @param delta_time 距离上次更新的时间间隔(秒)
+     *
+     * 时间间隔跨越多帧时连续推进，非循环动画播放完成后不再推进；
+     * 帧间隔不大于0时每次更新至多推进一帧
      */
     void onUpdate(double delta_time)
     {
-        m_timer.onUpdate(delta_time);
+        pass_time += delta_time;
+        while (pass_time >= interval) {
+            pass_time -= interval;
+
+            index_frame++;
+            if (index_frame >= clip->rect_src_list.size()) {
+                index_frame = is_loop ? 0 : clip->rect_src_list.size() - 1;
+                if (!is_loop) {
+                    is_finished = true;
+                    if (on_finished)
+                        on_finished();
+                    break;
+                }
+            }
+
+            if (interval <= 0)
+                break;
+        }
     }
 
     /**
      * @brief 渲染当前动画帧
      *
-     * @param renderer SDL渲染器
+     * @param render_list 渲染命令列表
      * @param posion_dst 目标位置
      * @param angle 旋转角度(默认为0)
+     * @param is_flash 是否叠加受击闪白(默认为false)
      */
-    void onRender(SDL_Renderer* renderer, const SDL_Point& posion_dst, double angle = 0) const
+    void onRender(RenderList& render_list, const SDL_Point& posion_dst, double angle = 0, bool is_flash = false) const
     {
-        static SDL_Rect rect_dst;
+        const SDL_Rect rect_dst = { posion_dst.x, posion_dst.y, clip->width_frame, clip->height_frame };
 
-        rect_dst.x = posion_dst.x;
-        rect_dst.y = posion_dst.y;
-        rect_dst.w = width_frame;
-        rect_dst.h = height_frame;
-
-        SDL_RenderCopyEx(renderer, texture, &rect_src_list[index_frame], &rect_dst, angle, nullptr, SDL_RendererFlip::SDL_FLIP_NONE);
+        render_list.drawTexture(clip->texture, &clip->rect_src_list[index_frame], rect_dst, angle, is_flash);
     }
 
 private:
-    Timer m_timer;                          // 帧更新计时器
+    double interval = 0;                    // 帧间隔(秒)
+    double pass_time = 0;                   // 当前帧已经过的时间(秒)
     bool is_loop = true;                    // 是否循环播放
+    bool is_finished = false;               // 非循环动画是否已播放完成
     size_t index_frame = 0;                 // 当前帧索引
     PlayCallback on_finished;               // 播放完成回调
-    SDL_Texture* texture = nullptr;         // 精灵图纹理
-    std::vector<SDL_Rect> rect_src_list;    // 源矩形列表
-    int width_frame = 0;                    // 单帧宽度
-    int height_frame = 0;                   // 单帧高度
+    std::shared_ptr<const AnimationClip> clip;  // 帧数据(可共享)
 };
@@ -0,0 +1,113 @@
+﻿#pragma once
+
+#include <chrono>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/**
+ * @brief 按状态分别统计进程的CPU占用率
+ *
+ * 调用switchTo()切换到某个状态时结算上一状态经过的墙钟时间与进程CPU时间，
+ * CPU占用率 = CPU时间 / 墙钟时间，100%表示占满一个核心
+ */
+class CpuUsage
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param num_state 状态数量，状态以0 ~ num_state-1编号
+     */
+    explicit CpuUsage(size_t num_state)
+        : wall_time_list(num_state, 0), cpu_time_list(num_state, 0)
+    {
+        wall_time_last = getWallTime();
+        cpu_time_last = getProcessCpuTime();
+    }
+
+    ~CpuUsage() = default;
+
+    /**
+     * @brief 切换当前状态，并把上次切换以来的时间计入原状态
+     * @param state 新状态编号
+     */
+    void switchTo(size_t state)
+    {
+        const double wall_time = getWallTime();
+        const double cpu_time = getProcessCpuTime();
+
+        wall_time_list[state_current] += wall_time - wall_time_last;
+        cpu_time_list[state_current] += cpu_time - cpu_time_last;
+
+        wall_time_last = wall_time;
+        cpu_time_last = cpu_time;
+        state_current = state;
+    }
+
+    /**
+     * @brief 获取指定状态累计的墙钟时间
+     * @param state 状态编号
+     * @return 墙钟时间(秒)
+     */
+    double getWallTime(size_t state) const
+    {
+        return wall_time_list[state];
+    }
+
+    /**
+     * @brief 获取指定状态的平均CPU占用率
+     * @param state 状态编号
+     * @return CPU占用率(0~1，多线程时可能超过1)，未经历该状态时返回0
+     */
+    double getUsage(size_t state) const
+    {
+        return wall_time_list[state] > 0 ? cpu_time_list[state] / wall_time_list[state] : 0;
+    }
+
+    /**
+     * @brief 获取进程累计消耗的CPU时间(用户态+内核态)
+     * @return CPU时间(秒)
+     */
+    static double getProcessCpuTime()
+    {
+#ifdef _WIN32
+        FILETIME time_creation, time_exit, time_kernel, time_user;
+        if (!GetProcessTimes(GetCurrentProcess(), &time_creation, &time_exit, &time_kernel, &time_user))
+            return 0;
+
+        auto toSeconds = [](const FILETIME& time) {
+            return (double)(((unsigned long long)time.dwHighDateTime << 32) | time.dwLowDateTime) * 1e-7;
+        };
+        return toSeconds(time_kernel) + toSeconds(time_user);
+#else
+        timespec time;
+        if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0)
+            return 0;
+
+        return time.tv_sec + time.tv_nsec * 1e-9;
+#endif
+    }
+
+private:
+    std::vector<double> wall_time_list;    // 各状态累计的墙钟时间(秒)
+    std::vector<double> cpu_time_list;     // 各状态累计的CPU时间(秒)
+    size_t state_current = 0;              // 当前状态
+    double wall_time_last = 0;             // 上次切换时的墙钟时间(秒)
+    double cpu_time_last = 0;              // 上次切换时的CPU时间(秒)
+
+private:
+    static double getWallTime()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
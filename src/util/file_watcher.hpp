@@ -0,0 +1,157 @@
+﻿#pragma once
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+/**
+ * @brief 文件变化监视器
+ *
+ * Linux下使用inotify监视文件所在的目录，编辑器以"写临时文件再改名"方式保存时也能收到通知；
+ * 其他平台每隔一段时间比较文件的修改时间。poll()不阻塞，只报告自上次调用以来发生变化的文件
+ */
+class FileWatcher
+{
+public:
+    FileWatcher() = default;
+    ~FileWatcher() { close(); }
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief 开始监视文件
+     * @param path 文件路径
+     * @return 监视成功返回true，文件所在目录不存在或监视失败返回false
+     */
+    bool watch(const std::string& path)
+    {
+        Item item;
+        item.path = path;
+
+        const std::filesystem::path path_file(path);
+        item.name = path_file.filename().string();
+
+#ifdef __linux__
+        if (fd < 0) {
+            fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (fd < 0)
+                return false;
+        }
+
+        std::string dir = path_file.parent_path().string();
+        if (dir.empty())
+            dir = ".";
+
+        // 同一目录重复添加时返回同一个描述符
+        item.wd = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (item.wd < 0)
+            return false;
+#else
+        std::error_code error;
+        item.time_write = std::filesystem::last_write_time(path_file, error);
+        if (error)
+            return false;
+#endif
+
+        item_list.push_back(item);
+        return true;
+    }
+
+    /**
+     * @brief 收集发生变化的文件
+     * @param path_list 输出参数，发生变化的文件路径，每个文件最多出现一次
+     */
+    void poll(std::vector<std::string>& path_list)
+    {
+        path_list.clear();
+        std::vector<bool> is_changed_list(item_list.size(), false);
+
+#ifdef __linux__
+        if (fd < 0)
+            return;
+
+        alignas(inotify_event) char buffer[4096];
+        while (true) {
+            const ssize_t size_read = read(fd, buffer, sizeof(buffer));
+            if (size_read <= 0)
+                break;
+
+            for (ssize_t offset = 0; offset < size_read;) {
+                const auto* event = (const inotify_event*)(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if (event->len == 0)
+                    continue;
+
+                for (size_t i = 0; i < item_list.size(); i++)
+                    if (item_list[i].wd == event->wd && item_list[i].name == event->name)
+                        is_changed_list[i] = true;
+            }
+        }
+#else
+        const auto time_now = std::chrono::steady_clock::now();
+        if (time_now - time_poll_last < POLL_INTERVAL)
+            return;
+        time_poll_last = time_now;
+
+        for (size_t i = 0; i < item_list.size(); i++) {
+            std::error_code error;
+            const auto time_write = std::filesystem::last_write_time(item_list[i].path, error);
+            if (error || time_write == item_list[i].time_write)
+                continue;
+
+            item_list[i].time_write = time_write;
+            is_changed_list[i] = true;
+        }
+#endif
+
+        for (size_t i = 0; i < item_list.size(); i++)
+            if (is_changed_list[i])
+                path_list.push_back(item_list[i].path);
+    }
+
+    /**
+     * @brief 停止监视所有文件
+     */
+    void close()
+    {
+#ifdef __linux__
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+#endif
+        item_list.clear();
+    }
+
+private:
+    /**
+     * @brief 被监视的文件
+     */
+    struct Item
+    {
+        std::string path;                                   // 文件路径
+        std::string name;                                   // 文件名，用于匹配目录中的事件
+#ifdef __linux__
+        int wd = -1;                                        // 所在目录的inotify监视描述符
+#else
+        std::filesystem::file_time_type time_write;         // 上次记录的修改时间
+#endif
+    };
+
+    std::vector<Item> item_list;                            // 被监视的文件列表
+
+#ifdef __linux__
+    int fd = -1;                                            // inotify实例
+#else
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{500};  // 比较修改时间的间隔
+    std::chrono::steady_clock::time_point time_poll_last;   // 上次比较修改时间的时刻
+#endif
+};
@@ -0,0 +1,104 @@
+﻿#pragma once
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+/**
+ * @brief 帧率控制模式
+ */
+enum class PacingMode
+{
+    VSync,      // 由垂直同步控制帧率，不额外限帧
+    Limiter,    // 关闭垂直同步，先睡眠再自旋等待到目标时刻
+    Uncapped    // 关闭垂直同步且不限帧
+};
+
+/**
+ * @brief 帧率控制器
+ *
+ * Limiter模式下以截止时刻而不是上一帧的耗时计算等待时间，避免误差累积；
+ * 先用系统睡眠等待到截止时刻前的一小段余量，剩余时间自旋，
+ * 弥补毫秒级睡眠精度不足带来的抖动。其余模式下wait()立即返回
+ */
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    FramePacer() = default;
+    ~FramePacer() = default;
+
+    /**
+     * @brief 由名称解析帧率控制模式
+     * @param name 模式名称："vsync"、"limiter"或"uncapped"
+     * @param mode 输出参数，解析后的模式
+     * @return 名称有效返回true，否则返回false
+     */
+    static bool parseMode(const std::string& name, PacingMode& mode)
+    {
+        if (name == "vsync")
+            mode = PacingMode::VSync;
+        else if (name == "limiter")
+            mode = PacingMode::Limiter;
+        else if (name == "uncapped")
+            mode = PacingMode::Uncapped;
+        else
+            return false;
+
+        return true;
+    }
+
+    /**
+     * @brief 设置帧率控制模式
+     * @param mode 帧率控制模式
+     */
+    void setMode(PacingMode mode)
+    {
+        this->mode = mode;
+        time_deadline = Clock::now();
+    }
+
+    PacingMode getMode() const { return mode; }
+
+    /**
+     * @brief 设置目标帧间隔
+     * @param frame_time 目标帧间隔(秒)
+     */
+    void setFrameTime(double frame_time)
+    {
+        this->frame_time = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(frame_time));
+    }
+
+    /**
+     * @brief 等待到下一帧的开始时刻
+     * @details 落后超过一帧时不再追赶，从当前时刻重新计时
+     */
+    void wait()
+    {
+        if (mode != PacingMode::Limiter)
+            return;
+
+        time_deadline += frame_time;
+
+        auto time_now = Clock::now();
+        if (time_now > time_deadline + frame_time) {
+            time_deadline = time_now;
+            return;
+        }
+
+        if (time_deadline - time_now > SPIN_MARGIN)
+            std::this_thread::sleep_for(time_deadline - time_now - SPIN_MARGIN);
+
+        while (Clock::now() < time_deadline)
+            std::this_thread::yield();
+    }
+
+private:
+    static constexpr std::chrono::microseconds SPIN_MARGIN{2000};   // 自旋等待的余量
+
+    PacingMode mode = PacingMode::VSync;                            // 帧率控制模式
+    Clock::duration frame_time = std::chrono::milliseconds(16);     // 目标帧间隔
+    Clock::time_point time_deadline = Clock::now();                 // 下一帧的开始时刻
+};
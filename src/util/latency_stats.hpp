@@ -0,0 +1,51 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 延迟采样统计，按百分位数汇总
+ *
+ * 采样数量超过上限后不再记录，避免长时间运行时内存无限增长
+ */
+class LatencyStats
+{
+public:
+    LatencyStats() = default;
+    ~LatencyStats() = default;
+
+    /**
+     * @brief 记录一个延迟样本
+     * @param latency 延迟(秒)
+     */
+    void add(double latency)
+    {
+        if (sample_list.size() < MAX_SAMPLE_NUM)
+            sample_list.push_back(latency);
+    }
+
+    size_t getCount() const { return sample_list.size(); }    // 样本数量
+
+    /**
+     * @brief 获取百分位数
+     * @param percent 百分比(0~100)
+     * @return 对应百分位的延迟(秒)，没有样本时返回0
+     */
+    double getPercentile(double percent) const
+    {
+        if (sample_list.empty())
+            return 0;
+
+        sorted_list = sample_list;
+        const size_t index = std::min(sorted_list.size() - 1, (size_t)(percent / 100 * sorted_list.size()));
+        std::nth_element(sorted_list.begin(), sorted_list.begin() + index, sorted_list.end());
+        return sorted_list[index];
+    }
+
+private:
+    static constexpr size_t MAX_SAMPLE_NUM = 1 << 16;   // 最多记录的样本数量
+
+    std::vector<double> sample_list;                    // 延迟样本(秒)
+    mutable std::vector<double> sorted_list;            // 求百分位数时的临时数组
+};
@@ -0,0 +1,131 @@
+﻿#pragma once
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 只读内存映射文件
+ *
+ * 文件内容按需由操作系统分页载入，打开文件不会复制数据，
+ * 映射在close()或析构前一直有效，期间可以直接引用其中的数据
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief 映射文件
+     * @param path 文件路径
+     * @return 映射成功返回true，文件不存在、为空或映射失败返回false
+     */
+    bool open(const std::string& path)
+    {
+        close();
+
+#ifdef _WIN32
+        handle_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle_file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size_file;
+        if (!GetFileSizeEx(handle_file, &size_file) || size_file.QuadPart == 0) {
+            close();
+            return false;
+        }
+
+        handle_mapping = CreateFileMappingA(handle_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!handle_mapping) {
+            close();
+            return false;
+        }
+
+        data_mapped = (const uint8_t*)MapViewOfFile(handle_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!data_mapped) {
+            close();
+            return false;
+        }
+        size_mapped = (size_t)size_file.QuadPart;
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat stat_file;
+        if (fstat(fd, &stat_file) != 0 || stat_file.st_size == 0) {
+            close();
+            return false;
+        }
+
+        void* address = mmap(nullptr, (size_t)stat_file.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            close();
+            return false;
+        }
+        data_mapped = (const uint8_t*)address;
+        size_mapped = (size_t)stat_file.st_size;
+#endif
+
+        return true;
+    }
+
+    /**
+     * @brief 解除映射并关闭文件
+     */
+    void close()
+    {
+#ifdef _WIN32
+        if (data_mapped)
+            UnmapViewOfFile(data_mapped);
+        if (handle_mapping)
+            CloseHandle(handle_mapping);
+        if (handle_file != INVALID_HANDLE_VALUE)
+            CloseHandle(handle_file);
+        handle_mapping = nullptr;
+        handle_file = INVALID_HANDLE_VALUE;
+#else
+        if (data_mapped)
+            munmap((void*)data_mapped, size_mapped);
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+#endif
+
+        data_mapped = nullptr;
+        size_mapped = 0;
+    }
+
+    bool isOpen() const { return data_mapped != nullptr; }      // 是否已映射
+    const uint8_t* data() const { return data_mapped; }         // 映射的数据
+    size_t size() const { return size_mapped; }                 // 文件大小
+
+private:
+#ifdef _WIN32
+    HANDLE handle_file = INVALID_HANDLE_VALUE;  // 文件句柄
+    HANDLE handle_mapping = nullptr;            // 映射对象句柄
+#else
+    int fd = -1;                                // 文件描述符
+#endif
+    const uint8_t* data_mapped = nullptr;       // 映射的起始地址
+    size_t size_mapped = 0;                     // 映射的大小
+};
@@ -0,0 +1,102 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 对象池模板类，复用对象以避免运行期频繁的堆分配
+ * @tparam T 对象类型
+ *
+ * 池持有所有对象的所有权，acquire()取出空闲对象，release()归还。
+ * 对象归还后不会析构，再次取出前由调用方负责重置状态。
+ * 池为空时acquire()会通过工厂函数临时分配，并记录一次未命中。
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+    /// 对象创建工厂函数类型
+    using Factory = std::function<T*()>;
+
+public:
+    ObjectPool() = default;
+    ~ObjectPool() = default;
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    ObjectPool(ObjectPool&&) = default;
+    ObjectPool& operator=(ObjectPool&&) = default;
+
+    /**
+     * @brief 设置对象创建工厂
+     * @param factory 工厂函数，未设置时使用T的默认构造函数
+     */
+    void setFactory(Factory factory)
+    {
+        this->factory = factory;
+    }
+
+    /**
+     * @brief 预热对象池，保证至少有指定数量的空闲对象
+     * @param count 需要的空闲对象数量
+     */
+    void reserve(size_t count)
+    {
+        while (free_list.size() < count)
+            free_list.push_back(create());
+    }
+
+    /**
+     * @brief 取出一个空闲对象
+     * @return 对象指针，池为空时新分配一个
+     */
+    T* acquire()
+    {
+        if (free_list.empty()) {
+            num_miss++;
+            return create();
+        }
+
+        T* object = free_list.back();
+        free_list.pop_back();
+        return object;
+    }
+
+    /**
+     * @brief 归还对象
+     * @param object 由本池取出的对象指针
+     */
+    void release(T* object)
+    {
+        free_list.push_back(object);
+    }
+
+    size_t getFreeCount() const { return free_list.size(); }    // 空闲对象数量
+    size_t getTotalCount() const { return storage.size(); }     // 池内对象总数
+    size_t getMissCount() const { return num_miss; }            // 未命中(运行期分配)次数
+
+private:
+    Factory factory;                            // 对象创建工厂
+    std::vector<std::unique_ptr<T>> storage;    // 持有所有对象
+    std::vector<T*> free_list;                  // 空闲对象列表
+    size_t num_miss = 0;                        // 未命中次数
+
+private:
+    /**
+     * @brief 分配一个新对象并登记所有权
+     *
+     * 同时保证空闲列表容量不小于对象总数，归还对象时不再触发分配
+     */
+    T* create()
+    {
+        T* object = factory ? factory() : new T();
+        storage.emplace_back(object);
+
+        if (free_list.capacity() < storage.size())
+            free_list.reserve(storage.capacity());
+
+        return object;
+    }
+};
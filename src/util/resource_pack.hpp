@@ -0,0 +1,240 @@
+﻿#pragma once
+
+#include "mapped_file.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 资源包条目类型
+ */
+enum class PackEntryType : uint32_t
+{
+    Raw,    // 原始文件内容：音乐、字体与配置文件
+    Image,  // 解码后的ARGB8888像素
+    Sound   // 按混音器输出格式解码后的PCM
+};
+
+/**
+ * @brief 资源包文件头
+ */
+struct PackHeader
+{
+    char magic[4];              // 文件标识"TDPK"
+    uint32_t version;           // 格式版本
+    uint32_t num_entry;         // 条目数
+    uint32_t audio_frequency;   // PCM采样率
+    uint32_t audio_format;      // PCM采样格式
+    uint32_t audio_channels;    // PCM声道数
+};
+
+/**
+ * @brief 资源包条目，紧随文件头连续存放
+ */
+struct PackEntry
+{
+    char path[64];              // 对应的松散文件路径，以'\0'结尾
+    PackEntryType type;         // 条目类型
+    uint32_t width;             // 图像宽度
+    uint32_t height;            // 图像高度
+    uint32_t pitch;             // 图像每行字节数
+    uint64_t offset;            // 数据在包中的偏移
+    uint64_t size;              // 数据大小
+};
+
+static_assert(sizeof(PackHeader) == 24, "unexpected PackHeader layout");
+static_assert(sizeof(PackEntry) == 96, "unexpected PackEntry layout");
+
+/**
+ * @brief 只读资源包
+ *
+ * 资源包由资源烘焙工具生成，以内存映射方式打开，
+ * 按松散文件的路径查找条目，条目数据直接引用映射的内存，不做拷贝与解析
+ */
+class ResourcePack
+{
+public:
+    static constexpr char MAGIC[4] = { 'T', 'D', 'P', 'K' };    // 文件标识
+    static constexpr uint32_t VERSION = 1;                      // 格式版本
+    static constexpr size_t ALIGNMENT = 16;                     // 条目数据的对齐字节数
+
+public:
+    ResourcePack() = default;
+    ~ResourcePack() = default;
+
+    ResourcePack(const ResourcePack&) = delete;
+    ResourcePack& operator=(const ResourcePack&) = delete;
+
+    /**
+     * @brief 打开并校验资源包
+     * @param path 资源包路径
+     * @return 文件存在且格式与版本匹配返回true，否则返回false
+     */
+    bool open(const std::string& path)
+    {
+        close();
+
+        if (!file.open(path) || file.size() < sizeof(PackHeader))
+            return false;
+
+        const PackHeader* header = (const PackHeader*)file.data();
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION
+            || file.size() < sizeof(PackHeader) + (uint64_t)header->num_entry * sizeof(PackEntry)) {
+            close();
+            return false;
+        }
+
+        const PackEntry* entry_list = (const PackEntry*)(file.data() + sizeof(PackHeader));
+        for (uint32_t i = 0; i < header->num_entry; i++) {
+            const PackEntry& entry = entry_list[i];
+            if (entry.offset > file.size() || entry.size > file.size() - entry.offset
+                || entry.path[sizeof(entry.path) - 1] != '\0' || !checkImageLayout(entry)) {
+                close();
+                return false;
+            }
+            entry_map[entry.path] = &entry;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief 关闭资源包，之前取得的数据指针随之失效
+     */
+    void close()
+    {
+        entry_map.clear();
+        file.close();
+    }
+
+    /**
+     * @brief 按松散文件路径查找条目
+     * @param path 松散文件路径，如"res/image/tileset.png"
+     * @return 条目，不存在时返回nullptr
+     */
+    const PackEntry* find(const std::string& path) const
+    {
+        auto itor = entry_map.find(path);
+        return itor == entry_map.end() ? nullptr : itor->second;
+    }
+
+    const uint8_t* getData(const PackEntry& entry) const { return file.data() + entry.offset; }  // 条目数据
+    const PackHeader& getHeader() const { return *(const PackHeader*)file.data(); }             // 文件头，需先打开
+    bool isOpen() const { return file.isOpen(); }                                               // 是否已打开
+    size_t getEntryCount() const { return entry_map.size(); }                                   // 条目数
+
+private:
+    /**
+     * @brief 校验图像条目的像素布局
+     * @return 非图像条目，或每行字节数足够容纳一行ARGB8888像素且所有行都在条目数据内时返回true
+     */
+    static bool checkImageLayout(const PackEntry& entry)
+    {
+        if (entry.type != PackEntryType::Image)
+            return true;
+
+        return (uint64_t)entry.pitch >= (uint64_t)entry.width * 4
+            && (uint64_t)entry.pitch * entry.height <= entry.size;
+    }
+
+private:
+    MappedFile file;                                            // 映射的资源包文件
+    std::unordered_map<std::string, const PackEntry*> entry_map; // 路径到条目的索引
+};
+
+/**
+ * @brief 资源包写入器，供资源烘焙工具使用
+ */
+class ResourcePackWriter
+{
+public:
+    /**
+     * @brief 添加条目
+     * @param path 对应的松散文件路径，长度不超过63字节
+     * @param type 条目类型
+     * @param data 条目数据
+     * @param size 数据大小
+     * @param width 图像宽度
+     * @param height 图像高度
+     * @param pitch 图像每行字节数
+     * @return 路径过长返回false
+     */
+    bool add(const std::string& path, PackEntryType type, const void* data, size_t size,
+        uint32_t width = 0, uint32_t height = 0, uint32_t pitch = 0)
+    {
+        PackEntry entry = {};
+        if (path.size() >= sizeof(entry.path))
+            return false;
+
+        std::memcpy(entry.path, path.c_str(), path.size());
+        entry.type = type;
+        entry.width = width;
+        entry.height = height;
+        entry.pitch = pitch;
+        entry.size = size;
+
+        entry_list.push_back(entry);
+        data_list.emplace_back((const uint8_t*)data, (const uint8_t*)data + size);
+        return true;
+    }
+
+    /**
+     * @brief 写出资源包
+     * @param path 输出路径
+     * @param audio_frequency PCM采样率
+     * @param audio_format PCM采样格式
+     * @param audio_channels PCM声道数
+     * @return 写入成功返回true
+     */
+    bool write(const std::string& path, uint32_t audio_frequency, uint32_t audio_format, uint32_t audio_channels)
+    {
+        PackHeader header = {};
+        std::memcpy(header.magic, ResourcePack::MAGIC, sizeof(header.magic));
+        header.version = ResourcePack::VERSION;
+        header.num_entry = (uint32_t)entry_list.size();
+        header.audio_frequency = audio_frequency;
+        header.audio_format = audio_format;
+        header.audio_channels = audio_channels;
+
+        uint64_t offset = alignUp(sizeof(PackHeader) + entry_list.size() * sizeof(PackEntry));
+        for (PackEntry& entry : entry_list) {
+            entry.offset = offset;
+            offset = alignUp(offset + entry.size);
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)entry_list.data(), entry_list.size() * sizeof(PackEntry));
+        for (size_t i = 0; i < entry_list.size(); i++) {
+            padTo(file, entry_list[i].offset);
+            file.write((const char*)data_list[i].data(), data_list[i].size());
+        }
+
+        return file.good();
+    }
+
+private:
+    std::vector<PackEntry> entry_list;              // 条目
+    std::vector<std::vector<uint8_t>> data_list;    // 各条目的数据
+
+private:
+    static uint64_t alignUp(uint64_t offset)
+    {
+        return (offset + ResourcePack::ALIGNMENT - 1) / ResourcePack::ALIGNMENT * ResourcePack::ALIGNMENT;
+    }
+
+    static void padTo(std::ofstream& file, uint64_t offset)
+    {
+        static const char zero_list[ResourcePack::ALIGNMENT] = {};
+        const uint64_t position = (uint64_t)file.tellp();
+        if (offset > position)
+            file.write(zero_list, (std::streamsize)(offset - position));
+    }
+};
@@ -0,0 +1,250 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief 槽位句柄，32位稳定引用
+ *
+ * 低20位为槽位索引，高12位为代数(generation)。
+ * 元素被移除后槽位代数递增，旧句柄随即失效，可据此检测悬空引用。
+ */
+struct SlotHandle
+{
+    static constexpr uint32_t INDEX_BITS = 20;                                  // 索引位数
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;              // 索引掩码
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;  // 代数掩码
+    static constexpr uint32_t NULL_VALUE = 0xFFFFFFFF;                          // 空句柄值
+
+    uint32_t value = NULL_VALUE;                                                // 句柄原始值
+
+    SlotHandle() = default;
+    explicit SlotHandle(uint32_t value) : value(value) {}
+    SlotHandle(uint32_t index, uint32_t generation)
+        : value(((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+    uint32_t index() const { return value & INDEX_MASK; }                       // 槽位索引
+    uint32_t generation() const { return value >> INDEX_BITS; }                 // 槽位代数
+    bool isNull() const { return value == NULL_VALUE; }                         // 是否为空句柄
+
+    bool operator==(const SlotHandle& other) const { return value == other.value; }
+    bool operator!=(const SlotHandle& other) const { return value != other.value; }
+};
+
+/**
+ * @brief 代数槽位表(Generational Slot Map)
+ * @tparam T 元素类型
+ *
+ * 元素紧密存放在连续数组中便于遍历，外部通过稳定的SlotHandle访问：
+ * - 插入/删除均为O(1)，删除时将末尾元素换入空位(swap-and-pop)
+ * - 句柄在元素被删除后失效，get()返回nullptr
+ * - 遍历顺序不稳定，删除会改变元素在数组中的位置
+ */
+template <typename T>
+class SlotMap
+{
+public:
+    using Handle = SlotHandle;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+public:
+    SlotMap() = default;
+    ~SlotMap() = default;
+
+    /**
+     * @brief 预留容量，避免运行期扩容
+     * @param capacity 预留的元素数量
+     */
+    void reserve(size_t capacity)
+    {
+        m_dense.reserve(capacity);
+        m_dense_to_slot.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    /**
+     * @brief 插入元素
+     * @param value 元素值
+     * @return 指向新元素的句柄，槽位耗尽时返回空句柄
+     */
+    Handle insert(const T& value)
+    {
+        return emplace(value);
+    }
+
+    Handle insert(T&& value)
+    {
+        return emplace(std::move(value));
+    }
+
+    /**
+     * @brief 原地构造元素
+     * @return 指向新元素的句柄，槽位耗尽时返回空句柄
+     */
+    template <typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        uint32_t index_slot = 0;
+        if (m_free_head != NULL_INDEX) {
+            index_slot = m_free_head;
+            m_free_head = m_slots[index_slot].dense_index;
+        }
+        else {
+            if (m_slots.size() >= MAX_SLOTS)
+                return Handle();
+
+            index_slot = (uint32_t)m_slots.size();
+            m_slots.push_back({ 0, 0 });
+        }
+
+        Slot& slot = m_slots[index_slot];
+        slot.dense_index = (uint32_t)m_dense.size();
+
+        m_dense.emplace_back(std::forward<Args>(args)...);
+        m_dense_to_slot.push_back(index_slot);
+
+        return Handle(index_slot, slot.generation);
+    }
+
+    /**
+     * @brief 通过句柄删除元素
+     * @param handle 元素句柄
+     * @return 句柄有效并成功删除返回true
+     */
+    bool erase(Handle handle)
+    {
+        if (!contains(handle))
+            return false;
+
+        eraseAt(m_slots[handle.index()].dense_index);
+        return true;
+    }
+
+    /**
+     * @brief 删除紧密数组中指定位置的元素
+     * @param dense_index 紧密数组下标
+     *
+     * 末尾元素会被移动到该位置，遍历删除时不要递增下标
+     */
+    void eraseAt(size_t dense_index)
+    {
+        const uint32_t index_slot = m_dense_to_slot[dense_index];
+        const size_t index_last = m_dense.size() - 1;
+
+        if (dense_index != index_last) {
+            m_dense[dense_index] = std::move(m_dense[index_last]);
+            m_dense_to_slot[dense_index] = m_dense_to_slot[index_last];
+            m_slots[m_dense_to_slot[dense_index]].dense_index = (uint32_t)dense_index;
+        }
+
+        m_dense.pop_back();
+        m_dense_to_slot.pop_back();
+
+        Slot& slot = m_slots[index_slot];
+        slot.generation = (slot.generation + 1) & SlotHandle::GENERATION_MASK;
+        slot.dense_index = m_free_head;
+        m_free_head = index_slot;
+    }
+
+    /**
+     * @brief 删除所有满足条件的元素
+     * @param pred 判定函数，可在其中释放元素持有的资源
+     * @return 删除的元素数量
+     */
+    template <typename Pred>
+    size_t eraseIf(Pred pred)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < m_dense.size();) {
+            if (pred(m_dense[i])) {
+                eraseAt(i);
+                count++;
+            }
+            else {
+                i++;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief 检查句柄是否仍然有效
+     * @param handle 元素句柄
+     */
+    bool contains(Handle handle) const
+    {
+        if (handle.isNull() || handle.index() >= m_slots.size())
+            return false;
+
+        const Slot& slot = m_slots[handle.index()];
+        return slot.generation == handle.generation()
+            && slot.dense_index < m_dense_to_slot.size()
+            && m_dense_to_slot[slot.dense_index] == handle.index();
+    }
+
+    /**
+     * @brief 通过句柄获取元素
+     * @param handle 元素句柄
+     * @return 元素指针，句柄失效时返回nullptr
+     */
+    T* get(Handle handle)
+    {
+        return contains(handle) ? &m_dense[m_slots[handle.index()].dense_index] : nullptr;
+    }
+
+    const T* get(Handle handle) const
+    {
+        return contains(handle) ? &m_dense[m_slots[handle.index()].dense_index] : nullptr;
+    }
+
+    /**
+     * @brief 获取紧密数组中指定位置元素的句柄
+     * @param dense_index 紧密数组下标
+     */
+    Handle handleAt(size_t dense_index) const
+    {
+        const uint32_t index_slot = m_dense_to_slot[dense_index];
+        return Handle(index_slot, m_slots[index_slot].generation);
+    }
+
+    /**
+     * @brief 清空所有元素，已发出的句柄全部失效
+     */
+    void clear()
+    {
+        while (!m_dense.empty())
+            eraseAt(m_dense.size() - 1);
+    }
+
+    size_t size() const { return m_dense.size(); }
+    bool empty() const { return m_dense.empty(); }
+
+    T& operator[](size_t dense_index) { return m_dense[dense_index]; }
+    const T& operator[](size_t dense_index) const { return m_dense[dense_index]; }
+
+    iterator begin() { return m_dense.begin(); }
+    iterator end() { return m_dense.end(); }
+    const_iterator begin() const { return m_dense.begin(); }
+    const_iterator end() const { return m_dense.end(); }
+
+private:
+    /**
+     * @brief 稀疏槽位，空闲时dense_index复用为空闲链表的下一项
+     */
+    struct Slot
+    {
+        uint32_t dense_index;   // 元素在紧密数组中的下标
+        uint32_t generation;    // 槽位代数
+    };
+
+    static constexpr uint32_t NULL_INDEX = 0xFFFFFFFF;                // 空闲链表结束标记
+    static constexpr size_t MAX_SLOTS = SlotHandle::INDEX_MASK;       // 最大槽位数(保留全1索引给空句柄)
+
+    std::vector<T> m_dense;                   // 紧密存放的元素
+    std::vector<uint32_t> m_dense_to_slot;    // 紧密下标到槽位的反向映射
+    std::vector<Slot> m_slots;                // 稀疏槽位
+    uint32_t m_free_head = NULL_INDEX;        // 空闲槽位链表头
+};
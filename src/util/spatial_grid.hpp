@@ -0,0 +1,129 @@
+﻿#pragma once
+
+#include "vector2.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 均匀网格空间划分，用于碰撞检测的粗筛(broad-phase)
+ *
+ * 每帧按"reset → insert → build"重建：对象按中心点落入唯一的格子，
+ * build()以计数排序把各格子的对象整理到一段连续数组中，不产生逐格子的堆分配。
+ * 查询时遍历与矩形相交的格子，每个对象至多被回调一次
+ */
+class SpatialGrid
+{
+public:
+    SpatialGrid() = default;
+    ~SpatialGrid() = default;
+
+    /**
+     * @brief 清空网格并重新设置覆盖范围
+     * @param rect 网格覆盖的区域，范围外的对象归入最近的边缘格子
+     * @param cell_size 格子边长(像素)
+     */
+    void reset(const SDL_Rect& rect, int cell_size)
+    {
+        origin_x = rect.x, origin_y = rect.y;
+        this->cell_size = cell_size > 0 ? cell_size : 1;
+        num_cols = std::max(1, (rect.w + this->cell_size - 1) / this->cell_size);
+        num_rows = std::max(1, (rect.h + this->cell_size - 1) / this->cell_size);
+
+        entry_list.clear();
+        cell_start_list.assign((size_t)num_cols * num_rows + 1, 0);
+    }
+
+    /**
+     * @brief 插入对象
+     * @param id 对象编号，查询时原样返回
+     * @param position 对象中心点
+     */
+    void insert(uint32_t id, const Vector2& position)
+    {
+        entry_list.push_back({ cellIndex(cellX(position.x), cellY(position.y)), id });
+    }
+
+    /**
+     * @brief 整理插入的对象，之后才能查询
+     */
+    void build()
+    {
+        std::fill(cell_start_list.begin(), cell_start_list.end(), 0);
+        for (const Entry& entry : entry_list)
+            cell_start_list[entry.cell + 1]++;
+
+        for (size_t i = 1; i < cell_start_list.size(); i++)
+            cell_start_list[i] += cell_start_list[i - 1];
+
+        id_list.resize(entry_list.size());
+        cursor_list.assign(cell_start_list.begin(), cell_start_list.end() - 1);
+        for (const Entry& entry : entry_list)
+            id_list[cursor_list[entry.cell]++] = entry.id;
+    }
+
+    /**
+     * @brief 查询中心点可能落在矩形内的所有对象
+     * @param min_x 矩形左边界
+     * @param min_y 矩形上边界
+     * @param max_x 矩形右边界
+     * @param max_y 矩形下边界
+     * @param callback 对每个候选对象编号调用一次
+     */
+    template <typename Callback>
+    void query(double min_x, double min_y, double max_x, double max_y, Callback callback) const
+    {
+        const int x_begin = cellX(min_x), x_end = cellX(max_x);
+        const int y_begin = cellY(min_y), y_end = cellY(max_y);
+
+        for (int y = y_begin; y <= y_end; y++) {
+            for (int x = x_begin; x <= x_end; x++) {
+                const uint32_t cell = cellIndex(x, y);
+                for (uint32_t i = cell_start_list[cell]; i < cell_start_list[cell + 1]; i++)
+                    callback(id_list[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief 遍历所有非空格子
+     * @param callback 对每个非空格子调用一次，参数为该格子的对象编号数组与对象数
+     */
+    template <typename Callback>
+    void forEachCell(Callback callback) const
+    {
+        for (size_t cell = 0; cell + 1 < cell_start_list.size(); cell++) {
+            const uint32_t begin = cell_start_list[cell], end = cell_start_list[cell + 1];
+            if (begin < end)
+                callback(id_list.data() + begin, end - begin);
+        }
+    }
+
+private:
+    /**
+     * @brief 待整理的对象记录
+     */
+    struct Entry
+    {
+        uint32_t cell;  // 所在格子
+        uint32_t id;    // 对象编号
+    };
+
+    int origin_x = 0;                       // 网格左上角x坐标
+    int origin_y = 0;                       // 网格左上角y坐标
+    int cell_size = 1;                      // 格子边长
+    int num_cols = 1;                       // 列数
+    int num_rows = 1;                       // 行数
+
+    std::vector<Entry> entry_list;          // 插入的对象
+    std::vector<uint32_t> cell_start_list;  // 各格子在id_list中的起始下标(末尾多一项作为结束)
+    std::vector<uint32_t> cursor_list;      // build()时各格子的写入位置
+    std::vector<uint32_t> id_list;          // 按格子排列的对象编号
+
+private:
+    int cellX(double x) const { return std::clamp((int)std::floor((x - origin_x) / cell_size), 0, num_cols - 1); }
+    int cellY(double y) const { return std::clamp((int)std::floor((y - origin_y) / cell_size), 0, num_rows - 1); }
+    uint32_t cellIndex(int x, int y) const { return (uint32_t)(y * num_cols + x); }
+};
\ No newline at end of file
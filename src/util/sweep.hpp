@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include "vector2.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief 连续碰撞检测：运动的点与轴对齐包围盒(AABB)的扫掠测试
+ *
+ * 点在一个时间步内从start匀速移动到start + delta，包围盒中心位于原点，
+ * 包围盒的运动可预先合并到delta中(使用相对位移)。
+ * 使用分离轴(slab)方法求点进入包围盒的最早时刻
+ *
+ * @param start 点的起始位置(相对包围盒中心)
+ * @param delta 点在该时间步内的相对位移
+ * @param half_size 包围盒的半边长
+ * @param time_hit 输出参数，最早接触时刻，取值[0, 1]，起点已在盒内时为0
+ * @return 该时间步内接触返回true，否则返回false
+ */
+inline bool sweepPointAABB(const Vector2& start, const Vector2& delta, const Vector2& half_size, double& time_hit)
+{
+    double time_enter = 0.0, time_exit = 1.0;
+
+    const double start_axis[2] = { start.x, start.y };
+    const double delta_axis[2] = { delta.x, delta.y };
+    const double half_axis[2] = { half_size.x, half_size.y };
+
+    for (int i = 0; i < 2; i++) {
+        if (delta_axis[i] == 0) {
+            // 该轴上静止，必须始终位于盒内(含边界)
+            if (start_axis[i] < -half_axis[i] || start_axis[i] > half_axis[i])
+                return false;
+            continue;
+        }
+
+        double t_near = (-half_axis[i] - start_axis[i]) / delta_axis[i];
+        double t_far = (half_axis[i] - start_axis[i]) / delta_axis[i];
+        if (t_near > t_far)
+            std::swap(t_near, t_far);
+
+        time_enter = std::max(time_enter, t_near);
+        time_exit = std::min(time_exit, t_far);
+        if (time_enter > time_exit)
+            return false;
+    }
+
+    time_hit = time_enter;
+    return true;
+}
\ No newline at end of file
@@ -5,7 +5,8 @@
 /**
  * @brief 计时器类，用于处理定时触发事件
  *
- * 支持单次/循环触发模式，可设置回调函数，支持暂停/恢复功能
+ * 支持单次/循环触发模式，可设置回调函数，支持暂停/恢复功能。
+ * 单次更新的时间跨越多个等待周期时会补触发，结果与按小步长逐次更新一致
  */
 class Timer
 {
@@ -16,11 +17,22 @@ public:
     /**
      * @brief 重置计时器状态
      *
-     * 将已过时间清零，重置触发状态
+     * 将已过时间清零，重置触发状态。
+     * 在超时回调中调用时保留超出触发时刻的时间，使链式计时不受更新步长影响
      */
     void restart()
     {
-        pass_time = 0;
+        pass_time = is_timing_out ? time_overflow : 0;
+        shotted = false;
+    }
+
+    /**
+     * @brief 重置计时器状态，并视为重新计时后已经过指定时间
+     * @param pass_time 已经过的时间（秒），用于从更新步长中途的某一时刻开始计时
+     */
+    void restart(double pass_time)
+    {
+        this->pass_time = pass_time;
         shotted = false;
     }
 
@@ -33,6 +45,15 @@ public:
         this->wait_time = wait_time;
     }
 
+    /**
+     * @brief 获取本次触发时超出等待时间的部分
+     * @return 触发时刻之后已经过的时间（秒），仅在超时回调中有意义
+     */
+    double getOverflow() const
+    {
+        return time_overflow;
+    }
+
     /**
      * @brief 设置是否为单次触发模式
      * @param one_shot true表示单次触发，false表示循环触发
@@ -75,21 +96,31 @@ public:
      * @brief 更新计时器状态
      * @param delta_time 距离上次更新的时间间隔（秒）
      *
-     * 累加经过的时间，当达到等待时间时触发回调函数
-     * 在单次触发模式下，回调函数只会被触发一次
+     * 累加经过的时间，每达到一次等待时间触发一次回调函数，
+     * 时间间隔较大时会在本次更新内连续补触发。
+     * 在单次触发模式下，回调函数只会被触发一次(回调中重新启动的除外)；
+     * 等待时间不大于0时每次更新至多触发一次
      */
     void onUpdate(double delta_time)
     {
         if (paused)	return;
 
         pass_time += delta_time;
-        if (pass_time >= wait_time) {
+        while (!paused && pass_time >= wait_time) {
             bool can_shot = (!one_shot || (one_shot && !shotted));
             shotted = true;
+
+            // 先扣除本次等待时间再回调，回调中重新启动时保留的超出部分不会被再次扣除
+            pass_time -= wait_time;
+
+            is_timing_out = true;
+            time_overflow = pass_time;
             if (can_shot && onTimeOut)
                 onTimeOut();
+            is_timing_out = false;
 
-            pass_time -= wait_time;
+            if (wait_time <= 0 || (one_shot && shotted))
+                break;
         }
     }
 
@@ -99,5 +130,7 @@ private:
     bool paused = false;              // 是否暂停
     bool shotted = false;             // 是否已经触发
     bool one_shot = false;            // 是否为单次触发模式
+    bool is_timing_out = false;       // 是否正在执行超时回调
+    double time_overflow = 0.0;       // 本次触发时超出等待时间的部分
     std::function<void()> onTimeOut;  // 超时回调函数
 };
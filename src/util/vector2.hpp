@@ -155,4 +155,16 @@ public:
     {
         return length() < 0.00001;
     }
+
+    /**
+     * @brief 在两个向量之间线性插值
+     * @param from 起点
+     * @param to 终点
+     * @param alpha 插值系数，0为起点，1为终点
+     * @return 插值结果
+     */
+    static Vector2 lerp(const Vector2& from, const Vector2& to, double alpha)
+    {
+        return Vector2(from.x + (to.x - from.x) * alpha, from.y + (to.y - from.y) * alpha);
+    }
 };
@@ -0,0 +1,494 @@
+﻿#pragma once
+
+#include "mapped_file.hpp"
+
+#include <cJSON.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 波次时间线文件头
+ *
+ * 文件布局：文件头、敌人类型名表，之后按波次顺序存放，
+ * 每个波次为一条波次记录，紧跟该波次的全部生成记录
+ */
+struct WaveTimelineHeader
+{
+    char magic[4];              // 文件标识"TDWV"
+    uint32_t version;           // 格式版本
+    uint32_t num_wave;          // 波次数
+    uint32_t num_event;         // 全部波次的生成事件总数
+    uint32_t num_type;          // 敌人类型名表的条目数
+    uint32_t reserved;          // 保留，为0
+};
+
+/**
+ * @brief 敌人类型名表条目，生成记录按下标引用，打开时再按名称映射到当前配置
+ */
+struct WaveTimelineType
+{
+    char name[32];              // 敌人原型名称，以'\0'结尾
+};
+
+/**
+ * @brief 波次记录
+ */
+struct WaveRecord
+{
+    float rewards;              // 完成该波次可获得的奖励
+    float interval;             // 波次开始前的等待时间(秒)
+    uint32_t num_event;         // 紧随其后的生成记录数
+};
+
+/**
+ * @brief 生成记录，同一波次内按时间排列
+ */
+struct SpawnRecord
+{
+    float time;                 // 相对波次开始时刻的生成时间(秒)
+    uint16_t spawn_point;       // 生成点编号
+    uint16_t type;              // 在敌人类型名表中的下标
+};
+
+static_assert(sizeof(WaveTimelineHeader) == 24, "unexpected WaveTimelineHeader layout");
+static_assert(sizeof(WaveTimelineType) == 32, "unexpected WaveTimelineType layout");
+static_assert(sizeof(WaveRecord) == 12, "unexpected WaveRecord layout");
+static_assert(sizeof(SpawnRecord) == 8, "unexpected SpawnRecord layout");
+
+/**
+ * @brief 编译后的波次时间线
+ *
+ * 数据可以引用资源包中的条目、映射磁盘上的文件或持有编译出的缓冲区，
+ * 都不做展开：生成记录由WaveTimelineReader按需读取，
+ * 因此关卡再长，运行时驻留的也只有读取窗口
+ */
+class WaveTimeline
+{
+public:
+    static constexpr char MAGIC[4] = { 'T', 'D', 'W', 'V' };    // 文件标识
+    static constexpr uint32_t VERSION = 1;                      // 格式版本
+
+public:
+    WaveTimeline() = default;
+    ~WaveTimeline() = default;
+
+    WaveTimeline(const WaveTimeline&) = delete;
+    WaveTimeline& operator=(const WaveTimeline&) = delete;
+
+    /**
+     * @brief 引用外部数据，如资源包中的条目
+     * @param data 时间线数据，需在关闭前保持有效
+     * @param size 数据大小
+     * @return 数据格式有效返回true
+     */
+    bool open(const uint8_t* data, size_t size)
+    {
+        close();
+        return attach(data, size);
+    }
+
+    /**
+     * @brief 映射磁盘上编译好的时间线文件
+     */
+    bool openFile(const std::string& path)
+    {
+        close();
+
+        auto file_opened = std::make_unique<MappedFile>();
+        if (!file_opened->open(path) || !attach(file_opened->data(), file_opened->size()))
+            return false;
+
+        file = std::move(file_opened);
+        return true;
+    }
+
+    /**
+     * @brief 接管编译出的缓冲区
+     */
+    bool openBuffer(std::vector<uint8_t>&& data)
+    {
+        close();
+        if (!attach(data.data(), data.size()))
+            return false;
+
+        buffer = std::move(data);
+        return true;
+    }
+
+    void close()
+    {
+        file.reset();
+        buffer.clear();
+        buffer.shrink_to_fit();
+        type_map.clear();
+        data_timeline = nullptr;
+        size_timeline = 0;
+    }
+
+    /**
+     * @brief 与另一条时间线交换全部内容
+     * @details 缓冲区与映射交换后地址不变，已打开的数据仍然有效
+     */
+    void swap(WaveTimeline& other)
+    {
+        std::swap(file, other.file);
+        buffer.swap(other.buffer);
+        type_map.swap(other.type_map);
+        std::swap(data_timeline, other.data_timeline);
+        std::swap(size_timeline, other.size_timeline);
+    }
+
+    /**
+     * @brief 设置类型名表下标到调用者类型编号的映射
+     * @param map 长度需等于类型名表的条目数
+     */
+    void setTypeMap(std::vector<size_t>&& map) { type_map = std::move(map); }
+
+    /**
+     * @brief 把生成记录中的类型下标映射为调用者的类型编号
+     * @return 下标越界或未设置映射时返回SIZE_MAX
+     */
+    size_t getType(uint16_t index) const { return index < type_map.size() ? type_map[index] : SIZE_MAX; }
+
+    bool isOpen() const { return data_timeline != nullptr; }                                   // 是否已打开
+    const WaveTimelineHeader& getHeader() const { return *(const WaveTimelineHeader*)data_timeline; }  // 文件头，需先打开
+    uint32_t getWaveCount() const { return getHeader().num_wave; }                            // 波次数
+    uint32_t getEventCount() const { return getHeader().num_event; }                          // 生成事件总数
+    uint32_t getTypeCount() const { return getHeader().num_type; }                            // 类型名表条目数
+    const char* getTypeName(uint32_t index) const { return getTypeList()[index].name; }       // 类型名称
+    const uint8_t* data() const { return data_timeline; }                                      // 时间线数据
+    size_t size() const { return size_timeline; }                                              // 数据大小
+    size_t getFirstWaveOffset() const { return sizeof(WaveTimelineHeader) + getTypeCount() * sizeof(WaveTimelineType); }  // 第一条波次记录的偏移
+
+private:
+    std::unique_ptr<MappedFile> file;       // 映射的时间线文件
+    std::vector<uint8_t> buffer;            // 持有的编译结果
+    std::vector<size_t> type_map;           // 类型名表下标到调用者类型编号的映射
+    const uint8_t* data_timeline = nullptr; // 时间线数据
+    size_t size_timeline = 0;               // 数据大小
+
+private:
+    const WaveTimelineType* getTypeList() const { return (const WaveTimelineType*)(data_timeline + sizeof(WaveTimelineHeader)); }
+
+    /**
+     * @brief 校验文件头与总大小，只读取文件头与类型名表
+     */
+    bool attach(const uint8_t* data, size_t size)
+    {
+        if (!data || size < sizeof(WaveTimelineHeader))
+            return false;
+
+        const WaveTimelineHeader* header = (const WaveTimelineHeader*)data;
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION || header->num_wave == 0)
+            return false;
+
+        const uint64_t size_expected = sizeof(WaveTimelineHeader) + (uint64_t)header->num_type * sizeof(WaveTimelineType)
+            + (uint64_t)header->num_wave * sizeof(WaveRecord) + (uint64_t)header->num_event * sizeof(SpawnRecord);
+        if (size != size_expected)
+            return false;
+
+        const WaveTimelineType* type_list = (const WaveTimelineType*)(data + sizeof(WaveTimelineHeader));
+        for (uint32_t i = 0; i < header->num_type; i++) {
+            if (type_list[i].name[sizeof(type_list[i].name) - 1] != '\0')
+                return false;
+        }
+
+        data_timeline = data;
+        size_timeline = size;
+        return true;
+    }
+};
+
+/**
+ * @brief 波次时间线的流式读取器
+ *
+ * 保存当前波次记录与一个小的前瞻窗口，窗口读空时从时间线中顺序补充下一段生成记录，
+ * 不随关卡长度分配内存。时间线被替换后需重新open()并seek()到原来的进度
+ */
+class WaveTimelineReader
+{
+public:
+    static constexpr uint32_t WINDOW_SIZE = 64;     // 前瞻窗口的生成记录数
+
+public:
+    /**
+     * @brief 绑定时间线并定位到第一波的开头
+     */
+    bool open(const WaveTimeline& timeline_opened)
+    {
+        timeline = &timeline_opened;
+        return seek(0, 0);
+    }
+
+    /**
+     * @brief 定位到指定波次的指定生成事件
+     * @param index_wave_target 波次索引
+     * @param index_event_target 波次内的事件索引，超出该波次的事件数时定位到波次末尾
+     * @return 波次索引超出时间线返回false，进度保持不变
+     * @details 只沿途读取各波次记录，不读取生成记录
+     */
+    bool seek(uint32_t index_wave_target, uint32_t index_event_target)
+    {
+        if (!timeline || !timeline->isOpen() || index_wave_target >= timeline->getWaveCount())
+            return false;
+
+        size_t offset = timeline->getFirstWaveOffset();
+        WaveRecord record;
+        for (uint32_t i = 0; ; i++) {
+            if (!readWave(offset, record))
+                return false;
+            if (i == index_wave_target)
+                break;
+            offset += sizeof(WaveRecord) + (size_t)record.num_event * sizeof(SpawnRecord);
+        }
+
+        index_wave = index_wave_target;
+        offset_wave = offset;
+        wave = record;
+        index_event = std::min(index_event_target, wave.num_event);
+        offset_next = offset_wave + sizeof(WaveRecord) + (size_t)index_event * sizeof(SpawnRecord);
+        index_window = num_window = 0;
+
+        time_last = 0;
+        if (index_event > 0) {
+            SpawnRecord event_last;
+            std::memcpy(&event_last, timeline->data() + offset_next - sizeof(SpawnRecord), sizeof(SpawnRecord));
+            time_last = event_last.time;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief 跳过当前波次剩余的生成事件，前进到下一波的开头
+     * @return 已是最后一波时返回false，进度保持不变
+     */
+    bool nextWave()
+    {
+        if (!timeline || index_wave + 1 >= timeline->getWaveCount())
+            return false;
+
+        const size_t offset = offset_wave + sizeof(WaveRecord) + (size_t)wave.num_event * sizeof(SpawnRecord);
+        WaveRecord record;
+        if (!readWave(offset, record))
+            return false;
+
+        index_wave++;
+        offset_wave = offset;
+        wave = record;
+        index_event = 0;
+        offset_next = offset_wave + sizeof(WaveRecord);
+        index_window = num_window = 0;
+        time_last = 0;
+        return true;
+    }
+
+    /**
+     * @brief 查看当前波次的下一个生成事件
+     * @return 本波次的事件已全部读出时返回nullptr
+     */
+    const SpawnRecord* peek()
+    {
+        if (index_window == num_window && !fillWindow())
+            return nullptr;
+
+        return &window[index_window];
+    }
+
+    /**
+     * @brief 消耗peek()返回的生成事件
+     */
+    void pop()
+    {
+        time_last = window[index_window].time;
+        index_window++;
+        index_event++;
+    }
+
+    const WaveRecord& getWave() const { return wave; }          // 当前波次记录
+    uint32_t getWaveIndex() const { return index_wave; }        // 当前波次索引
+    uint32_t getEventIndex() const { return index_event; }      // 当前波次已消耗的事件数
+    float getLastEventTime() const { return time_last; }        // 最近消耗的事件的生成时间，波次开头为0
+
+private:
+    const WaveTimeline* timeline = nullptr;     // 读取的时间线
+    uint32_t index_wave = 0;                    // 当前波次索引
+    uint32_t index_event = 0;                   // 当前波次已消耗的事件数
+    size_t offset_wave = 0;                     // 当前波次记录的偏移
+    size_t offset_next = 0;                     // 下一条未读入窗口的生成记录的偏移
+    WaveRecord wave = {};                       // 当前波次记录
+    float time_last = 0;                        // 最近消耗的事件的生成时间
+
+    SpawnRecord window[WINDOW_SIZE] = {};       // 前瞻窗口
+    uint32_t index_window = 0;                  // 窗口中下一个事件的位置
+    uint32_t num_window = 0;                    // 窗口中的事件数
+
+private:
+    /**
+     * @brief 读取波次记录，并把事件数截断到时间线剩余的数据内
+     */
+    bool readWave(size_t offset, WaveRecord& record) const
+    {
+        if (offset + sizeof(WaveRecord) > timeline->size())
+            return false;
+
+        std::memcpy(&record, timeline->data() + offset, sizeof(WaveRecord));
+        const size_t num_remain = (timeline->size() - offset - sizeof(WaveRecord)) / sizeof(SpawnRecord);
+        record.num_event = (uint32_t)std::min<size_t>(record.num_event, num_remain);
+        return true;
+    }
+
+    /**
+     * @brief 从时间线读入当前波次的下一段生成记录
+     * @return 当前波次没有剩余事件时返回false
+     */
+    bool fillWindow()
+    {
+        const uint32_t num_unread = wave.num_event - index_event;
+        if (num_unread == 0)
+            return false;
+
+        num_window = std::min(num_unread, WINDOW_SIZE);
+        index_window = 0;
+        std::memcpy(window, timeline->data() + offset_next, (size_t)num_window * sizeof(SpawnRecord));
+        offset_next += (size_t)num_window * sizeof(SpawnRecord);
+        return true;
+    }
+};
+
+/**
+ * @brief 把JSON格式的关卡配置编译为波次时间线
+ *
+ * 关卡配置为波次数组，每个波次包含rewards、interval与spawn_list，
+ * 生成事件包含interval(与上一个事件的间隔)、spawn_point与enemy_type(原型名称)。
+ * 间隔在编译时累加为相对波次开始的时间；无效的事件与没有有效事件的波次被跳过
+ */
+class WaveTimelineCompiler
+{
+public:
+    /**
+     * @brief 编译关卡配置
+     * @param json 关卡配置的JSON文本
+     * @param output 输出参数，编译出的时间线
+     * @return 没有任何有效波次时返回false
+     */
+    static bool compile(const char* json, std::vector<uint8_t>& output)
+    {
+        std::unique_ptr<cJSON, decltype(&cJSON_Delete)> json_root(cJSON_Parse(json), cJSON_Delete);
+        if (!json_root || json_root->type != cJSON_Array)
+            return false;
+
+        std::vector<WaveTimelineType> type_list;
+        std::unordered_map<std::string, uint16_t> type_index_map;
+        std::vector<uint8_t> body;
+        WaveTimelineHeader header = {};
+
+        cJSON* json_wave = nullptr;
+        cJSON_ArrayForEach(json_wave, json_root.get()) {
+            WaveRecord record = {};
+            const cJSON* json_spawn_list = cJSON_GetObjectItem(json_wave, "spawn_list");
+            if (json_wave->type != cJSON_Object || !getNumber(json_wave, "rewards", record.rewards)
+                || !getNumber(json_wave, "interval", record.interval)
+                || !json_spawn_list || json_spawn_list->type != cJSON_Array)
+                continue;
+
+            const size_t offset_record = body.size();
+            body.resize(body.size() + sizeof(WaveRecord));
+
+            double time = 0;
+            cJSON* json_event = nullptr;
+            cJSON_ArrayForEach(json_event, json_spawn_list) {
+                double interval = 0, spawn_point = 0;
+                const cJSON* json_type = cJSON_GetObjectItem(json_event, "enemy_type");
+                if (json_event->type != cJSON_Object || !getNumber(json_event, "interval", interval)
+                    || !getNumber(json_event, "spawn_point", spawn_point) || spawn_point < 0 || spawn_point > UINT16_MAX
+                    || !json_type || json_type->type != cJSON_String)
+                    continue;
+
+                uint16_t type = 0;
+                if (!findType(json_type->valuestring, type_list, type_index_map, type))
+                    continue;
+
+                time += interval;
+
+                SpawnRecord event;
+                event.time = (float)time;
+                event.spawn_point = (uint16_t)spawn_point;
+                event.type = type;
+                append(body, event);
+                record.num_event++;
+            }
+
+            if (record.num_event == 0) {
+                body.resize(offset_record);
+                continue;
+            }
+
+            std::memcpy(body.data() + offset_record, &record, sizeof(WaveRecord));
+            header.num_wave++;
+            header.num_event += record.num_event;
+        }
+
+        if (header.num_wave == 0)
+            return false;
+
+        std::memcpy(header.magic, WaveTimeline::MAGIC, sizeof(header.magic));
+        header.version = WaveTimeline::VERSION;
+        header.num_type = (uint32_t)type_list.size();
+
+        output.clear();
+        output.reserve(sizeof(header) + type_list.size() * sizeof(WaveTimelineType) + body.size());
+        append(output, header);
+        output.insert(output.end(), (const uint8_t*)type_list.data(), (const uint8_t*)(type_list.data() + type_list.size()));
+        output.insert(output.end(), body.begin(), body.end());
+        return true;
+    }
+
+private:
+    template <typename T>
+    static bool getNumber(const cJSON* json, const char* key, T& value)
+    {
+        const cJSON* item = cJSON_GetObjectItem(json, key);
+        if (!item || item->type != cJSON_Number)
+            return false;
+
+        value = (T)item->valuedouble;
+        return true;
+    }
+
+    template <typename T>
+    static void append(std::vector<uint8_t>& data, const T& value)
+    {
+        data.insert(data.end(), (const uint8_t*)&value, (const uint8_t*)&value + sizeof(T));
+    }
+
+    /**
+     * @brief 查找或登记敌人类型名称
+     * @return 名称过长或类型数超出上限返回false
+     */
+    static bool findType(const char* name, std::vector<WaveTimelineType>& type_list,
+        std::unordered_map<std::string, uint16_t>& type_index_map, uint16_t& type)
+    {
+        auto itor = type_index_map.find(name);
+        if (itor != type_index_map.end()) {
+            type = itor->second;
+            return true;
+        }
+
+        WaveTimelineType entry = {};
+        const size_t length = std::strlen(name);
+        if (length >= sizeof(entry.name) || type_list.size() > UINT16_MAX)
+            return false;
+
+        std::memcpy(entry.name, name, length);
+        type = (uint16_t)type_list.size();
+        type_list.push_back(entry);
+        type_index_map.emplace(name, type);
+        return true;
+    }
+};
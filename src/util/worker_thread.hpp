@@ -0,0 +1,96 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief 单任务工作线程
+ *
+ * post()提交一个任务后立即返回，任务在工作线程中执行；
+ * wait()阻塞到任务完成。post()与wait()之间的内存访问由互斥量同步，
+ * 因此wait()返回后可以安全读取任务写入的数据。
+ * 同一时间只执行一个任务，提交新任务前需要先wait()
+ */
+class WorkerThread
+{
+public:
+    WorkerThread()
+    {
+        thread = std::thread([this]() { loop(); });
+    }
+
+    ~WorkerThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_exit = true;
+        }
+        cv_job.notify_one();
+        thread.join();
+    }
+
+    WorkerThread(const WorkerThread&) = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+
+    /**
+     * @brief 提交任务
+     * @param job 在工作线程中执行的任务
+     */
+    void post(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            this->job = std::move(job);
+            has_job = true;
+        }
+        cv_job.notify_one();
+    }
+
+    /**
+     * @brief 已提交的任务是否已完成，不阻塞
+     * @return 没有未完成的任务返回true
+     */
+    bool isIdle()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !has_job;
+    }
+
+    /**
+     * @brief 等待已提交的任务完成，没有任务时立即返回
+     */
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv_done.wait(lock, [this]() { return !has_job; });
+    }
+
+private:
+    std::thread thread;                     // 工作线程
+    std::mutex mutex;                       // 保护任务状态
+    std::condition_variable cv_job;         // 有新任务或需要退出
+    std::condition_variable cv_done;        // 任务已完成
+    std::function<void()> job;              // 待执行的任务
+    bool has_job = false;                   // 是否有未完成的任务
+    bool is_exit = false;                   // 是否退出线程
+
+private:
+    void loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cv_job.wait(lock, [this]() { return has_job || is_exit; });
+            if (is_exit)
+                return;
+
+            lock.unlock();
+            job();
+            lock.lock();
+
+            has_job = false;
+            cv_done.notify_all();
+        }
+    }
+};